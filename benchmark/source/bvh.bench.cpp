@@ -0,0 +1,139 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <tml/bvh.hpp>
+#include <tml/face.hpp>
+#include <tml/index.hpp>
+#include <vector>
+
+namespace
+{
+    struct sphere
+    {
+        std::vector<float> positions;
+        std::vector<tml::face> faces;
+    };
+
+    // Latitude-longitude sphere with a rippled radius, 2 * segments^2 faces.
+    auto make_sphere(std::size_t const segments) -> sphere
+    {
+        sphere result;
+        std::size_t const rings = segments + 1UL;
+
+        for (std::size_t ring{0UL}; ring < rings; ++ring)
+        {
+            for (std::size_t column{0UL}; column < rings; ++column)
+            {
+                float const theta = std::numbers::pi_v<float> * static_cast<float>(ring) / static_cast<float>(segments);
+                float const phi = 2.0F * std::numbers::pi_v<float> * static_cast<float>(column) / static_cast<float>(segments);
+                float const radius = 1.0F + 0.05F * std::sin(7.0F * theta) * std::cos(5.0F * phi);
+                result.positions.insert(result.positions.end(),
+                                        {radius * std::sin(theta) * std::cos(phi), radius * std::sin(theta) * std::sin(phi),
+                                         radius * std::cos(theta)});
+            }
+        }
+
+        for (std::size_t ring{0UL}; ring < segments; ++ring)
+        {
+            for (std::size_t column{0UL}; column < segments; ++column)
+            {
+                auto const corner = static_cast<tml::index_type>(ring * rings + column);
+                auto const below = static_cast<tml::index_type>(corner + rings);
+                result.faces.emplace_back(corner, below, corner + 1U);
+                result.faces.emplace_back(corner + 1U, below, below + 1U);
+            }
+        }
+
+        return result;
+    }
+
+    // Rays from a shell around the sphere towards points scattered near its center.
+    auto make_rays(std::size_t const count) -> std::vector<tml::ray>
+    {
+        std::vector<tml::ray> rays(count);
+
+        for (std::size_t idx{0UL}; idx < count; ++idx)
+        {
+            auto const t = static_cast<float>(idx);
+            std::array<float, 3> const origin{3.0F * std::cos(t * 0.61F), 3.0F * std::sin(t * 0.61F), 3.0F * std::cos(t * 0.37F)};
+            std::array<float, 3> const target{0.3F * std::sin(t * 1.3F), 0.3F * std::cos(t * 0.7F), 0.3F * std::sin(t * 0.9F)};
+            rays[idx] = tml::ray{.origin = origin,
+                                 .direction = {target[0] - origin[0], target[1] - origin[1], target[2] - origin[2]}};
+        }
+
+        return rays;
+    }
+
+    // Points scattered around the surface of the sphere, closer to it than to its center.
+    auto make_points(std::size_t const count) -> std::vector<std::array<float, 3>>
+    {
+        std::vector<std::array<float, 3>> points(count);
+
+        for (std::size_t idx{0UL}; idx < count; ++idx)
+        {
+            auto const t = static_cast<float>(idx);
+            float const radius = 0.8F + 0.4F * std::sin(t * 0.13F) * std::sin(t * 0.13F);
+            float const theta = std::acos(std::cos(t * 0.29F));
+            float const phi = t * 0.61F;
+            points[idx] = {radius * std::sin(theta) * std::cos(phi), radius * std::sin(theta) * std::sin(phi),
+                           radius * std::cos(theta)};
+        }
+
+        return points;
+    }
+
+    auto bvh_build(benchmark::State& state) -> void
+    {
+        auto const mesh = make_sphere(static_cast<std::size_t>(state.range(0)));
+        auto const threads = static_cast<std::size_t>(state.range(1));
+
+        for (auto _ : state)
+        {
+            tml::bvh const bvh{mesh.positions, mesh.faces, threads};
+            benchmark::DoNotOptimize(bvh.nodes().data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(mesh.faces.size()));
+    }
+
+    auto bvh_intersect(benchmark::State& state) -> void
+    {
+        auto const mesh = make_sphere(static_cast<std::size_t>(state.range(0)));
+        auto const threads = static_cast<std::size_t>(state.range(1));
+        tml::bvh const bvh{mesh.positions, mesh.faces, 0UL};
+        auto const rays = make_rays(1UL << 16U);
+        std::vector<tml::ray_hit> hits(rays.size());
+
+        for (auto _ : state)
+        {
+            bvh.intersect(rays, hits, threads);
+            benchmark::DoNotOptimize(hits.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rays.size()));
+    }
+
+    auto bvh_closest_point(benchmark::State& state) -> void
+    {
+        auto const mesh = make_sphere(static_cast<std::size_t>(state.range(0)));
+        tml::bvh const bvh{mesh.positions, mesh.faces, 0UL};
+        auto const points = make_points(1UL << 16U);
+
+        for (auto _ : state)
+        {
+            for (auto const& point : points)
+            {
+                benchmark::DoNotOptimize(bvh.closest_point(point));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points.size()));
+    }
+} // namespace
+
+BENCHMARK(bvh_build)->ArgsProduct({{128, 512, 1024}, {1, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bvh_intersect)->ArgsProduct({{128, 1024}, {1, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bvh_closest_point)->Arg(128)->Arg(1024)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,296 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <system_error>
+#include <tml/index.hpp>
+#include <unordered_map>
+#include <utility>
+
+#if !defined(__linux__) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    auto push_vertex(bench::geometry& geometry, float const x, float const y, float const z) -> tml::index_type
+    {
+        geometry.positions.insert(geometry.positions.end(), {x, y, z});
+        return static_cast<tml::index_type>(geometry.positions.size() / 3UL - 1UL);
+    }
+
+    // Icosahedron refined until its face count is the closest power-of-four multiple of 20 to the requested one.
+    auto make_icosphere(std::size_t const face_count) -> bench::geometry
+    {
+        float const phi = std::numbers::phi_v<float>;
+        bench::geometry result;
+
+        for (auto const [x, y, z] : std::array<std::array<float, 3>, 12>{{{-1, phi, 0},
+                                                                          {1, phi, 0},
+                                                                          {-1, -phi, 0},
+                                                                          {1, -phi, 0},
+                                                                          {0, -1, phi},
+                                                                          {0, 1, phi},
+                                                                          {0, -1, -phi},
+                                                                          {0, 1, -phi},
+                                                                          {phi, 0, -1},
+                                                                          {phi, 0, 1},
+                                                                          {-phi, 0, -1},
+                                                                          {-phi, 0, 1}}})
+        {
+            float const norm = std::sqrt(x * x + y * y + z * z);
+            static_cast<void>(push_vertex(result, x / norm, y / norm, z / norm));
+        }
+
+        result.faces = {{0, 11, 5}, {0, 5, 1},  {0, 1, 7},   {0, 7, 10}, {0, 10, 11}, {1, 5, 9}, {5, 11, 4},
+                        {11, 10, 2}, {10, 7, 6}, {7, 1, 8},   {3, 9, 4},  {3, 4, 2},   {3, 2, 6}, {3, 6, 8},
+                        {3, 8, 9},  {4, 9, 5},  {2, 4, 11},  {6, 2, 10}, {8, 6, 7},   {9, 8, 1}};
+
+        auto const levels = static_cast<std::size_t>(
+            std::max(0.0, std::round(std::log(static_cast<double>(face_count) / 20.0) / std::log(4.0))));
+
+        for (std::size_t level{0UL}; level < levels; ++level)
+        {
+            std::unordered_map<std::uint64_t, tml::index_type> midpoints;
+            midpoints.reserve(result.faces.size() * 3UL / 2UL);
+            std::vector<tml::face> faces;
+            faces.reserve(result.faces.size() * 4UL);
+
+            auto const midpoint = [&](tml::index_type const a, tml::index_type const b) -> tml::index_type {
+                auto const key = (std::uint64_t{std::min(a, b)} << 32U) | std::max(a, b);
+                auto const [it, inserted] = midpoints.try_emplace(key, tml::index_type{0U});
+
+                if (inserted)
+                {
+                    float const x = result.positions[a * 3UL] + result.positions[b * 3UL];
+                    float const y = result.positions[a * 3UL + 1UL] + result.positions[b * 3UL + 1UL];
+                    float const z = result.positions[a * 3UL + 2UL] + result.positions[b * 3UL + 2UL];
+                    float const norm = std::sqrt(x * x + y * y + z * z);
+                    it->second = push_vertex(result, x / norm, y / norm, z / norm);
+                }
+
+                return it->second;
+            };
+
+            for (auto const& face : result.faces)
+            {
+                auto const [v1, v2, v3] = face.indices();
+                auto const m12 = midpoint(v1, v2);
+                auto const m23 = midpoint(v2, v3);
+                auto const m31 = midpoint(v3, v1);
+                faces.insert(faces.end(), {{v1, m12, m31}, {v2, m23, m12}, {v3, m31, m23}, {m12, m23, m31}});
+            }
+
+            result.faces = std::move(faces);
+        }
+
+        return result;
+    }
+
+    // Square grid of 2 * side^2 faces on a rippled height field.
+    auto make_grid(std::size_t const face_count) -> bench::geometry
+    {
+        auto const side = std::max<std::size_t>(
+            1UL, static_cast<std::size_t>(std::lround(std::sqrt(static_cast<double>(face_count) / 2.0))));
+        auto const columns = side + 1UL;
+        bench::geometry result;
+        result.positions.reserve(columns * columns * 3UL);
+        result.faces.reserve(side * side * 2UL);
+
+        for (std::size_t row{0UL}; row < columns; ++row)
+        {
+            for (std::size_t column{0UL}; column < columns; ++column)
+            {
+                float const x = static_cast<float>(column) / static_cast<float>(side);
+                float const y = static_cast<float>(row) / static_cast<float>(side);
+                static_cast<void>(push_vertex(result, x, y, 0.05F * std::sin(13.0F * x) * std::cos(11.0F * y)));
+            }
+        }
+
+        for (std::size_t row{0UL}; row < side; ++row)
+        {
+            for (std::size_t column{0UL}; column < side; ++column)
+            {
+                auto const corner = static_cast<tml::index_type>(row * columns + column);
+                auto const above = static_cast<tml::index_type>(corner + columns);
+                result.faces.emplace_back(corner, corner + 1U, above);
+                result.faces.emplace_back(corner + 1U, above + 1U, above);
+            }
+        }
+
+        return result;
+    }
+
+    // Disc of face_count faces around a single center vertex, the worst case for per-vertex adjacency.
+    auto make_fan(std::size_t const face_count) -> bench::geometry
+    {
+        auto const rim = std::max<std::size_t>(3UL, face_count);
+        bench::geometry result;
+        result.positions.reserve((rim + 1UL) * 3UL);
+        result.faces.reserve(rim);
+        static_cast<void>(push_vertex(result, 0.0F, 0.0F, 0.0F));
+
+        for (std::size_t idx{0UL}; idx < rim; ++idx)
+        {
+            float const angle = 2.0F * std::numbers::pi_v<float> * static_cast<float>(idx) / static_cast<float>(rim);
+            static_cast<void>(push_vertex(result, std::cos(angle), std::sin(angle), 0.05F * std::sin(17.0F * angle)));
+        }
+
+        for (std::size_t idx{0UL}; idx < rim; ++idx)
+        {
+            result.faces.emplace_back(0U, static_cast<tml::index_type>(idx + 1UL),
+                                      static_cast<tml::index_type>((idx + 1UL) % rim + 1UL));
+        }
+
+        return result;
+    }
+
+    auto benchmark_directory() -> std::filesystem::path
+    {
+        auto const directory = std::filesystem::temp_directory_path() / "tml_benchmark";
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+    template <typename T>
+    auto write_raw(std::ofstream& file, T const& value) -> void
+    {
+        file.write(reinterpret_cast<char const*>(&value), sizeof(T)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    auto write_binary_ply(std::filesystem::path const& filepath, bench::geometry const& geometry) -> void
+    {
+        std::ofstream file{filepath, std::ios_base::binary};
+        file << "ply\nformat " << (std::endian::native == std::endian::little ? "binary_little_endian" : "binary_big_endian")
+             << " 1.0\nelement vertex " << geometry.positions.size() / 3UL
+             << "\nproperty float x\nproperty float y\nproperty float z\nelement face " << geometry.faces.size()
+             << "\nproperty list uchar uint vertex_indices\nend_header\n";
+
+        for (float const coordinate : geometry.positions)
+        {
+            write_raw(file, coordinate);
+        }
+
+        for (auto const& face : geometry.faces)
+        {
+            write_raw(file, std::uint8_t{3U});
+
+            for (tml::index_type const index : face.indices())
+            {
+                write_raw(file, index);
+            }
+        }
+    }
+} // namespace
+
+namespace bench
+{
+    auto shape_name(shape const kind) -> std::string
+    {
+        switch (kind)
+        {
+        case shape::icosphere:
+            return "icosphere";
+        case shape::grid:
+            return "grid";
+        case shape::fan:
+            return "fan";
+        }
+
+        return "unknown";
+    }
+
+    auto make_geometry(shape const kind, std::size_t const face_count) -> geometry
+    {
+        switch (kind)
+        {
+        case shape::icosphere:
+            return make_icosphere(face_count);
+        case shape::grid:
+            return make_grid(face_count);
+        case shape::fan:
+            return make_fan(face_count);
+        }
+
+        return {};
+    }
+
+    auto shape_file(shape const kind, std::size_t const face_count) -> std::filesystem::path
+    {
+        auto const filepath = benchmark_directory() / (shape_name(kind) + "_" + std::to_string(face_count) + ".ply");
+
+        if (!std::filesystem::exists(filepath))
+        {
+            // Written aside then renamed, so that an interrupted run never leaves a truncated file behind.
+            auto const partial = std::filesystem::path{filepath}.replace_extension(".partial");
+            write_binary_ply(partial, make_geometry(kind, face_count));
+            std::filesystem::rename(partial, filepath);
+        }
+
+        return filepath;
+    }
+
+    auto load_shape(shape const kind, std::size_t const face_count) -> tml::mesh
+    {
+        reset_peak_rss();
+        return tml::mesh{shape_file(kind, face_count)};
+    }
+
+    auto scratch_file(std::string const& name) -> std::filesystem::path { return benchmark_directory() / name; }
+
+    auto peak_rss() -> std::size_t
+    {
+#if defined(__linux__)
+        // VmHWM is the peak that clear_refs resets. ru_maxrss also keeps the peaks of the threads that exited, for good.
+        std::ifstream status{"/proc/self/status"};
+
+        for (std::string line; std::getline(status, line);)
+        {
+            if (line.starts_with("VmHWM:"))
+            {
+                return static_cast<std::size_t>(std::stoull(line.substr(6UL))) * 1024UL; // Kibibytes.
+            }
+        }
+
+        return 0UL;
+#elif defined(__unix__) || defined(__APPLE__)
+        rusage usage{};
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0UL;
+        }
+
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss); // Bytes on macOS.
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024UL; // Kibibytes everywhere else.
+#endif
+#else
+        return 0UL;
+#endif
+    }
+
+    auto reset_peak_rss() -> void
+    {
+#if defined(__linux__)
+        std::ofstream{"/proc/self/clear_refs"} << "5";
+#endif
+    }
+
+    auto report(benchmark::State& state, shape const kind, tml::mesh const& mesh) -> void
+    {
+        auto const faces = static_cast<std::int64_t>(mesh.faces().size());
+        state.SetLabel(shape_name(kind));
+        state.SetItemsProcessed(state.iterations() * faces);
+        state.counters["faces"] = static_cast<double>(faces);
+        state.counters["peak_rss"] =
+            benchmark::Counter(static_cast<double>(peak_rss()), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    }
+} // namespace bench
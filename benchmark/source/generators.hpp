@@ -0,0 +1,57 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <tml/face.hpp>
+#include <tml/mesh.hpp>
+#include <vector>
+
+namespace bench
+{
+    // Procedural meshes shared by the benchmarks, each stressing a different part of the library.
+    enum class shape
+    {
+        icosphere, // Closed and evenly tessellated, valence 6 almost everywhere.
+        grid,      // Open rippled height field with a long boundary.
+        fan,       // Open disc whose center vertex is shared by every face.
+    };
+
+    struct geometry
+    {
+        std::vector<float> positions;
+        std::vector<tml::face> faces;
+    };
+
+    // Face counts covered by the benchmarks, from 1K to 10M. Shapes only approach them: an icosphere has 20 * 4^n faces.
+    inline constexpr std::int64_t small_size{1'000};
+    inline constexpr std::int64_t medium_size{100'000};
+    inline constexpr std::int64_t large_size{1'000'000};
+    inline constexpr std::int64_t huge_size{10'000'000};
+
+    [[nodiscard]] auto shape_name(shape kind) -> std::string;
+
+    [[nodiscard]] auto make_geometry(shape kind, std::size_t face_count) -> geometry;
+
+    // Binary PLY file holding the shape, generated on first use and kept in the temporary directory between runs.
+    [[nodiscard]] auto shape_file(shape kind, std::size_t face_count) -> std::filesystem::path;
+
+    // Also resets the peak resident set size, so that the case loading the shape reports its own peak.
+    [[nodiscard]] auto load_shape(shape kind, std::size_t face_count) -> tml::mesh;
+
+    // Scratch file in the benchmark directory, for the files written by the benchmarks themselves.
+    [[nodiscard]] auto scratch_file(std::string const& name) -> std::filesystem::path;
+
+    // Largest resident set size reached by the process since the last reset_peak_rss in bytes, 0 where it cannot be
+    // queried.
+    [[nodiscard]] auto peak_rss() -> std::size_t;
+
+    // Brings the peak resident set size back to the current one on Linux. Elsewhere the peak only grows for the whole
+    // process, and comparing the peaks of two cases needs each of them run in its own process with --benchmark_filter.
+    auto reset_peak_rss() -> void;
+
+    // Labels the run with the shape and reports faces per second and the peak resident set size.
+    auto report(benchmark::State& state, shape kind, tml::mesh const& mesh) -> void;
+} // namespace bench
@@ -0,0 +1,102 @@
+#include "generators.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <tml/mesh.hpp>
+#include <tml/options.hpp>
+
+namespace
+{
+    struct file_format
+    {
+        char const* name;
+        char const* extension;
+        tml::encoding encoding;
+    };
+
+    constexpr std::array formats{
+        file_format{.name = "ply-ascii", .extension = ".ply", .encoding = tml::encoding::ascii},
+        file_format{.name = "ply-binary", .extension = ".ply", .encoding = tml::encoding::binary},
+        file_format{.name = "stl-ascii", .extension = ".stl", .encoding = tml::encoding::ascii},
+        file_format{.name = "stl-binary", .extension = ".stl", .encoding = tml::encoding::binary},
+        file_format{.name = "collada", .extension = ".dae", .encoding = tml::encoding::ascii},
+        file_format{.name = "tmlb", .extension = ".tmlb", .encoding = tml::encoding::binary},
+    };
+
+    auto write_options(file_format const& format, std::size_t const threads) -> tml::write_options
+    {
+        return tml::write_options{.can_overwrite = true, .encoding = format.encoding, .threads = threads};
+    }
+
+    // Labels the run with the format and reports faces and bytes per second on top of the common counters.
+    auto report(benchmark::State& state, file_format const& format, tml::mesh const& mesh,
+                std::filesystem::path const& filepath) -> void
+    {
+        bench::report(state, bench::shape::icosphere, mesh);
+        state.SetLabel(format.name);
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(filepath)));
+    }
+
+    auto mesh_read(benchmark::State& state) -> void
+    {
+        auto const& format = formats.at(static_cast<std::size_t>(state.range(0)));
+        auto const faces = static_cast<std::size_t>(state.range(1));
+        auto const threads = static_cast<std::size_t>(state.range(2));
+        auto const filepath = bench::scratch_file(std::string{"read_"} + format.name + format.extension);
+        auto const source = bench::load_shape(bench::shape::icosphere, faces);
+        static_cast<void>(source.write(filepath, write_options(format, 1UL)));
+
+        for (auto _ : state)
+        {
+            tml::mesh mesh;
+            benchmark::DoNotOptimize(mesh.read(filepath, tml::read_options{.threads = threads}));
+            benchmark::DoNotOptimize(mesh.positions().data());
+        }
+
+        report(state, format, source, filepath);
+        std::filesystem::remove(filepath);
+    }
+
+    auto mesh_write(benchmark::State& state) -> void
+    {
+        auto const& format = formats.at(static_cast<std::size_t>(state.range(0)));
+        auto const faces = static_cast<std::size_t>(state.range(1));
+        auto const threads = static_cast<std::size_t>(state.range(2));
+        auto const filepath = bench::scratch_file(std::string{"write_"} + format.name + format.extension);
+        auto const mesh = bench::load_shape(bench::shape::icosphere, faces);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mesh.write(filepath, write_options(format, threads)));
+        }
+
+        report(state, format, mesh, filepath);
+        std::filesystem::remove(filepath);
+    }
+
+    // Every format at every size, single-threaded and with the threads the ASCII paths can use.
+    auto io_arguments(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"format", "faces", "threads"});
+
+        for (std::int64_t format{0}; format < static_cast<std::int64_t>(formats.size()); ++format)
+        {
+            for (auto const faces : {bench::small_size, bench::medium_size, bench::large_size, bench::huge_size})
+            {
+                benchmark->Args({format, faces, 1});
+
+                if (formats.at(static_cast<std::size_t>(format)).encoding == tml::encoding::ascii)
+                {
+                    benchmark->Args({format, faces, 4});
+                }
+            }
+        }
+    }
+} // namespace
+
+BENCHMARK(mesh_read)->Apply(io_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_write)->Apply(io_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,161 @@
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tml/mesh.hpp>
+
+namespace
+{
+    auto shape_of(benchmark::State const& state) -> bench::shape { return static_cast<bench::shape>(state.range(0)); }
+
+    auto mesh_of(benchmark::State const& state) -> tml::mesh
+    {
+        return bench::load_shape(shape_of(state), static_cast<std::size_t>(state.range(1)));
+    }
+
+    auto mesh_area(benchmark::State& state) -> void
+    {
+        auto const mesh = mesh_of(state);
+        auto const threads = static_cast<std::size_t>(state.range(2));
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mesh.area(threads));
+        }
+
+        bench::report(state, shape_of(state), mesh);
+    }
+
+    auto mesh_is_closed(benchmark::State& state) -> void
+    {
+        auto const mesh = mesh_of(state);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mesh.is_closed());
+        }
+
+        bench::report(state, shape_of(state), mesh);
+    }
+
+    auto mesh_center(benchmark::State& state) -> void
+    {
+        auto mesh = mesh_of(state);
+
+        for (auto _ : state)
+        {
+            // A null noise leaves the vertices in place but drops the cached bounds, so every iteration recomputes them.
+            state.PauseTiming();
+            mesh.noise(0.0F, 0U);
+            state.ResumeTiming();
+
+            mesh.center();
+            benchmark::DoNotOptimize(mesh.positions().data());
+        }
+
+        bench::report(state, shape_of(state), mesh);
+    }
+
+    auto mesh_scale(benchmark::State& state) -> void
+    {
+        auto mesh = mesh_of(state);
+        float factor{2.0F};
+
+        for (auto _ : state)
+        {
+            // Alternates between doubling and halving, exactly, so the coordinates never drift towards infinity.
+            mesh.scale(factor);
+            factor = 1.0F / factor;
+            benchmark::DoNotOptimize(mesh.positions().data());
+        }
+
+        bench::report(state, shape_of(state), mesh);
+    }
+
+    auto mesh_noise(benchmark::State& state) -> void
+    {
+        auto mesh = mesh_of(state);
+        auto const threads = static_cast<std::size_t>(state.range(2));
+        std::uint64_t seed{0U};
+
+        for (auto _ : state)
+        {
+            mesh.noise(1e-4F, seed++, threads);
+            benchmark::DoNotOptimize(mesh.positions().data());
+        }
+
+        bench::report(state, shape_of(state), mesh);
+    }
+
+    auto mesh_subdivide(benchmark::State& state) -> void
+    {
+        auto const source = mesh_of(state);
+        auto const threads = static_cast<std::size_t>(state.range(2));
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto mesh = source;
+            state.ResumeTiming();
+
+            mesh.subdivide(1UL, threads);
+            benchmark::DoNotOptimize(mesh.positions().data());
+        }
+
+        bench::report(state, shape_of(state), source);
+    }
+
+    // Decimates down to a tenth of the faces. Each collapse removes one vertex, which gives the collapses per second.
+    auto mesh_decimate(benchmark::State& state) -> void
+    {
+        auto const source = mesh_of(state);
+        auto const threads = static_cast<std::size_t>(state.range(2));
+        std::size_t collapses{0UL};
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto mesh = source;
+            state.ResumeTiming();
+
+            mesh.decimate(source.faces().size() / 10UL, threads);
+            benchmark::DoNotOptimize(mesh.positions().data());
+            collapses += (source.positions().size() - mesh.positions().size()) / 3UL;
+        }
+
+        bench::report(state, shape_of(state), source);
+        state.counters["collapses"] = benchmark::Counter(static_cast<double>(collapses), benchmark::Counter::kIsRate);
+    }
+
+    // Every shape at every face count up to MaxFaces, on 1 and 4 threads when Threaded.
+    template <std::int64_t MaxFaces, bool Threaded>
+    auto arguments(benchmark::internal::Benchmark* benchmark) -> void
+    {
+        benchmark->ArgNames({"shape", "faces", "threads"});
+
+        for (auto const kind : {bench::shape::icosphere, bench::shape::grid, bench::shape::fan})
+        {
+            for (auto const faces : {bench::small_size, bench::medium_size, bench::large_size, bench::huge_size})
+            {
+                for (std::int64_t const threads : {1, 4})
+                {
+                    if (faces <= MaxFaces && (Threaded || threads == 1))
+                    {
+                        benchmark->Args({static_cast<std::int64_t>(kind), faces, threads});
+                    }
+                }
+            }
+        }
+    }
+} // namespace
+
+BENCHMARK(mesh_area)->Apply(arguments<bench::huge_size, true>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_is_closed)->Apply(arguments<bench::huge_size, false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(mesh_center)->Apply(arguments<bench::huge_size, false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(mesh_scale)->Apply(arguments<bench::huge_size, false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(mesh_noise)->Apply(arguments<bench::huge_size, true>)->Unit(benchmark::kMillisecond)->UseRealTime();
+// Subdividing 10M faces would need 40M more in memory, so the largest meshes stop at 1M.
+BENCHMARK(mesh_subdivide)->Apply(arguments<bench::large_size, true>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_decimate)->Apply(arguments<bench::large_size, true>)->Unit(benchmark::kMillisecond)->UseRealTime();
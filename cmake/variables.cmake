@@ -9,6 +9,18 @@ if(PROJECT_IS_TOP_LEVEL)
   option(BUILD_SHARED_LIBS "Build shared libs." OFF)
 endif()
 
+# ---- Index width ----
+
+# Faces, edges and the vertex adjacency store 32 bits indices unless this is set,
+# which is only needed for meshes of more than 2^32 - 1 vertices
+option(tml_64_BIT_INDICES "Store vertex indices on 64 bits" OFF)
+
+# ---- Statistics ----
+
+# Counters and per-phase timers of the reads, writes and adjacency builds,
+# exposed through tml::stats_snapshot; without this every probe compiles away
+option(tml_ENABLE_STATS "Record I/O and adjacency statistics" OFF)
+
 # ---- Suppress C4251 on Windows ----
 
 # Please see include/tml/tml.hpp for more details
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm> // std::min, std::max
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits
+
+namespace tml
+{
+    // Axis-aligned bounding box. A default constructed box is empty: its minimum is above its maximum on every axis, so that
+    // extending it by a first point gives that point.
+    struct aabb
+    {
+        std::array<float, 3> min{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::infinity()};
+        std::array<float, 3> max{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity()};
+
+        [[nodiscard]] constexpr auto empty() const noexcept -> bool
+        {
+            return !(min[0] <= max[0] && min[1] <= max[1] && min[2] <= max[2]);
+        }
+
+        constexpr auto extend(std::array<float, 3> const& point) noexcept -> aabb&
+        {
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                min[axis] = std::min(min[axis], point[axis]);
+                max[axis] = std::max(max[axis], point[axis]);
+            }
+
+            return *this;
+        }
+
+        constexpr auto extend(aabb const& other) noexcept -> aabb&
+        {
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                min[axis] = std::min(min[axis], other.min[axis]);
+                max[axis] = std::max(max[axis], other.max[axis]);
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] constexpr auto contains(std::array<float, 3> const& point) const noexcept -> bool
+        {
+            return min[0] <= point[0] && point[0] <= max[0] && min[1] <= point[1] && point[1] <= max[1] && min[2] <= point[2] &&
+                   point[2] <= max[2];
+        }
+
+        [[nodiscard]] constexpr auto overlaps(aabb const& other) const noexcept -> bool
+        {
+            return min[0] <= other.max[0] && other.min[0] <= max[0] && min[1] <= other.max[1] && other.min[1] <= max[1] &&
+                   min[2] <= other.max[2] && other.min[2] <= max[2];
+        }
+
+        [[nodiscard]] constexpr auto center() const noexcept -> std::array<float, 3>
+        {
+            return {(min[0] + max[0]) * 0.5F, (min[1] + max[1]) * 0.5F, (min[2] + max[2]) * 0.5F};
+        }
+
+        [[nodiscard]] constexpr auto extent() const noexcept -> std::array<float, 3>
+        {
+            return {max[0] - min[0], max[1] - min[1], max[2] - min[2]};
+        }
+
+        [[nodiscard]] constexpr auto surface_area() const noexcept -> float
+        {
+            if (empty())
+            {
+                return 0.0F;
+            }
+
+            auto const [dx, dy, dz] = extent();
+
+            return 2.0F * (dx * dy + dy * dz + dz * dx);
+        }
+    };
+} // namespace tml
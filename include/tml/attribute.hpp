@@ -0,0 +1,79 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t
+#include <span> // std::span
+#include <string> // std::string
+#include <variant> // std::variant, std::get_if
+#include <vector> // std::vector
+
+namespace tml
+{
+    // Scalar types of the PLY format, which attribute channels keep as they were read.
+    enum class attribute_type
+    {
+        int8,
+        uint8,
+        int16,
+        uint16,
+        int32,
+        uint32,
+        float32,
+        float64,
+    };
+
+    // One named scalar per vertex or per face, such as a color component, a texture coordinate or a confidence, stored
+    // contiguously with its original type.
+    class TML_EXPORT attribute_channel
+    {
+    public:
+
+        attribute_channel(std::string name, attribute_type type, std::size_t size = 0UL);
+
+        [[nodiscard]] auto name() const noexcept -> std::string const&;
+
+        [[nodiscard]] auto type() const noexcept -> attribute_type;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+        // The values as stored, empty when T is not the type of the channel.
+        template <typename T>
+        [[nodiscard]] auto values() const noexcept -> std::span<T const>
+        {
+            auto const* const values = std::get_if<std::vector<T>>(&m_values);
+            return values != nullptr ? std::span<T const>{*values} : std::span<T const>{};
+        }
+
+        template <typename T>
+        [[nodiscard]] auto values() noexcept -> std::span<T>
+        {
+            auto* const values = std::get_if<std::vector<T>>(&m_values);
+            return values != nullptr ? std::span<T>{*values} : std::span<T>{};
+        }
+
+        // The value of one element converted to double, whatever the type of the channel.
+        [[nodiscard]] auto value(std::size_t index) const noexcept -> double;
+
+        // First byte of the values, element_size() bytes each.
+        [[nodiscard]] auto data() noexcept -> void*;
+
+        [[nodiscard]] auto data() const noexcept -> void const*;
+
+        [[nodiscard]] auto element_size() const noexcept -> std::size_t;
+
+        auto resize(std::size_t size) -> void;
+
+        // Appends the values of a channel of the same type and returns true, or returns false and leaves this one as is.
+        auto append(attribute_channel const& other) -> bool;
+
+    private:
+
+        std::string m_name;
+        std::variant<std::vector<std::int8_t>, std::vector<std::uint8_t>, std::vector<std::int16_t>,
+                     std::vector<std::uint16_t>, std::vector<std::int32_t>, std::vector<std::uint32_t>, std::vector<float>,
+                     std::vector<double>>
+            m_values;
+    };
+} // namespace tml
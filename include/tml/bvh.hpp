@@ -0,0 +1,98 @@
+#pragma once
+
+#include "tml/aabb.hpp" // tml::aabb
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/face.hpp" // tml::face
+
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <vector> // std::vector
+
+namespace tml
+{
+    // Half-line origin + t * direction for t in [t_min, t_max]. The direction does not need to be normalized, distances are
+    // then expressed in its length.
+    struct ray
+    {
+        std::array<float, 3> origin{};
+        std::array<float, 3> direction{};
+        float t_min{0.0F};
+        float t_max{std::numeric_limits<float>::infinity()};
+    };
+
+    // Nearest intersection of a ray. The hit point is (1 - u - v) * v1 + u * v2 + v * v3 for the corners v1, v2 and v3 of
+    // the face.
+    struct ray_hit
+    {
+        static constexpr std::size_t no_face{std::numeric_limits<std::size_t>::max()};
+
+        std::size_t face{no_face};
+        float distance{std::numeric_limits<float>::infinity()};
+        float u{0.0F};
+        float v{0.0F};
+
+        constexpr explicit operator bool() const noexcept { return face != no_face; }
+    };
+
+    // Point of the surface closest to a query point.
+    struct surface_point
+    {
+        std::array<float, 3> position{};
+        std::size_t face{ray_hit::no_face};
+        float squared_distance{std::numeric_limits<float>::infinity()};
+
+        constexpr explicit operator bool() const noexcept { return face != ray_hit::no_face; }
+    };
+
+    // Bounding volume hierarchy over the faces of a mesh, built top-down with binned SAH. Nodes live in one flat array and
+    // siblings are stored next to each other, so an inner node only keeps the index of its first child. Leaves hold up to
+    // four faces whose corners are copied in leaf order, so that queries never touch the mesh and test a whole leaf at once.
+    // Meshes with 2^31 faces or more are not supported and give an empty hierarchy.
+    class TML_EXPORT bvh
+    {
+    public:
+
+        // 32 bytes: the bounds, then either the first child of an inner node (count == 0) or the first face slot of a leaf.
+        struct node
+        {
+            std::array<float, 3> min;
+            std::uint32_t index;
+            std::array<float, 3> max;
+            std::uint32_t count;
+        };
+
+        bvh() noexcept = default;
+
+        bvh(std::span<float const> positions, std::span<face const> faces, std::size_t threads = 1UL);
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return m_nodes.empty(); }
+
+        [[nodiscard]] auto nodes() const noexcept -> std::span<node const> { return m_nodes; }
+
+        [[nodiscard]] auto bounds() const noexcept -> aabb;
+
+        [[nodiscard]] auto intersect(ray const& query) const noexcept -> ray_hit;
+
+        // Intersects rays[i] into hits[i] for the first min(rays.size(), hits.size()) rays.
+        auto intersect(std::span<ray const> rays, std::span<ray_hit> hits, std::size_t threads = 1UL) const noexcept -> void;
+
+        [[nodiscard]] auto closest_point(std::array<float, 3> const& point) const noexcept -> surface_point;
+
+        // Faces whose bounds overlap the box, in increasing order.
+        [[nodiscard]] auto overlapping(aabb const& box) const -> std::vector<std::size_t>;
+
+    private:
+
+        [[nodiscard]] auto corner(std::size_t slot, std::size_t corner) const noexcept -> std::array<float, 3>;
+
+        std::vector<node> m_nodes;
+        std::vector<std::uint32_t> m_faces;
+
+        // Corners of the faces in leaf order, as nine arrays (x, y, z of each corner) of m_stride floats.
+        std::vector<float> m_corners;
+        std::size_t m_stride{0UL};
+    };
+} // namespace tml
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "tml/index.hpp" // tml::index_type
+
 #include <cstddef> // std::size_t
 #include <functional> // std::hash
 
@@ -7,7 +9,7 @@ namespace tml
 {
     struct edge
     {
-        std::size_t v1, v2;
+        index_type v1, v2;
 
         constexpr auto operator==(edge const& other) const noexcept -> bool { return v1 == other.v1 && v2 == other.v2; }
 
@@ -20,6 +22,9 @@ struct std::hash<tml::edge>
 {
     auto operator()(tml::edge const& edge) const noexcept -> std::size_t
     {
-        return std::hash<std::size_t>{}(edge.v1) ^ std::hash<std::size_t>{}(edge.v2);
+        // std::hash<std::size_t> is usually the identity, mix the first index so that (a, b) and (b, a) or nearby pairs do
+        // not collide.
+        std::size_t const h1 = std::hash<tml::index_type>{}(edge.v1) * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+        return (h1 ^ (h1 >> 29U)) + std::hash<tml::index_type>{}(edge.v2);
     }
 };
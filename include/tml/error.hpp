@@ -16,6 +16,7 @@ namespace tml
         unsupported_format,
         invalid_data,
         invalid_filepath,
+        index_out_of_range,
     };
 
     static constexpr std::array errors{
@@ -26,6 +27,7 @@ namespace tml
         "The provided file format is not supported"sv,
         "Read data is invalid, the file might be corrupted"sv,
         "The provided filepath is not valid"sv,
+        "The mesh has more vertices than the index type can address"sv,
     };
 
     [[nodiscard]] constexpr auto format_error(error_code const error) noexcept -> std::string_view
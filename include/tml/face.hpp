@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tml/config.hpp" // TML_EXPORT
+#include "tml/index.hpp" // tml::index_type
 
 #include <array> // std::array
 
@@ -10,14 +11,16 @@ namespace tml
     {
     public:
 
-        face(std::size_t v1, std::size_t v2, std::size_t v3) noexcept;
+        face() noexcept = default;
 
-        [[nodiscard]] auto indices() const noexcept -> std::array<std::size_t, 3> const&;
+        face(index_type v1, index_type v2, index_type v3) noexcept;
+
+        [[nodiscard]] auto indices() const noexcept -> std::array<index_type, 3> const&;
 
         auto invert() noexcept -> face&;
 
     private:
 
-        std::array<std::size_t, 3> m_indices;
+        std::array<index_type, 3> m_indices{};
     };
 } // namespace tml
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/face.hpp" // tml::face
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <vector> // std::vector
+
+namespace tml
+{
+    // Index-based half-edge connectivity of a triangle mesh. The half-edges of face f are 3f, 3f + 1 and 3f + 2, going from
+    // its first to second, second to third and third to first corner, so next, prev and face_of are computed rather than
+    // stored. Half-edges on the boundary, on a non-manifold edge or against an inconsistently oriented neighbor have no twin.
+    // Meshes with more than 2^32 - 1 half-edges or vertices are not supported and give an empty topology.
+    class TML_EXPORT half_edge_topology
+    {
+    public:
+
+        using index_type = std::uint32_t;
+
+        static constexpr index_type invalid{std::numeric_limits<index_type>::max()};
+
+        half_edge_topology() noexcept = default;
+
+        half_edge_topology(std::span<face const> faces, std::size_t vertex_count);
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return m_origins.empty(); }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return m_origins.size(); }
+
+        [[nodiscard]] auto twin(index_type const half_edge) const noexcept -> index_type { return m_twins[half_edge]; }
+
+        [[nodiscard]] static constexpr auto next(index_type const half_edge) noexcept -> index_type
+        {
+            return half_edge % 3U == 2U ? half_edge - 2U : half_edge + 1U;
+        }
+
+        [[nodiscard]] static constexpr auto prev(index_type const half_edge) noexcept -> index_type
+        {
+            return half_edge % 3U == 0U ? half_edge + 2U : half_edge - 1U;
+        }
+
+        [[nodiscard]] static constexpr auto face_of(index_type const half_edge) noexcept -> index_type { return half_edge / 3U; }
+
+        [[nodiscard]] auto origin(index_type const half_edge) const noexcept -> index_type { return m_origins[half_edge]; }
+
+        [[nodiscard]] auto target(index_type const half_edge) const noexcept -> index_type { return m_origins[next(half_edge)]; }
+
+        [[nodiscard]] auto is_boundary(index_type const half_edge) const noexcept -> bool
+        {
+            return m_twins[half_edge] == invalid;
+        }
+
+        // One half-edge leaving the vertex, a boundary one when there is any, or invalid for an isolated vertex.
+        [[nodiscard]] auto outgoing(index_type const vertex) const noexcept -> index_type { return m_outgoing[vertex]; }
+
+        // Calls fn(half_edge) for the half-edges leaving vertex, in order around it. On the boundary the walk starts from the
+        // boundary half-edge and stops at the other side of the fan, whose last neighbor is the origin of prev(last).
+        template <typename F>
+        auto for_each_outgoing(index_type const vertex, F&& fn) const -> void
+        {
+            index_type const first = m_outgoing[vertex];
+
+            if (first == invalid)
+            {
+                return;
+            }
+
+            index_type half_edge = first;
+
+            do
+            {
+                fn(half_edge);
+                half_edge = m_twins[prev(half_edge)];
+            } while (half_edge != invalid && half_edge != first);
+        }
+
+    private:
+
+        std::vector<index_type> m_twins;
+        std::vector<index_type> m_origins;
+        std::vector<index_type> m_outgoing;
+    };
+} // namespace tml
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <limits> // std::numeric_limits
+
+namespace tml
+{
+    // Type of the vertex indices held by faces, edges and the vertex adjacency. It is 32 bits wide unless the library is
+    // built with tml_64_BIT_INDICES, which is only needed for meshes of more than 2^32 - 1 vertices.
+#if defined(TML_64_BIT_INDICES)
+    using index_type = std::uint64_t;
+#else
+    using index_type = std::uint32_t;
+#endif
+
+    // Readers fail with error_code::index_out_of_range on meshes holding more vertices than this.
+    inline constexpr std::size_t max_vertex_count{std::numeric_limits<index_type>::max()};
+} // namespace tml
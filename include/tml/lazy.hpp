@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic> // std::atomic, std::memory_order_acquire, std::memory_order_release, std::memory_order_relaxed
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::move
+
+namespace tml
+{
+    // Value derived from the state of its owner and computed by the first const call needing it. That call fills it under a
+    // lock, concurrent ones wait for it, and later ones only load a flag, so const callers may share the owner freely. The
+    // non-const functions are for the owner's own non-const operations, which must not run concurrently with any other call.
+    // Copies take the value when it is filled, never the lock.
+    template <typename T>
+    class lazy
+    {
+    public:
+
+        lazy() = default;
+
+        lazy(lazy const& other) { copy_from(other); }
+
+        lazy(lazy&& other) noexcept : m_value{std::move(other.m_value)}, m_valid{other.m_valid.load(std::memory_order_relaxed)}
+        {
+            other.m_valid.store(false, std::memory_order_relaxed);
+        }
+
+        auto operator=(lazy const& other) -> lazy&
+        {
+            if (this != &other)
+            {
+                copy_from(other);
+            }
+
+            return *this;
+        }
+
+        auto operator=(lazy&& other) noexcept -> lazy&
+        {
+            m_value = std::move(other.m_value);
+            m_valid.store(other.m_valid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.m_valid.store(false, std::memory_order_relaxed);
+
+            return *this;
+        }
+
+        ~lazy() = default;
+
+        // The value, filled by calling fill with it first when it is not valid.
+        template <typename Fill>
+        auto get(Fill&& fill) const -> T const&
+        {
+            if (!m_valid.load(std::memory_order_acquire))
+            {
+                std::lock_guard const lock{m_mutex};
+
+                if (!m_valid.load(std::memory_order_relaxed))
+                {
+                    fill(m_value);
+                    m_valid.store(true, std::memory_order_release);
+                }
+            }
+
+            return m_value;
+        }
+
+        [[nodiscard]] auto valid() const noexcept -> bool { return m_valid.load(std::memory_order_acquire); }
+
+        // The value as it is, valid or not.
+        [[nodiscard]] auto peek() const noexcept -> T const& { return m_value; }
+
+        // Replaces the value by one known to be up to date.
+        auto assign(T value) noexcept -> void
+        {
+            m_value = std::move(value);
+            m_valid.store(true, std::memory_order_release);
+        }
+
+        // Drops the value, so that the next get fills it again.
+        auto reset() noexcept -> void
+        {
+            m_valid.store(false, std::memory_order_relaxed);
+            m_value = T{};
+        }
+
+    private:
+
+        auto copy_from(lazy const& other) -> void
+        {
+            std::lock_guard const lock{other.m_mutex};
+            bool const valid = other.m_valid.load(std::memory_order_relaxed);
+            m_value = valid ? other.m_value : T{};
+            m_valid.store(valid, std::memory_order_relaxed);
+        }
+
+        mutable T m_value{};
+        mutable std::atomic<bool> m_valid{false};
+        mutable std::mutex m_mutex;
+    };
+} // namespace tml
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array> // std::array
+#include <cmath> // std::cos, std::sin, std::sqrt
+#include <cstddef> // std::size_t
+
+namespace tml
+{
+    // Row-major 4x4 matrix acting on column vectors: a point p becomes rows * (p, 1), divided by its last coordinate unless
+    // the last row is (0, 0, 0, 1). The product a * b applies b first, so chained factories read right to left.
+    struct matrix4
+    {
+        std::array<std::array<float, 4>, 4> rows{{
+            {1.0F, 0.0F, 0.0F, 0.0F},
+            {0.0F, 1.0F, 0.0F, 0.0F},
+            {0.0F, 0.0F, 1.0F, 0.0F},
+            {0.0F, 0.0F, 0.0F, 1.0F},
+        }};
+
+        [[nodiscard]] static constexpr auto identity() noexcept -> matrix4 { return {}; }
+
+        [[nodiscard]] static constexpr auto translation(std::array<float, 3> const& offset) noexcept -> matrix4
+        {
+            matrix4 result;
+            result.rows[0][3] = offset[0];
+            result.rows[1][3] = offset[1];
+            result.rows[2][3] = offset[2];
+
+            return result;
+        }
+
+        [[nodiscard]] static constexpr auto scaling(std::array<float, 3> const& factors) noexcept -> matrix4
+        {
+            matrix4 result;
+            result.rows[0][0] = factors[0];
+            result.rows[1][1] = factors[1];
+            result.rows[2][2] = factors[2];
+
+            return result;
+        }
+
+        [[nodiscard]] static constexpr auto scaling(float const factor) noexcept -> matrix4
+        {
+            return scaling({factor, factor, factor});
+        }
+
+        // Counterclockwise rotation of angle radians around axis, which does not need to be normalized.
+        [[nodiscard]] static auto rotation(std::array<float, 3> const& axis, float const angle) noexcept -> matrix4
+        {
+            float const length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+            if (length == 0.0F)
+            {
+                return {};
+            }
+
+            float const x = axis[0] / length;
+            float const y = axis[1] / length;
+            float const z = axis[2] / length;
+            float const c = std::cos(angle);
+            float const s = std::sin(angle);
+            float const t = 1.0F - c;
+            matrix4 result;
+            result.rows[0] = {t * x * x + c, t * x * y - s * z, t * x * z + s * y, 0.0F};
+            result.rows[1] = {t * x * y + s * z, t * y * y + c, t * y * z - s * x, 0.0F};
+            result.rows[2] = {t * x * z - s * y, t * y * z + s * x, t * z * z + c, 0.0F};
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr auto is_affine() const noexcept -> bool
+        {
+            return rows[3][0] == 0.0F && rows[3][1] == 0.0F && rows[3][2] == 0.0F && rows[3][3] == 1.0F;
+        }
+
+        [[nodiscard]] constexpr auto apply(std::array<float, 3> const& point) const noexcept -> std::array<float, 3>
+        {
+            std::array<float, 4> result{};
+
+            for (std::size_t row{0UL}; row < 4UL; ++row)
+            {
+                result[row] = rows[row][0] * point[0] + rows[row][1] * point[1] + rows[row][2] * point[2] + rows[row][3];
+            }
+
+            if (is_affine())
+            {
+                return {result[0], result[1], result[2]};
+            }
+
+            return {result[0] / result[3], result[1] / result[3], result[2] / result[3]};
+        }
+
+        [[nodiscard]] constexpr auto operator*(matrix4 const& other) const noexcept -> matrix4
+        {
+            matrix4 result;
+
+            for (std::size_t row{0UL}; row < 4UL; ++row)
+            {
+                for (std::size_t column{0UL}; column < 4UL; ++column)
+                {
+                    result.rows[row][column] = rows[row][0] * other.rows[0][column] + rows[row][1] * other.rows[1][column] +
+                                               rows[row][2] * other.rows[2][column] + rows[row][3] * other.rows[3][column];
+                }
+            }
+
+            return result;
+        }
+
+        constexpr auto operator==(matrix4 const& other) const noexcept -> bool = default;
+    };
+} // namespace tml
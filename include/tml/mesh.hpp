@@ -1,11 +1,22 @@
 #pragma once
 
+#include "tml/aabb.hpp" // tml::aabb
+#include "tml/attribute.hpp" // tml::attribute_channel
 #include "tml/config.hpp" // TML_EXPORT
 #include "tml/error.hpp" // tml::error_code
 #include "tml/face.hpp" // tml::face
-#include "tml/vertex.hpp" // tml::vertex
-
+#include "tml/half_edge_topology.hpp" // tml::half_edge_topology
+#include "tml/index.hpp" // tml::index_type
+#include "tml/lazy.hpp" // tml::lazy
+#include "tml/matrix4.hpp" // tml::matrix4
+#include "tml/options.hpp" // tml::read_options, tml::write_options, tml::normal_weighting
+#include "tml/topology.hpp" // tml::topology_report
+#include "tml/vertex_view.hpp" // tml::vertex_view
+
+#include <cstdint> // std::uint64_t
 #include <filesystem> // std::filesystem::path, std::filesystem::exists
+#include <span> // std::span
+#include <string_view> // std::string_view
 #include <vector> // std::vector
 
 namespace tml
@@ -16,48 +27,171 @@ namespace tml
 
         mesh() noexcept = default;
 
-        explicit mesh(std::filesystem::path const& filepath);
+        explicit mesh(std::filesystem::path const& filepath, read_options const& options = {});
+
+        [[nodiscard]] auto vertices() const noexcept -> vertex_view;
+
+        [[nodiscard]] auto positions() const noexcept -> std::span<float const>;
 
-        [[nodiscard]] auto vertices() const noexcept -> std::vector<vertex> const&;
+        [[nodiscard]] auto neighbors(std::size_t index) const noexcept -> std::span<index_type const>;
 
         [[nodiscard]] auto faces() const noexcept -> std::vector<face> const&;
 
-        [[nodiscard]] auto area() const noexcept -> float;
+        // Half-edge connectivity, built on first use and rebuilt after any operation changing the faces.
+        [[nodiscard]] auto topology() const noexcept -> half_edge_topology const&;
+
+        // Per-axis bounding box of the vertices, computed on first use and kept until the positions change. Empty when the
+        // mesh has no vertex.
+        [[nodiscard]] auto bounds(std::size_t threads = 1UL) const noexcept -> aabb;
+
+        [[nodiscard]] auto area(std::size_t threads = 1UL) const noexcept -> float;
+
+        // Writes the area of each face to areas, which should hold faces().size() values.
+        auto area_per_face(std::span<float> areas, std::size_t threads = 1UL) const noexcept -> void;
+
+        // Unit normal of each face following its winding, three values per face, null for degenerate faces. Computed on first
+        // use and kept until the positions or the faces change.
+        [[nodiscard]] auto face_normals(std::size_t threads = 1UL) const noexcept -> std::span<float const>;
+
+        // Unit normal of each vertex, three values per vertex: the sum of the normals of its faces weighted by their area or
+        // by their angle at the vertex, normalized. Null for vertices without a face. Cached like the face normals, each
+        // weighting apart from the other.
+        [[nodiscard]] auto vertex_normals(normal_weighting weighting = normal_weighting::area, std::size_t threads = 1UL) const
+            noexcept -> std::span<float const>;
+
+        // Values of the other scalar properties of the vertices and faces read from PLY files, such as colors or confidences,
+        // one channel per property in the order of the file. Appending a file keeps the channels both have with the same
+        // type, and reading another format or changing the number of vertices or faces drops the channels left incomplete.
+        // Moving the positions drops the nx, ny and nz channels, which would no longer match them.
+        [[nodiscard]] auto vertex_attributes() const noexcept -> std::span<attribute_channel const>;
+
+        [[nodiscard]] auto face_attributes() const noexcept -> std::span<attribute_channel const>;
+
+        // The channel of that name, or null when there is none.
+        [[nodiscard]] auto vertex_attribute(std::string_view name) const noexcept -> attribute_channel const*;
+
+        [[nodiscard]] auto face_attribute(std::string_view name) const noexcept -> attribute_channel const*;
 
         [[nodiscard]] auto is_closed() const noexcept -> bool;
 
+        [[nodiscard]] auto analyze_topology(std::size_t threads = 1UL) const noexcept -> topology_report;
+
+        // Translation moving the center of the bounding box of the mesh to the origin, as applied by center(). Composing it
+        // with other matrices applies them all in a single pass, e.g. transform(matrix4::scaling(2.0F) * centering()).
+        [[nodiscard]] auto centering() const noexcept -> matrix4;
+
         auto center() noexcept -> mesh&;
 
         auto invert() noexcept -> mesh&;
 
         auto scale(float factor) noexcept -> mesh&;
 
+        // Moves each coordinate by a uniform value of [-coefficient, coefficient), drawn from a random seed.
         auto noise(float coefficient) noexcept -> mesh&;
 
-        auto subdivide() noexcept -> mesh&;
+        // Same, drawing the value of each coordinate from the seed and the index of the coordinate alone, so that the result
+        // is reproducible and does not depend on the number of threads.
+        auto noise(float coefficient, std::uint64_t seed, std::size_t threads = 1UL) noexcept -> mesh&;
+
+        // Moves each vertex along its normal, the area-weighted average of the normals of its faces, by a uniform value of
+        // [-coefficient, coefficient) drawn from the seed and the index of the vertex. Vertices without a face do not move.
+        auto noise_along_normals(float coefficient, std::uint64_t seed, std::size_t threads = 1UL) noexcept -> mesh&;
+
+        // Applies the matrix to every vertex in one pass over the positions. A matrix with a negative determinant mirrors the
+        // mesh, whose faces then point inwards until invert() is called.
+        auto transform(matrix4 const& matrix, std::size_t threads = 1UL) noexcept -> mesh&;
+
+        // Merges the vertices closer than epsilon to each other, transitively: a chain of vertices each within epsilon of the
+        // next one becomes a single vertex, however far apart its ends are. Drops the faces that become degenerate. Each group
+        // keeps the position of its lowest index vertex. With epsilon = 0, only vertices with equal coordinates merge.
+        auto weld(float epsilon = 0.0F, std::size_t threads = 1UL) noexcept -> mesh&;
+
+        // Applies `levels` steps of Loop subdivision, each one adding a vertex per edge and splitting every face in four. Stops
+        // early when the next level would hold more than max_vertex_count vertices.
+        auto subdivide(std::size_t levels = 1UL, std::size_t threads = 1UL) noexcept -> mesh&;
+
+        // Collapses edges in increasing order of quadric error until at most target_face_count faces remain, each collapse
+        // moving the kept vertex to the position of least error. Collapses that would pinch the surface, join two boundaries
+        // or fold a face over are skipped, so the target may not be reached. Meshes of at least 2^17 faces are first cut
+        // into spatial clusters decimated independently, on several threads, and the result does not depend on the thread
+        // count. Meshes of more than 2^32 - 1 corners are left unchanged.
+        auto decimate(std::size_t target_face_count, std::size_t threads = 1UL) noexcept -> mesh&;
 
         auto read(std::filesystem::path const& filepath) noexcept -> parse_error;
 
+        auto read(std::filesystem::path const& filepath, read_options const& options) noexcept -> parse_error;
+
         auto write(std::filesystem::path const& filepath, bool can_overwrite = false) const noexcept -> write_error;
 
+        auto write(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error;
+
     private:
 
-        [[nodiscard]] auto load_from_ply(std::filesystem::path const& filepath) noexcept -> parse_error;
+        [[nodiscard]] auto load_from_ply(std::filesystem::path const& filepath, read_options const& options) noexcept
+            -> parse_error;
 
         [[nodiscard]] auto load_from_stl(std::filesystem::path const& filepath) noexcept -> parse_error;
 
         [[nodiscard]] auto load_from_collada(std::filesystem::path const& filepath) noexcept -> parse_error;
 
-        [[nodiscard]] auto save_to_ply(std::filesystem::path const& filepath, bool can_overwrite = false) const noexcept
+        [[nodiscard]] auto load_from_tmlb(std::filesystem::path const& filepath) noexcept -> parse_error;
+
+        [[nodiscard]] auto save_to_ply(std::filesystem::path const& filepath, write_options const& options) const noexcept
+            -> write_error;
+
+        [[nodiscard]] auto save_to_stl(std::filesystem::path const& filepath, write_options const& options) const noexcept
             -> write_error;
 
-        [[nodiscard]] auto save_to_stl(std::filesystem::path const& filepath, bool can_overwrite = false) const noexcept
+        [[nodiscard]] auto save_to_collada(std::filesystem::path const& filepath, write_options const& options) const noexcept
             -> write_error;
 
-        [[nodiscard]] auto save_to_collada(std::filesystem::path const& filepath, bool can_overwrite = false) const noexcept
+        [[nodiscard]] auto save_to_tmlb(std::filesystem::path const& filepath, write_options const& options) const noexcept
             -> write_error;
 
-        std::vector<vertex> m_vertices;
+        // Compressed-sparse-row vertex adjacency. The neighbors of vertex i are neighbors[offsets[i], offsets[i + 1]).
+        struct csr_adjacency
+        {
+            std::vector<std::size_t> offsets;
+            std::vector<index_type> neighbors;
+        };
+
+        // The adjacency, built from m_faces on first use.
+        [[nodiscard]] auto adjacency(std::size_t threads = 1UL) const noexcept -> csr_adjacency const&;
+
+        auto build_adjacency(csr_adjacency& adjacency, std::size_t threads) const noexcept -> void;
+
+        auto compute_bounds(aabb& bounds, std::size_t threads) const noexcept -> void;
+
+        auto compute_vertex_normals(std::vector<float>& vertex_normals, normal_weighting weighting, std::size_t threads) const
+            noexcept -> void;
+
+        auto invalidate_topology() noexcept -> void;
+
+        // Drops what the positions no longer match after moving: the bounds, the normals and the normal channels read.
+        auto invalidate_positions() noexcept -> void;
+
+        // Drops the caches derived from the positions: the bounds and the normals.
+        auto reset_position_caches() noexcept -> void;
+
+        // Drops the attribute channels that no longer hold one value per vertex or per face.
+        auto drop_stale_attributes() noexcept -> void;
+
+        // Drops the nx, ny and nz vertex channels.
+        auto drop_normal_attributes() noexcept -> void;
+
+        std::vector<float> m_positions;
         std::vector<face> m_faces;
+        std::vector<attribute_channel> m_vertex_attributes;
+        std::vector<attribute_channel> m_face_attributes;
+
+        lazy<csr_adjacency> m_adjacency;
+
+        lazy<half_edge_topology> m_topology;
+
+        lazy<aabb> m_bounds;
+
+        lazy<std::vector<float>> m_face_normals;
+        lazy<std::vector<float>> m_area_vertex_normals;
+        lazy<std::vector<float>> m_angle_vertex_normals;
     };
 } // namespace tml
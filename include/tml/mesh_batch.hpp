@@ -0,0 +1,75 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/face.hpp" // tml::face
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <vector> // std::vector
+
+namespace tml
+{
+    // Consecutive vertices and faces of a mesh too large to be held at once. The positions are those of the vertices
+    // [first_vertex, first_vertex + vertex_count()) and the faces those of [first_face, first_face + faces.size()), their
+    // indices still referring to the whole mesh.
+    struct TML_EXPORT mesh_batch
+    {
+        std::size_t first_vertex{0UL};
+        std::size_t first_face{0UL};
+        std::vector<float> positions;
+        std::vector<face> faces;
+
+        [[nodiscard]] auto vertex_count() const noexcept -> std::size_t { return positions.size() / 3; }
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return positions.empty() && faces.empty(); }
+
+        auto clear() noexcept -> void;
+
+        auto invert() noexcept -> mesh_batch&;
+
+        auto scale(float factor) noexcept -> mesh_batch&;
+
+        auto noise(float coefficient) noexcept -> mesh_batch&;
+
+        // Draws the same values as mesh::noise with this seed, the counter of each coordinate being its index in the whole
+        // mesh, so that noising a stream batch by batch gives the same positions as noising the loaded mesh.
+        auto noise(float coefficient, std::uint64_t seed) noexcept -> mesh_batch&;
+    };
+
+    class mesh_reader;
+
+    // Sums the area of the faces of a stream of batches. Faces can only be measured once the positions of their corners
+    // are known. Batches holding the corners of their own faces, as read from an STL file, are measured on their own.
+    // Batches holding vertices alone, as read from a PLY file, are kept until the end of the stream, unless the reader they
+    // come from can read them again: the corners of the faces of a binary PLY file are then read back from it through a
+    // cache of cache_pages pages of page_size vertices, which bounds the memory taken. Faces whose corners have not been
+    // seen or could not be read again are skipped.
+    class TML_EXPORT area_accumulator
+    {
+    public:
+
+        static constexpr std::size_t page_size{1UL << 12U};
+
+        static constexpr std::size_t cache_pages{1UL << 8U};
+
+        area_accumulator() = default;
+
+        // Reads the corners the batches from reader lack again from it, which must outlive the accumulator.
+        explicit area_accumulator(mesh_reader& reader) noexcept : m_reader{&reader} {}
+
+        auto add(mesh_batch const& batch) -> void;
+
+        [[nodiscard]] auto area() const noexcept -> float { return static_cast<float>(m_area); }
+
+    private:
+
+        // The position of a vertex read again from the reader, or null when it could not be read.
+        [[nodiscard]] auto cached_position(std::size_t index) -> float const*;
+
+        mesh_reader* m_reader{nullptr};
+        std::vector<float> m_positions;
+        std::vector<float> m_pages;
+        std::vector<std::size_t> m_page_ids;
+        double m_area{0.0};
+    };
+} // namespace tml
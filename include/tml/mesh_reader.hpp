@@ -0,0 +1,54 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/error.hpp" // tml::parse_error
+#include "tml/mesh_batch.hpp" // tml::mesh_batch
+
+#include <cstddef> // std::size_t
+#include <filesystem> // std::filesystem::path
+#include <memory> // std::unique_ptr
+
+namespace tml
+{
+    // Reads a PLY or STL file by batches, keeping only a bounded window of the file in memory. A PLY file gives batches of
+    // at most batch_size vertices, then batches of at most batch_size faces. An STL file gives batches of at most batch_size
+    // faces along with the three corners of each of them: its vertices are not welded, since that would require every
+    // position read so far, and vertex_count() is three times face_count().
+    class TML_EXPORT mesh_reader
+    {
+    public:
+
+        static constexpr std::size_t default_batch_size{1UL << 16U};
+
+        mesh_reader() noexcept;
+
+        mesh_reader(mesh_reader&& other) noexcept;
+
+        ~mesh_reader();
+
+        auto operator=(mesh_reader&& other) noexcept -> mesh_reader&;
+
+        auto open(std::filesystem::path const& filepath, std::size_t batch_size = default_batch_size) noexcept -> parse_error;
+
+        [[nodiscard]] auto vertex_count() const noexcept -> std::size_t;
+
+        [[nodiscard]] auto face_count() const noexcept -> std::size_t;
+
+        // Replaces the content of batch by the next elements of the file, leaving it empty once all of them have been read.
+        auto read(mesh_batch& batch) noexcept -> parse_error;
+
+        // Whether read_positions can find vertices again, which only the records of a binary PLY file, all of the same
+        // size, allow.
+        [[nodiscard]] auto can_reread_positions() const noexcept -> bool;
+
+        // Reads the positions of the vertices [first_vertex, first_vertex + count) into output again, through a handle on
+        // the file of its own so that the batches read go on where they were.
+        auto read_positions(std::size_t first_vertex, std::size_t count, float* output) noexcept -> parse_error;
+
+    private:
+
+        struct impl;
+
+        std::unique_ptr<impl> m_impl;
+    };
+} // namespace tml
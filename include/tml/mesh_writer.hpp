@@ -0,0 +1,46 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/error.hpp" // tml::write_error
+#include "tml/mesh_batch.hpp" // tml::mesh_batch
+#include "tml/options.hpp" // tml::write_options
+
+#include <cstddef> // std::size_t
+#include <filesystem> // std::filesystem::path
+#include <memory> // std::unique_ptr
+
+namespace tml
+{
+    // Writes a PLY file from batches, without holding the mesh in memory. Its counts go in the header and have to be known
+    // when opening it. Batches are appended in order: the first vertex and the first face of each batch should be the
+    // numbers of vertices and faces written so far. Faces received before the last vertex are spilled to a temporary file
+    // next to the output and copied after the vertices when closing. Only PLY is supported, an STL file needing the corners
+    // of each face where it lists them.
+    class TML_EXPORT mesh_writer
+    {
+    public:
+
+        mesh_writer() noexcept;
+
+        mesh_writer(mesh_writer&& other) noexcept;
+
+        // Closes the file, ignoring errors.
+        ~mesh_writer();
+
+        auto operator=(mesh_writer&& other) noexcept -> mesh_writer&;
+
+        auto open(std::filesystem::path const& filepath, std::size_t vertex_count, std::size_t face_count,
+                  write_options const& options = {}) noexcept -> write_error;
+
+        auto write(mesh_batch const& batch) noexcept -> write_error;
+
+        // Completes the file. Fails with error_code::invalid_data when fewer vertices or faces than announced were written.
+        auto close() noexcept -> write_error;
+
+    private:
+
+        struct impl;
+
+        std::unique_ptr<impl> m_impl;
+    };
+} // namespace tml
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+
+namespace tml
+{
+    enum class encoding
+    {
+        ascii,
+        binary,
+    };
+
+    // How the normals of the faces around a vertex are weighted in its normal.
+    enum class normal_weighting
+    {
+        area,
+        angle,
+    };
+
+    struct read_options
+    {
+        std::size_t threads{1UL};
+    };
+
+    struct write_options
+    {
+        bool can_overwrite{false};
+        tml::encoding encoding{tml::encoding::ascii};
+        std::size_t threads{1UL};
+        bool store_adjacency{false};
+        // Adds the area-weighted vertex normals to PLY files as nx, ny and nz properties.
+        bool store_normals{false};
+        // Writes the attribute channels of the mesh to PLY files, each as a property of its own type.
+        bool store_attributes{true};
+    };
+} // namespace tml
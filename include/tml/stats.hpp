@@ -0,0 +1,96 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <functional> // std::function
+#include <string_view> // std::string_view
+
+namespace tml
+{
+    // Whether the library records its statistics, which only happens when it is built with tml_ENABLE_STATS. Otherwise
+    // every probe compiles to nothing, snapshots stay at zero and the sink is never called.
+#if defined(TML_ENABLE_STATS)
+    inline constexpr bool stats_enabled{true};
+#else
+    inline constexpr bool stats_enabled{false};
+#endif
+
+    // Counters accumulated by the library over the whole process. Durations are in nanoseconds and, when an operation
+    // runs on several threads, are measured on the calling thread. The hash probes are the slots visited while welding the
+    // corners of STL files, and the body times those spent decoding the vertices and the faces of PLY files.
+    enum class stat
+    {
+        files_read,
+        bytes_read,
+        vertices_read,
+        faces_read,
+        files_written,
+        bytes_written,
+        allocations,
+        allocated_bytes,
+        adjacency_entries,
+        adjacency_duplicates,
+        hash_probes,
+        decimation_live_vertices,
+        decimation_seeded_vertices,
+        read_time,
+        header_time,
+        vertex_body_time,
+        face_body_time,
+        adjacency_time,
+        write_time,
+    };
+
+    inline constexpr std::array stat_names{
+        std::string_view{"files_read"},
+        std::string_view{"bytes_read"},
+        std::string_view{"vertices_read"},
+        std::string_view{"faces_read"},
+        std::string_view{"files_written"},
+        std::string_view{"bytes_written"},
+        std::string_view{"allocations"},
+        std::string_view{"allocated_bytes"},
+        std::string_view{"adjacency_entries"},
+        std::string_view{"adjacency_duplicates"},
+        std::string_view{"hash_probes"},
+        std::string_view{"decimation_live_vertices"},
+        std::string_view{"decimation_seeded_vertices"},
+        std::string_view{"read_time"},
+        std::string_view{"header_time"},
+        std::string_view{"vertex_body_time"},
+        std::string_view{"face_body_time"},
+        std::string_view{"adjacency_time"},
+        std::string_view{"write_time"},
+    };
+
+    inline constexpr std::size_t stat_count{stat_names.size()};
+
+    [[nodiscard]] constexpr auto stat_name(stat const value) noexcept -> std::string_view
+    {
+        return stat_names[static_cast<std::size_t>(value)];
+    }
+
+    struct stats
+    {
+        std::array<std::uint64_t, stat_count> values{};
+
+        [[nodiscard]] constexpr auto operator[](stat const value) const noexcept -> std::uint64_t
+        {
+            return values[static_cast<std::size_t>(value)];
+        }
+    };
+
+    // Called with every amount added to a counter, right after it is added. Calls are serialized, but may come from any
+    // thread running a library operation.
+    using stats_sink = std::function<void(stat, std::uint64_t)>;
+
+    [[nodiscard]] TML_EXPORT auto stats_snapshot() noexcept -> stats;
+
+    TML_EXPORT auto reset_stats() noexcept -> void;
+
+    // Replaces the sink, an empty one removing it. It must not be called while another thread runs a library operation.
+    TML_EXPORT auto set_stats_sink(stats_sink sink) -> void;
+} // namespace tml
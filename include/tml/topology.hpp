@@ -0,0 +1,20 @@
+#pragma once
+
+#include "tml/edge.hpp" // tml::edge
+
+#include <cstddef> // std::size_t
+#include <vector> // std::vector
+
+namespace tml
+{
+    // Result of mesh::analyze_topology. Edges are undirected, stored with v1 < v2 and sorted. The boundary loops are traced
+    // along the boundary edges, so that two holes meeting at a vertex count apart.
+    struct topology_report
+    {
+        std::vector<edge> boundary_edges;
+        std::vector<edge> non_manifold_edges;
+        std::size_t boundary_loops{0UL};
+
+        [[nodiscard]] auto is_closed() const noexcept -> bool { return boundary_edges.empty() && non_manifold_edges.empty(); }
+    };
+} // namespace tml
@@ -2,6 +2,8 @@
 
 #include "tml/config.hpp" // TML_EXPORT
 
+#include <cstddef> // std::size_t
+#include <functional> // std::hash
 #include <vector> // std::vector
 
 namespace tml
@@ -44,6 +46,11 @@ struct std::hash<tml::vertex>
 {
     auto operator()(tml::vertex const& vertex) const noexcept -> std::size_t
     {
-        return std::hash<float>{}(vertex.x()) ^ std::hash<float>{}(vertex.y()) ^ std::hash<float>{}(vertex.z());
+        // Each coordinate is mixed before the next one is added, so that permutations of the same coordinates differ.
+        std::size_t h = std::hash<float>{}(vertex.x());
+        h = (h ^ (h >> 29U)) * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL) + std::hash<float>{}(vertex.y());
+        h = (h ^ (h >> 29U)) * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL) + std::hash<float>{}(vertex.z());
+
+        return h;
     }
 };
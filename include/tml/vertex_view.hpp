@@ -0,0 +1,139 @@
+#pragma once
+
+#include "tml/config.hpp" // TML_EXPORT
+#include "tml/index.hpp" // tml::index_type
+#include "tml/vertex.hpp" // tml::vertex
+
+#include <compare> // std::strong_ordering
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <span> // std::span
+
+namespace tml
+{
+    class mesh;
+
+    class TML_EXPORT vertex_ref
+    {
+    public:
+
+        vertex_ref(mesh const& owner, std::size_t index) noexcept;
+
+        [[nodiscard]] auto x() const noexcept -> float;
+
+        [[nodiscard]] auto y() const noexcept -> float;
+
+        [[nodiscard]] auto z() const noexcept -> float;
+
+        [[nodiscard]] auto index() const noexcept -> std::size_t;
+
+        [[nodiscard]] auto neighbors() const noexcept -> std::span<index_type const>;
+
+        operator vertex() const noexcept; // NOLINT(google-explicit-constructor)
+
+    private:
+
+        mesh const* m_mesh;
+        std::size_t m_index;
+    };
+
+    class TML_EXPORT vertex_view
+    {
+    public:
+
+        class iterator
+        {
+        public:
+
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = vertex_ref;
+            using reference = vertex_ref;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() noexcept = default;
+
+            iterator(mesh const& owner, std::size_t index) noexcept : m_mesh{&owner}, m_index{index} {}
+
+            auto operator*() const noexcept -> vertex_ref { return vertex_ref{*m_mesh, m_index}; }
+
+            auto operator[](difference_type offset) const noexcept -> vertex_ref { return *(*this + offset); }
+
+            auto operator++() noexcept -> iterator&
+            {
+                ++m_index;
+                return *this;
+            }
+
+            auto operator++(int) noexcept -> iterator
+            {
+                auto copy = *this;
+                ++m_index;
+                return copy;
+            }
+
+            auto operator--() noexcept -> iterator&
+            {
+                --m_index;
+                return *this;
+            }
+
+            auto operator--(int) noexcept -> iterator
+            {
+                auto copy = *this;
+                --m_index;
+                return copy;
+            }
+
+            auto operator+=(difference_type offset) noexcept -> iterator&
+            {
+                m_index = static_cast<std::size_t>(static_cast<difference_type>(m_index) + offset);
+                return *this;
+            }
+
+            auto operator-=(difference_type offset) noexcept -> iterator& { return *this += -offset; }
+
+            friend auto operator+(iterator it, difference_type offset) noexcept -> iterator { return it += offset; }
+
+            friend auto operator+(difference_type offset, iterator it) noexcept -> iterator { return it += offset; }
+
+            friend auto operator-(iterator it, difference_type offset) noexcept -> iterator { return it -= offset; }
+
+            friend auto operator-(iterator const& lhs, iterator const& rhs) noexcept -> difference_type
+            {
+                return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+            }
+
+            friend auto operator==(iterator const& lhs, iterator const& rhs) noexcept -> bool
+            {
+                return lhs.m_index == rhs.m_index;
+            }
+
+            friend auto operator<=>(iterator const& lhs, iterator const& rhs) noexcept -> std::strong_ordering
+            {
+                return lhs.m_index <=> rhs.m_index;
+            }
+
+        private:
+
+            mesh const* m_mesh{nullptr};
+            std::size_t m_index{0UL};
+        };
+
+        explicit vertex_view(mesh const& owner) noexcept;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+        [[nodiscard]] auto empty() const noexcept -> bool;
+
+        [[nodiscard]] auto begin() const noexcept -> iterator;
+
+        [[nodiscard]] auto end() const noexcept -> iterator;
+
+        [[nodiscard]] auto operator[](std::size_t index) const noexcept -> vertex_ref;
+
+    private:
+
+        mesh const* m_mesh;
+    };
+} // namespace tml
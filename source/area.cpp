@@ -0,0 +1,241 @@
+#include "cpu.hpp" // TML_X86_64, TML_TARGET_AVX2, tml::detail::has_avx2
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::min
+#include <array> // std::array
+#include <cmath> // std::sqrt, std::abs
+#include <cstdint> // std::int32_t
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <vector> // std::vector
+
+#if TML_X86_64
+#include <immintrin.h> // __m128, __m256, __m256d, __m256i and their intrinsics
+#endif
+
+using tml::face;
+using tml::mesh;
+
+namespace
+{
+    // Faces are summed by fixed blocks whatever the thread count, so that the total does not depend on it.
+    constexpr std::size_t area_block_size{4096UL};
+
+    // A kernel computes the area of each face of a range, writes them to areas when it is not null and returns their sum.
+    // Every kernel evaluates 0.5 * |(v2 - v1) x (v3 - v1)| with the same float operations, so they give identical areas.
+    using area_kernel = auto (*)(float const* positions, std::span<face const> faces, float* areas) noexcept -> double;
+
+    [[nodiscard]] auto area_scalar(float const* positions, std::span<face const> const faces, float* areas) noexcept -> double
+    {
+        double sum{0.0};
+
+        for (auto const& face : faces)
+        {
+            auto const [index_v1, index_v2, index_v3] = face.indices();
+            float const* const v1 = positions + std::size_t{index_v1} * 3;
+            float const* const v2 = positions + std::size_t{index_v2} * 3;
+            float const* const v3 = positions + std::size_t{index_v3} * 3;
+            float const e1x = v2[0] - v1[0];
+            float const e1y = v2[1] - v1[1];
+            float const e1z = v2[2] - v1[2];
+            float const e2x = v3[0] - v1[0];
+            float const e2y = v3[1] - v1[1];
+            float const e2z = v3[2] - v1[2];
+            float const cx = e1y * e2z - e1z * e2y;
+            float const cy = e1z * e2x - e1x * e2z;
+            float const cz = e1x * e2y - e1y * e2x;
+            float const area = 0.5F * std::sqrt(cx * cx + cy * cy + cz * cz);
+
+            if (areas != nullptr)
+            {
+                *areas++ = area;
+            }
+
+            sum += static_cast<double>(area);
+        }
+
+        return sum;
+    }
+
+#if TML_X86_64
+    // SSE2 is part of the x86-64 baseline: corners are loaded lane by lane and the arithmetic runs four faces at a time.
+    [[nodiscard]] auto area_sse(float const* positions, std::span<face const> const faces, float* areas) noexcept -> double
+    {
+        static constexpr std::size_t lanes{4UL};
+        std::size_t const vector_count = faces.size() - faces.size() % lanes;
+        __m128d sum_low = _mm_setzero_pd();
+        __m128d sum_high = _mm_setzero_pd();
+        std::array<std::array<float const*, lanes>, 3UL> corners{};
+
+        for (std::size_t first{0UL}; first < vector_count; first += lanes)
+        {
+            for (std::size_t lane{0UL}; lane < lanes; ++lane)
+            {
+                auto const& indices = faces[first + lane].indices();
+                corners[0][lane] = positions + std::size_t{indices[0]} * 3;
+                corners[1][lane] = positions + std::size_t{indices[1]} * 3;
+                corners[2][lane] = positions + std::size_t{indices[2]} * 3;
+            }
+
+            auto const load = [&corners](std::size_t const corner, std::size_t const axis) -> __m128 {
+                auto const& lane = corners[corner];
+                return _mm_setr_ps(lane[0][axis], lane[1][axis], lane[2][axis], lane[3][axis]);
+            };
+
+            __m128 const x1 = load(0UL, 0UL);
+            __m128 const y1 = load(0UL, 1UL);
+            __m128 const z1 = load(0UL, 2UL);
+            __m128 const e1x = _mm_sub_ps(load(1UL, 0UL), x1);
+            __m128 const e1y = _mm_sub_ps(load(1UL, 1UL), y1);
+            __m128 const e1z = _mm_sub_ps(load(1UL, 2UL), z1);
+            __m128 const e2x = _mm_sub_ps(load(2UL, 0UL), x1);
+            __m128 const e2y = _mm_sub_ps(load(2UL, 1UL), y1);
+            __m128 const e2z = _mm_sub_ps(load(2UL, 2UL), z1);
+            __m128 const cx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y));
+            __m128 const cy = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z));
+            __m128 const cz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x));
+            __m128 const squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+            __m128 const area = _mm_mul_ps(_mm_set1_ps(0.5F), _mm_sqrt_ps(squared));
+
+            if (areas != nullptr)
+            {
+                _mm_storeu_ps(areas + first, area);
+            }
+
+            sum_low = _mm_add_pd(sum_low, _mm_cvtps_pd(area));
+            sum_high = _mm_add_pd(sum_high, _mm_cvtps_pd(_mm_movehl_ps(area, area)));
+        }
+
+        std::array<double, 2UL> low{};
+        std::array<double, 2UL> high{};
+        _mm_storeu_pd(low.data(), sum_low);
+        _mm_storeu_pd(high.data(), sum_high);
+
+        return low[0] + low[1] + high[0] + high[1] +
+               area_scalar(positions, faces.subspan(vector_count), areas != nullptr ? areas + vector_count : nullptr);
+    }
+
+    [[nodiscard]] TML_TARGET_AVX2 inline auto gather(float const* positions, __m256i const offsets, int const axis) noexcept
+        -> __m256
+    {
+        return _mm256_i32gather_ps(positions + axis, offsets, sizeof(float));
+    }
+
+    // AVX2 gathers the corners of eight faces at once from their 32 bits coordinate offsets.
+    [[nodiscard]] TML_TARGET_AVX2 auto area_avx2(float const* positions, std::span<face const> const faces, float* areas) noexcept
+        -> double
+    {
+        static constexpr std::size_t lanes{8UL};
+        std::size_t const vector_count = faces.size() - faces.size() % lanes;
+        __m256d sum_low = _mm256_setzero_pd();
+        __m256d sum_high = _mm256_setzero_pd();
+        std::array<std::array<std::int32_t, lanes>, 3UL> offsets{};
+
+        for (std::size_t first{0UL}; first < vector_count; first += lanes)
+        {
+            for (std::size_t lane{0UL}; lane < lanes; ++lane)
+            {
+                auto const& indices = faces[first + lane].indices();
+                offsets[0][lane] = static_cast<std::int32_t>(indices[0] * 3);
+                offsets[1][lane] = static_cast<std::int32_t>(indices[1] * 3);
+                offsets[2][lane] = static_cast<std::int32_t>(indices[2] * 3);
+            }
+
+            // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+            __m256i const o1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(offsets[0].data()));
+            __m256i const o2 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(offsets[1].data()));
+            __m256i const o3 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(offsets[2].data()));
+            // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+            __m256 const x1 = gather(positions, o1, 0);
+            __m256 const y1 = gather(positions, o1, 1);
+            __m256 const z1 = gather(positions, o1, 2);
+            __m256 const e1x = _mm256_sub_ps(gather(positions, o2, 0), x1);
+            __m256 const e1y = _mm256_sub_ps(gather(positions, o2, 1), y1);
+            __m256 const e1z = _mm256_sub_ps(gather(positions, o2, 2), z1);
+            __m256 const e2x = _mm256_sub_ps(gather(positions, o3, 0), x1);
+            __m256 const e2y = _mm256_sub_ps(gather(positions, o3, 1), y1);
+            __m256 const e2z = _mm256_sub_ps(gather(positions, o3, 2), z1);
+            __m256 const cx = _mm256_sub_ps(_mm256_mul_ps(e1y, e2z), _mm256_mul_ps(e1z, e2y));
+            __m256 const cy = _mm256_sub_ps(_mm256_mul_ps(e1z, e2x), _mm256_mul_ps(e1x, e2z));
+            __m256 const cz = _mm256_sub_ps(_mm256_mul_ps(e1x, e2y), _mm256_mul_ps(e1y, e2x));
+            __m256 const squared =
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, cx), _mm256_mul_ps(cy, cy)), _mm256_mul_ps(cz, cz));
+            __m256 const area = _mm256_mul_ps(_mm256_set1_ps(0.5F), _mm256_sqrt_ps(squared));
+
+            if (areas != nullptr)
+            {
+                _mm256_storeu_ps(areas + first, area);
+            }
+
+            sum_low = _mm256_add_pd(sum_low, _mm256_cvtps_pd(_mm256_castps256_ps128(area)));
+            sum_high = _mm256_add_pd(sum_high, _mm256_cvtps_pd(_mm256_extractf128_ps(area, 1)));
+        }
+
+        std::array<double, 4UL> lanes_sum{};
+        _mm256_storeu_pd(lanes_sum.data(), _mm256_add_pd(sum_low, sum_high));
+
+        return lanes_sum[0] + lanes_sum[1] + lanes_sum[2] + lanes_sum[3] +
+               area_scalar(positions, faces.subspan(vector_count), areas != nullptr ? areas + vector_count : nullptr);
+    }
+#endif
+
+    [[nodiscard]] auto select_area_kernel(std::size_t const coordinate_count) noexcept -> area_kernel
+    {
+#if TML_X86_64
+        // The gathers take 32 bits offsets.
+        if (tml::detail::has_avx2() && coordinate_count <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+        {
+            return area_avx2;
+        }
+
+        return area_sse;
+#else
+        static_cast<void>(coordinate_count);
+
+        return area_scalar;
+#endif
+    }
+
+    // Computes the areas by blocks over several threads and returns their compensated (Neumaier) sum.
+    [[nodiscard]] auto sum_areas(std::span<float const> const positions, std::span<face const> const faces, float* areas,
+                                 std::size_t const threads) -> double
+    {
+        area_kernel const kernel = select_area_kernel(positions.size());
+        std::size_t const block_count = (faces.size() + area_block_size - 1UL) / area_block_size;
+        std::vector<double> partials(block_count, 0.0);
+
+        tml::detail::parallel_for(block_count, threads, 1UL, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t block{begin}; block < end; ++block)
+            {
+                std::size_t const first = block * area_block_size;
+                std::size_t const count = std::min(area_block_size, faces.size() - first);
+                partials[block] =
+                    kernel(positions.data(), faces.subspan(first, count), areas != nullptr ? areas + first : nullptr);
+            }
+        });
+
+        double sum{0.0};
+        double compensation{0.0};
+
+        for (double const partial : partials)
+        {
+            double const total = sum + partial;
+            compensation += std::abs(sum) >= std::abs(partial) ? (sum - total) + partial : (partial - total) + sum;
+            sum = total;
+        }
+
+        return sum + compensation;
+    }
+} // namespace
+
+auto mesh::area(std::size_t const threads) const noexcept -> float
+{
+    return static_cast<float>(sum_areas(m_positions, m_faces, nullptr, detail::thread_count(threads)));
+}
+
+auto mesh::area_per_face(std::span<float> const areas, std::size_t const threads) const noexcept -> void
+{
+    auto const faces = std::span{m_faces}.first(std::min(areas.size(), m_faces.size()));
+    static_cast<void>(sum_areas(m_positions, faces, areas.data(), detail::thread_count(threads)));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <charconv> // std::from_chars
+#include <string_view> // std::string_view
+#include <system_error> // std::errc
+
+namespace tml::detail
+{
+    [[nodiscard]] constexpr auto is_space(char const c) noexcept -> bool
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    [[nodiscard]] constexpr auto skip_spaces(char const* cursor, char const* end) noexcept -> char const*
+    {
+        while (cursor != end && is_space(*cursor))
+        {
+            ++cursor;
+        }
+
+        return cursor;
+    }
+
+    // Parses the next whitespace-separated number in [cursor, end) and advances cursor past it.
+    template <typename T>
+    [[nodiscard]] auto parse_number(char const*& cursor, char const* end, T& value) noexcept -> bool
+    {
+        cursor = skip_spaces(cursor, end);
+        auto const [ptr, ec] = std::from_chars(cursor, end, value);
+
+        if (ec != std::errc{}) [[unlikely]]
+        {
+            return false;
+        }
+
+        cursor = ptr;
+
+        return true;
+    }
+
+    // Pops the next line from content, without its line terminator.
+    [[nodiscard]] constexpr auto next_line(std::string_view& content) noexcept -> std::string_view
+    {
+        auto const position = content.find('\n');
+        auto line = content.substr(0UL, position);
+        content.remove_prefix(position == std::string_view::npos ? content.size() : position + 1UL);
+
+        if (line.ends_with('\r'))
+        {
+            line.remove_suffix(1UL);
+        }
+
+        return line;
+    }
+
+    // Pops the next whitespace-separated token from line.
+    [[nodiscard]] constexpr auto next_token(std::string_view& line) noexcept -> std::string_view
+    {
+        auto const* const begin = skip_spaces(line.data(), line.data() + line.size());
+        line.remove_prefix(static_cast<std::size_t>(begin - line.data()));
+        auto const position = line.find_first_of(" \t\r\n\v\f");
+        auto const token = line.substr(0UL, position);
+        line.remove_prefix(token.size());
+
+        return token;
+    }
+} // namespace tml::detail
@@ -0,0 +1,133 @@
+#include "ply_format.hpp" // tml::detail::is_normal_channel
+#include "tml/attribute.hpp"
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::ranges::find
+#include <type_traits> // std::remove_reference_t
+#include <utility> // std::move
+#include <variant> // std::visit, std::get
+#include <vector> // std::erase_if
+
+using tml::attribute_channel;
+using tml::attribute_type;
+
+attribute_channel::attribute_channel(std::string name, attribute_type const type, std::size_t const size)
+    : m_name{std::move(name)}
+{
+    // The alternatives of the variant follow the order of the enumeration.
+    switch (type)
+    {
+    case attribute_type::int8:
+        m_values.emplace<0>(size);
+        break;
+    case attribute_type::uint8:
+        m_values.emplace<1>(size);
+        break;
+    case attribute_type::int16:
+        m_values.emplace<2>(size);
+        break;
+    case attribute_type::uint16:
+        m_values.emplace<3>(size);
+        break;
+    case attribute_type::int32:
+        m_values.emplace<4>(size);
+        break;
+    case attribute_type::uint32:
+        m_values.emplace<5>(size);
+        break;
+    case attribute_type::float32:
+        m_values.emplace<6>(size);
+        break;
+    case attribute_type::float64:
+        m_values.emplace<7>(size);
+        break;
+    }
+}
+
+auto attribute_channel::name() const noexcept -> std::string const&
+{
+    return m_name;
+}
+
+auto attribute_channel::type() const noexcept -> attribute_type
+{
+    return static_cast<attribute_type>(m_values.index());
+}
+
+auto attribute_channel::size() const noexcept -> std::size_t
+{
+    return std::visit([](auto const& values) -> std::size_t { return values.size(); }, m_values);
+}
+
+auto attribute_channel::value(std::size_t const index) const noexcept -> double
+{
+    return std::visit([index](auto const& values) -> double { return static_cast<double>(values[index]); }, m_values);
+}
+
+auto attribute_channel::data() noexcept -> void*
+{
+    return std::visit([](auto& values) -> void* { return values.data(); }, m_values);
+}
+
+auto attribute_channel::data() const noexcept -> void const*
+{
+    return std::visit([](auto const& values) -> void const* { return values.data(); }, m_values);
+}
+
+auto attribute_channel::element_size() const noexcept -> std::size_t
+{
+    return std::visit([](auto const& values) -> std::size_t { return sizeof(values[0]); }, m_values);
+}
+
+auto attribute_channel::resize(std::size_t const size) -> void
+{
+    std::visit([size](auto& values) -> void { values.resize(size); }, m_values);
+}
+
+auto attribute_channel::append(attribute_channel const& other) -> bool
+{
+    if (other.m_values.index() != m_values.index())
+    {
+        return false;
+    }
+
+    std::visit(
+        [&other](auto& values) -> void {
+            auto const& appended = std::get<std::remove_reference_t<decltype(values)>>(other.m_values);
+            values.insert(values.end(), appended.begin(), appended.end());
+        },
+        m_values);
+
+    return true;
+}
+
+auto tml::mesh::vertex_attributes() const noexcept -> std::span<attribute_channel const> { return m_vertex_attributes; }
+
+auto tml::mesh::face_attributes() const noexcept -> std::span<attribute_channel const> { return m_face_attributes; }
+
+auto tml::mesh::vertex_attribute(std::string_view const name) const noexcept -> attribute_channel const*
+{
+    auto const channel = std::ranges::find(m_vertex_attributes, name, &attribute_channel::name);
+
+    return channel == m_vertex_attributes.end() ? nullptr : &*channel;
+}
+
+auto tml::mesh::face_attribute(std::string_view const name) const noexcept -> attribute_channel const*
+{
+    auto const channel = std::ranges::find(m_face_attributes, name, &attribute_channel::name);
+
+    return channel == m_face_attributes.end() ? nullptr : &*channel;
+}
+
+auto tml::mesh::drop_stale_attributes() noexcept -> void
+{
+    std::size_t const vertex_count = m_positions.size() / 3;
+    std::size_t const face_count = m_faces.size();
+    std::erase_if(m_vertex_attributes, [vertex_count](auto const& channel) -> bool { return channel.size() != vertex_count; });
+    std::erase_if(m_face_attributes, [face_count](auto const& channel) -> bool { return channel.size() != face_count; });
+}
+
+auto tml::mesh::drop_normal_attributes() noexcept -> void
+{
+    std::erase_if(m_vertex_attributes, [](auto const& channel) -> bool { return detail::is_normal_channel(channel.name()); });
+}
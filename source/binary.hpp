@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm> // std::ranges::reverse
+#include <array> // std::array
+#include <bit> // std::bit_cast, std::endian
+#include <cstring> // std::memcpy
+
+namespace tml::detail
+{
+    // Reads a T stored at source, reversing its bytes first when swap is set.
+    template <typename T>
+    [[nodiscard]] auto load(char const* source, bool const swap) noexcept -> T
+    {
+        std::array<char, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), source, sizeof(T));
+
+        if (swap)
+        {
+            std::ranges::reverse(bytes);
+        }
+
+        return std::bit_cast<T>(bytes);
+    }
+
+    // Writes value at destination in little-endian byte order and returns the position past it.
+    template <typename T>
+    auto store_le(char* destination, T const value) noexcept -> char*
+    {
+        auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            std::ranges::reverse(bytes);
+        }
+
+        std::memcpy(destination, bytes.data(), sizeof(T));
+
+        return destination + sizeof(T);
+    }
+} // namespace tml::detail
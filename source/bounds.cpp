@@ -0,0 +1,121 @@
+#include "cpu.hpp" // TML_X86_64
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::min
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <vector> // std::vector
+
+#if TML_X86_64
+#include <immintrin.h> // __m128 and its intrinsics
+#endif
+
+using tml::aabb;
+using tml::mesh;
+
+namespace
+{
+    // Vertices are reduced by blocks, so that meshes of less than two blocks are scanned on the calling thread only.
+    constexpr std::size_t bounds_block_size{1UL << 16U};
+
+    [[nodiscard]] auto bounds_scalar(float const* positions, std::size_t const count) noexcept -> aabb
+    {
+        aabb box;
+
+        for (float const* position = positions; position != positions + count * 3; position += 3)
+        {
+            box.extend(std::array{position[0], position[1], position[2]});
+        }
+
+        return box;
+    }
+
+#if TML_X86_64
+    // Twelve floats hold four whole vertices, so each lane of three consecutive registers always sees the same axis:
+    // (x y z x), (y z x y) and (z x y z). The packed positions are reduced as they are, and the lanes are folded per axis at
+    // the end. The new values are passed first to the min and max instructions, which then skip NaN coordinates as
+    // aabb::extend does.
+    [[nodiscard]] auto bounds_sse(float const* positions, std::size_t const count) noexcept -> aabb
+    {
+        static constexpr std::size_t lanes{4UL};
+        std::size_t const vector_count = count - count % lanes;
+        aabb const empty;
+        __m128 low0 = _mm_set1_ps(empty.min[0]);
+        __m128 low1 = low0;
+        __m128 low2 = low0;
+        __m128 high0 = _mm_set1_ps(empty.max[0]);
+        __m128 high1 = high0;
+        __m128 high2 = high0;
+
+        for (float const* position = positions; position != positions + vector_count * 3; position += lanes * 3)
+        {
+            __m128 const a = _mm_loadu_ps(position);
+            __m128 const b = _mm_loadu_ps(position + 4);
+            __m128 const c = _mm_loadu_ps(position + 8);
+            low0 = _mm_min_ps(a, low0);
+            low1 = _mm_min_ps(b, low1);
+            low2 = _mm_min_ps(c, low2);
+            high0 = _mm_max_ps(a, high0);
+            high1 = _mm_max_ps(b, high1);
+            high2 = _mm_max_ps(c, high2);
+        }
+
+        std::array<float, lanes * 3> min_lanes{};
+        std::array<float, lanes * 3> max_lanes{};
+        _mm_storeu_ps(min_lanes.data(), low0);
+        _mm_storeu_ps(min_lanes.data() + 4, low1);
+        _mm_storeu_ps(min_lanes.data() + 8, low2);
+        _mm_storeu_ps(max_lanes.data(), high0);
+        _mm_storeu_ps(max_lanes.data() + 4, high1);
+        _mm_storeu_ps(max_lanes.data() + 8, high2);
+
+        // The lanes now hold the bounds of four vertices, folded with those of the remaining ones.
+        aabb box = bounds_scalar(positions + vector_count * 3, count - vector_count);
+
+        for (std::size_t vertex{0UL}; vertex < lanes; ++vertex)
+        {
+            box.extend(aabb{.min = {min_lanes[vertex * 3], min_lanes[vertex * 3 + 1], min_lanes[vertex * 3 + 2]},
+                            .max = {max_lanes[vertex * 3], max_lanes[vertex * 3 + 1], max_lanes[vertex * 3 + 2]}});
+        }
+
+        return box;
+    }
+#endif
+
+    [[nodiscard]] auto bounds_block(float const* positions, std::size_t const count) noexcept -> aabb
+    {
+#if TML_X86_64
+        return bounds_sse(positions, count);
+#else
+        return bounds_scalar(positions, count);
+#endif
+    }
+} // namespace
+
+auto mesh::bounds(std::size_t const threads) const noexcept -> aabb
+{
+    return m_bounds.get([this, threads](aabb& bounds) -> void { compute_bounds(bounds, threads); });
+}
+
+auto mesh::compute_bounds(aabb& bounds, std::size_t const threads) const noexcept -> void
+{
+    std::size_t const vertex_count = m_positions.size() / 3;
+    std::size_t const block_count = (vertex_count + bounds_block_size - 1UL) / bounds_block_size;
+    std::vector<aabb> partials(block_count);
+
+    detail::parallel_for(block_count, detail::thread_count(threads), 2UL, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t block{begin}; block < end; ++block)
+        {
+            std::size_t const first = block * bounds_block_size;
+            partials[block] = bounds_block(m_positions.data() + first * 3, std::min(bounds_block_size, vertex_count - first));
+        }
+    });
+
+    bounds = aabb{};
+
+    for (auto const& partial : partials)
+    {
+        bounds.extend(partial);
+    }
+}
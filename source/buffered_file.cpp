@@ -0,0 +1,124 @@
+#include "buffered_file.hpp"
+
+#include "ascii.hpp" // tml::detail::next_line
+
+#include <algorithm> // std::copy, std::max, std::min
+#include <ios> // std::ios_base, std::streamsize
+#include <system_error> // std::error_code
+
+using tml::detail::buffered_file;
+
+auto buffered_file::open(std::filesystem::path const& filepath, std::size_t const capacity) noexcept -> error_code
+{
+    std::error_code ec;
+    auto const size = std::filesystem::file_size(filepath, ec);
+
+    if (ec) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath, ec) ? error_code::unknown_io_error : error_code::file_not_found;
+    }
+
+    m_file = std::ifstream{filepath, std::ios_base::binary};
+
+    if (!m_file) [[unlikely]]
+    {
+        return error_code::unknown_io_error;
+    }
+
+    m_buffer.resize(std::max(capacity, 1UL));
+    m_begin = 0UL;
+    m_end = 0UL;
+    m_read = 0UL;
+    m_size = static_cast<std::size_t>(size);
+
+    return error_code::none;
+}
+
+auto buffered_file::lines() const noexcept -> std::string_view
+{
+    auto const content = view();
+
+    if (at_end())
+    {
+        return content;
+    }
+
+    auto const position = content.rfind('\n');
+
+    return position == std::string_view::npos ? std::string_view{} : content.substr(0UL, position + 1UL);
+}
+
+auto buffered_file::fill(std::size_t const minimum) noexcept -> bool
+{
+    if (m_begin != 0UL)
+    {
+        std::copy(m_buffer.begin() + static_cast<std::ptrdiff_t>(m_begin), m_buffer.begin() + static_cast<std::ptrdiff_t>(m_end),
+                  m_buffer.begin());
+        m_end -= m_begin;
+        m_begin = 0UL;
+    }
+
+    if (minimum > m_buffer.size())
+    {
+        m_buffer.resize(minimum);
+    }
+
+    std::size_t const wanted = std::min(m_buffer.size() - m_end, m_size - m_read);
+
+    if (wanted == 0UL)
+    {
+        return false;
+    }
+
+    m_file.read(m_buffer.data() + m_end, static_cast<std::streamsize>(wanted));
+    auto const count = static_cast<std::size_t>(m_file.gcount());
+    m_end += count;
+    m_read += count;
+
+    // The file got shorter since it was opened or could not be read further, what was read is all there is.
+    if (count < wanted) [[unlikely]]
+    {
+        m_size = m_read;
+    }
+
+    return count != 0UL;
+}
+
+auto buffered_file::next_line(std::string_view& line) noexcept -> bool
+{
+    while (true)
+    {
+        auto content = view();
+
+        if (content.find('\n') != std::string_view::npos || at_end())
+        {
+            if (content.empty())
+            {
+                return false;
+            }
+
+            line = tml::detail::next_line(content);
+            consume(view().size() - content.size());
+
+            return true;
+        }
+
+        if (content.size() >= max_record_size) [[unlikely]]
+        {
+            return false;
+        }
+
+        fill(m_end - m_begin == m_buffer.size() ? m_buffer.size() * 2UL : 0UL);
+    }
+}
+
+auto buffered_file::rewind() noexcept -> error_code
+{
+    m_file.clear();
+    m_file.seekg(0);
+    m_begin = 0UL;
+    m_end = 0UL;
+    m_read = 0UL;
+
+    return m_file ? error_code::none : error_code::unknown_io_error;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "tml/error.hpp" // tml::error_code
+
+#include <cstddef> // std::size_t
+#include <filesystem> // std::filesystem::path
+#include <fstream> // std::ifstream
+#include <string_view> // std::string_view
+#include <vector> // std::vector
+
+namespace tml::detail
+{
+    // Sequential reader keeping a window of a file in memory, for files too large to be mapped or loaded at once. The
+    // unconsumed part of the window is moved back to the front of the buffer before each read, so that the buffer only
+    // grows when a caller asks for more than it holds.
+    class buffered_file
+    {
+    public:
+
+        static constexpr std::size_t default_capacity{1UL << 22U};
+
+        // Above this size, a header, a record or a line that does not fit in the buffer is considered invalid rather than
+        // making the buffer grow further.
+        static constexpr std::size_t max_record_size{1UL << 24U};
+
+        [[nodiscard]] auto open(std::filesystem::path const& filepath, std::size_t capacity = default_capacity) noexcept
+            -> error_code;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+        // Bytes read from the file and not consumed yet.
+        [[nodiscard]] auto view() const noexcept -> std::string_view
+        {
+            return {m_buffer.data() + m_begin, m_end - m_begin};
+        }
+
+        // The view up to its last line feed included, or the whole view once the file has been read to its end.
+        [[nodiscard]] auto lines() const noexcept -> std::string_view;
+
+        // Whether every byte of the file has been read into the buffer.
+        [[nodiscard]] auto at_end() const noexcept -> bool { return m_read == m_size; }
+
+        [[nodiscard]] auto exhausted() const noexcept -> bool { return at_end() && m_begin == m_end; }
+
+        auto consume(std::size_t count) noexcept -> void { m_begin += count; }
+
+        // Reads as much of the file as fits after the unconsumed bytes, growing the buffer first when minimum exceeds its
+        // size. Returns false when no byte could be added to the view.
+        auto fill(std::size_t minimum = 0UL) noexcept -> bool;
+
+        // Pops the next line, without its line terminator, reading more of the file when needed. Returns false at the end,
+        // or before it when the line is longer than max_record_size, which leaves the file not exhausted.
+        [[nodiscard]] auto next_line(std::string_view& line) noexcept -> bool;
+
+        // Goes back to the beginning of the file and empties the buffer.
+        [[nodiscard]] auto rewind() noexcept -> error_code;
+
+    private:
+
+        std::ifstream m_file;
+        std::vector<char> m_buffer;
+        std::size_t m_begin{0UL};
+        std::size_t m_end{0UL};
+        std::size_t m_read{0UL};
+        std::size_t m_size{0UL};
+    };
+} // namespace tml::detail
@@ -0,0 +1,800 @@
+#include "cpu.hpp" // TML_X86_64
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/bvh.hpp"
+
+#include <algorithm> // std::min, std::max, std::partition, std::nth_element, std::sort
+#include <limits> // std::numeric_limits
+#include <numeric> // std::iota
+
+#if TML_X86_64
+#include <emmintrin.h> // SSE2 intrinsics
+#endif
+
+using tml::aabb;
+using tml::bvh;
+using tml::face;
+using tml::ray;
+using tml::ray_hit;
+using tml::surface_point;
+
+static_assert(sizeof(bvh::node) == 32UL);
+
+namespace
+{
+    constexpr std::size_t bin_count{16UL};
+    constexpr std::size_t max_leaf_size{4UL};
+    constexpr std::size_t max_sah_depth{64UL};
+    constexpr std::size_t stack_size{128UL};
+    constexpr std::size_t grain{1UL << 14U};
+    constexpr std::size_t max_face_count{std::size_t{1UL} << 31U};
+    constexpr float infinity{std::numeric_limits<float>::infinity()};
+
+    using point = std::array<float, 3>;
+
+    [[nodiscard]] constexpr auto subtract(point const& lhs, point const& rhs) noexcept -> point
+    {
+        return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+    }
+
+    [[nodiscard]] constexpr auto dot(point const& lhs, point const& rhs) noexcept -> float
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+    }
+
+    [[nodiscard]] constexpr auto along(point const& origin, point const& direction, float const t) noexcept -> point
+    {
+        return {origin[0] + t * direction[0], origin[1] + t * direction[1], origin[2] + t * direction[2]};
+    }
+
+    [[nodiscard]] constexpr auto squared_distance(point const& lhs, point const& rhs) noexcept -> float
+    {
+        point const difference = subtract(lhs, rhs);
+        return dot(difference, difference);
+    }
+
+    [[nodiscard]] constexpr auto closest_on_segment(point const& p, point const& a, point const& b) noexcept -> point
+    {
+        point const ab = subtract(b, a);
+        float const length = dot(ab, ab);
+
+        return length > 0.0F ? along(a, ab, std::min(1.0F, std::max(0.0F, dot(subtract(p, a), ab) / length))) : a;
+    }
+
+    // Closest point of triangle abc to p, found from the Voronoi region of p (Ericson, Real-Time Collision Detection 5.1.5).
+    [[nodiscard]] constexpr auto closest_on_triangle(point const& p, point const& a, point const& b, point const& c) noexcept
+        -> point
+    {
+        point const ab = subtract(b, a);
+        point const ac = subtract(c, a);
+        point const ap = subtract(p, a);
+        float const d1 = dot(ab, ap);
+        float const d2 = dot(ac, ap);
+
+        if (d1 <= 0.0F && d2 <= 0.0F)
+        {
+            return a;
+        }
+
+        point const bp = subtract(p, b);
+        float const d3 = dot(ab, bp);
+        float const d4 = dot(ac, bp);
+
+        if (d3 >= 0.0F && d4 <= d3)
+        {
+            return b;
+        }
+
+        float const vc = d1 * d4 - d3 * d2;
+
+        if (vc <= 0.0F && d1 >= 0.0F && d3 <= 0.0F)
+        {
+            return along(a, ab, d1 / (d1 - d3));
+        }
+
+        point const cp = subtract(p, c);
+        float const d5 = dot(ab, cp);
+        float const d6 = dot(ac, cp);
+
+        if (d6 >= 0.0F && d5 <= d6)
+        {
+            return c;
+        }
+
+        float const vb = d5 * d2 - d1 * d6;
+
+        if (vb <= 0.0F && d2 >= 0.0F && d6 <= 0.0F)
+        {
+            return along(a, ac, d2 / (d2 - d6));
+        }
+
+        float const va = d3 * d6 - d5 * d4;
+
+        if (va <= 0.0F && d4 - d3 >= 0.0F && d5 - d6 >= 0.0F)
+        {
+            return along(b, subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        float const sum = va + vb + vc;
+
+        // A degenerate triangle has no interior, its closest point lies on one of its sides.
+        if (!(sum > 0.0F)) [[unlikely]]
+        {
+            point best = closest_on_segment(p, a, b);
+
+            for (point const& candidate : {closest_on_segment(p, b, c), closest_on_segment(p, c, a)})
+            {
+                best = squared_distance(p, candidate) < squared_distance(p, best) ? candidate : best;
+            }
+
+            return best;
+        }
+
+        return along(along(a, ab, vb / sum), ac, vc / sum);
+    }
+
+    [[nodiscard]] constexpr auto squared_distance(point const& p, bvh::node const& node) noexcept -> float
+    {
+        float distance{0.0F};
+
+        for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+        {
+            float const outside = std::max({node.min[axis] - p[axis], 0.0F, p[axis] - node.max[axis]});
+            distance += outside * outside;
+        }
+
+        return distance;
+    }
+
+    [[nodiscard]] constexpr auto bounds_of(bvh::node const& node) noexcept -> aabb
+    {
+        return aabb{.min = node.min, .max = node.max};
+    }
+
+    // Moller-Trumbore test of the ray against the faces [first, first + count) of a leaf, keeping the nearest hit closer than
+    // hit.distance. hit.face receives the slot of the face in leaf order.
+#if TML_X86_64
+    auto intersect_leaf(float const* const corners, std::size_t const stride, std::size_t const first, std::size_t const count,
+                        ray const& query, ray_hit& hit) noexcept -> void
+    {
+        auto const load = [&](std::size_t const row) -> __m128 { return _mm_loadu_ps(corners + row * stride + first); };
+        __m128 const v0x = load(0UL);
+        __m128 const v0y = load(1UL);
+        __m128 const v0z = load(2UL);
+        __m128 const e1x = _mm_sub_ps(load(3UL), v0x);
+        __m128 const e1y = _mm_sub_ps(load(4UL), v0y);
+        __m128 const e1z = _mm_sub_ps(load(5UL), v0z);
+        __m128 const e2x = _mm_sub_ps(load(6UL), v0x);
+        __m128 const e2y = _mm_sub_ps(load(7UL), v0y);
+        __m128 const e2z = _mm_sub_ps(load(8UL), v0z);
+        __m128 const dx = _mm_set1_ps(query.direction[0]);
+        __m128 const dy = _mm_set1_ps(query.direction[1]);
+        __m128 const dz = _mm_set1_ps(query.direction[2]);
+
+        __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 const det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 const inverse = _mm_div_ps(_mm_set1_ps(1.0F), det);
+
+        __m128 const sx = _mm_sub_ps(_mm_set1_ps(query.origin[0]), v0x);
+        __m128 const sy = _mm_sub_ps(_mm_set1_ps(query.origin[1]), v0y);
+        __m128 const sz = _mm_sub_ps(_mm_set1_ps(query.origin[2]), v0z);
+        __m128 const u =
+            _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inverse);
+
+        __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 const v =
+            _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverse);
+        __m128 const t =
+            _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverse);
+
+        __m128 const zero = _mm_setzero_ps();
+        __m128i const used = _mm_cmplt_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(static_cast<int>(count)));
+        __m128 const lanes = _mm_castsi128_ps(used);
+        __m128 mask = _mm_and_ps(lanes, _mm_cmpneq_ps(det, zero));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0F)));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(t, _mm_set1_ps(query.t_min)));
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(hit.distance)));
+        int const bits = _mm_movemask_ps(mask);
+
+        if (bits == 0)
+        {
+            return;
+        }
+
+        alignas(16) std::array<float, 4> distances{};
+        alignas(16) std::array<float, 4> us{};
+        alignas(16) std::array<float, 4> vs{};
+        _mm_store_ps(distances.data(), t);
+        _mm_store_ps(us.data(), u);
+        _mm_store_ps(vs.data(), v);
+
+        for (std::size_t lane{0UL}; lane < 4UL; ++lane)
+        {
+            if ((bits & (1 << lane)) != 0 && distances[lane] < hit.distance)
+            {
+                hit = ray_hit{.face = first + lane, .distance = distances[lane], .u = us[lane], .v = vs[lane]};
+            }
+        }
+    }
+#else
+    auto intersect_leaf(float const* const corners, std::size_t const stride, std::size_t const first, std::size_t const count,
+                        ray const& query, ray_hit& hit) noexcept -> void
+    {
+        for (std::size_t slot{first}; slot < first + count; ++slot)
+        {
+            auto const corner = [&](std::size_t const index) -> point {
+                return {corners[index * 3 * stride + slot], corners[(index * 3 + 1) * stride + slot],
+                        corners[(index * 3 + 2) * stride + slot]};
+            };
+            point const v0 = corner(0UL);
+            point const e1 = subtract(corner(1UL), v0);
+            point const e2 = subtract(corner(2UL), v0);
+            point const& d = query.direction;
+            point const p{d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0]};
+            float const det = dot(e1, p);
+            float const inverse = 1.0F / det;
+            point const s = subtract(query.origin, v0);
+            float const u = dot(s, p) * inverse;
+            point const q{s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+            float const v = dot(d, q) * inverse;
+            float const t = dot(e2, q) * inverse;
+
+            if (det != 0.0F && u >= 0.0F && v >= 0.0F && u + v <= 1.0F && t >= query.t_min && t < hit.distance)
+            {
+                hit = ray_hit{.face = slot, .distance = t, .u = u, .v = v};
+            }
+        }
+    }
+#endif
+
+    struct task
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t slot;
+        std::size_t depth;
+    };
+
+    struct range_bounds
+    {
+        aabb bounds;
+        aabb centroids;
+    };
+
+    struct bin
+    {
+        aabb bounds;
+        std::size_t count{0UL};
+    };
+
+    using bins = std::array<std::array<bin, bin_count>, 3UL>;
+
+    // Reduces [begin, end) by blocks of grain elements, accumulate(partial, begin, end) filling the partial result of a block
+    // and merge(result, partial) combining them. Results only use min, max and sums of integers, so they do not depend on the
+    // number of blocks.
+    template <typename T, typename Accumulate, typename Merge>
+    [[nodiscard]] auto reduce(std::size_t const begin, std::size_t const end, std::size_t const threads,
+                              Accumulate const& accumulate, Merge const& merge) -> T
+    {
+        std::size_t const block_count = (end - begin + grain - 1UL) / grain;
+        T result{};
+
+        if (threads == 1UL || block_count < 2UL)
+        {
+            accumulate(result, begin, end);
+            return result;
+        }
+
+        std::vector<T> partials(block_count);
+
+        tml::detail::parallel_for(block_count, threads, 1UL, [&](std::size_t const first, std::size_t const last) {
+            for (std::size_t block{first}; block < last; ++block)
+            {
+                accumulate(partials[block], begin + block * grain, std::min(end, begin + (block + 1UL) * grain));
+            }
+        });
+
+        for (T const& partial : partials)
+        {
+            merge(result, partial);
+        }
+
+        return result;
+    }
+
+    class subtree_builder
+    {
+    public:
+
+        subtree_builder(std::vector<aabb> const& bounds, std::vector<point> const& centroids,
+                        std::vector<std::uint32_t>& order) noexcept
+            : m_bounds{bounds}, m_centroids{centroids}, m_order{order}
+        {
+        }
+
+        // Builds the subtree rooted at nodes[root.slot]. When deferred is given, subtrees of at most cutoff faces are left
+        // unbuilt and appended to it instead.
+        auto build(std::vector<bvh::node>& nodes, task const& root, std::size_t const threads, std::size_t const cutoff,
+                   std::vector<task>* const deferred) const -> void
+        {
+            std::vector<task> stack{root};
+
+            while (!stack.empty())
+            {
+                task const current = stack.back();
+                stack.pop_back();
+                std::size_t const count = current.end - current.begin;
+
+                if (deferred != nullptr && count <= cutoff && count > max_leaf_size)
+                {
+                    deferred->push_back(current);
+                    continue;
+                }
+
+                range_bounds const ranges = reduce<range_bounds>(
+                    current.begin, current.end, threads,
+                    [&](range_bounds& partial, std::size_t const first, std::size_t const last) -> void {
+                        for (std::size_t slot{first}; slot < last; ++slot)
+                        {
+                            partial.bounds.extend(m_bounds[m_order[slot]]);
+                            partial.centroids.extend(m_centroids[m_order[slot]]);
+                        }
+                    },
+                    [](range_bounds& result, range_bounds const& partial) -> void {
+                        result.bounds.extend(partial.bounds);
+                        result.centroids.extend(partial.centroids);
+                    });
+
+                nodes[current.slot].min = ranges.bounds.min;
+                nodes[current.slot].max = ranges.bounds.max;
+
+                if (count <= max_leaf_size)
+                {
+                    nodes[current.slot].index = static_cast<std::uint32_t>(current.begin);
+                    nodes[current.slot].count = static_cast<std::uint32_t>(count);
+                    continue;
+                }
+
+                std::size_t const middle = split(current, ranges.centroids, threads);
+                std::size_t const left = nodes.size();
+                nodes[current.slot].index = static_cast<std::uint32_t>(left);
+                nodes[current.slot].count = 0U;
+                nodes.resize(left + 2UL);
+                stack.push_back({middle, current.end, left + 1UL, current.depth + 1UL});
+                stack.push_back({current.begin, middle, left, current.depth + 1UL});
+            }
+        }
+
+    private:
+
+        // Partitions the range and returns the first slot of its right half. Faces are binned by centroid along each axis
+        // and the boundary between bins with the lowest surface area heuristic cost is kept. Past max_sah_depth, or when no
+        // boundary separates the centroids, the range is cut at its median along the widest axis, which bounds the depth.
+        [[nodiscard]] auto split(task const& current, aabb const& centroids, std::size_t const threads) const -> std::size_t
+        {
+            std::uint32_t* const first = m_order.data() + current.begin;
+            std::uint32_t* const last = m_order.data() + current.end;
+            point const extent = centroids.extent();
+            point scale{};
+
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                scale[axis] = extent[axis] > 0.0F ? static_cast<float>(bin_count) / extent[axis] : 0.0F;
+            }
+
+            // Faces with non-finite corners have a NaN offset, which fails the comparison and lands in the first bin.
+            auto const bin_of = [&](std::uint32_t const face, std::size_t const axis) -> std::size_t {
+                float const cell = (m_centroids[face][axis] - centroids.min[axis]) * scale[axis];
+
+                return cell > 0.0F ? static_cast<std::size_t>(std::min(cell, static_cast<float>(bin_count - 1UL))) : 0UL;
+            };
+
+            std::size_t const count = current.end - current.begin;
+            float best_cost{infinity};
+            std::size_t best_axis{0UL};
+            std::size_t best_boundary{0UL};
+
+            if (current.depth < max_sah_depth)
+            {
+                bins const binned = reduce<bins>(
+                    current.begin, current.end, threads,
+                    [&](bins& partial, std::size_t const begin, std::size_t const end) -> void {
+                        for (std::size_t slot{begin}; slot < end; ++slot)
+                        {
+                            std::uint32_t const face = m_order[slot];
+
+                            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+                            {
+                                bin& target = partial[axis][bin_of(face, axis)];
+                                target.bounds.extend(m_bounds[face]);
+                                ++target.count;
+                            }
+                        }
+                    },
+                    [](bins& result, bins const& partial) -> void {
+                        for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+                        {
+                            for (std::size_t idx{0UL}; idx < bin_count; ++idx)
+                            {
+                                result[axis][idx].bounds.extend(partial[axis][idx].bounds);
+                                result[axis][idx].count += partial[axis][idx].count;
+                            }
+                        }
+                    });
+
+                for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+                {
+                    if (!(extent[axis] > 0.0F))
+                    {
+                        continue;
+                    }
+
+                    // Cost of the faces in the bins at or after each boundary, then sweep the boundaries from the left.
+                    std::array<float, bin_count> right_costs{};
+                    aabb right;
+                    std::size_t right_count{0UL};
+
+                    for (std::size_t boundary{bin_count - 1UL}; boundary > 0UL; --boundary)
+                    {
+                        right.extend(binned[axis][boundary].bounds);
+                        right_count += binned[axis][boundary].count;
+                        right_costs[boundary] = right.surface_area() * static_cast<float>(right_count);
+                    }
+
+                    aabb left;
+                    std::size_t left_count{0UL};
+
+                    for (std::size_t boundary{1UL}; boundary < bin_count; ++boundary)
+                    {
+                        left.extend(binned[axis][boundary - 1UL].bounds);
+                        left_count += binned[axis][boundary - 1UL].count;
+
+                        if (left_count == 0UL || left_count == count)
+                        {
+                            continue;
+                        }
+
+                        float const cost = left.surface_area() * static_cast<float>(left_count) + right_costs[boundary];
+
+                        if (cost < best_cost)
+                        {
+                            best_cost = cost;
+                            best_axis = axis;
+                            best_boundary = boundary;
+                        }
+                    }
+                }
+            }
+
+            if (best_cost < infinity)
+            {
+                std::uint32_t const* const middle = std::partition(first, last, [&](std::uint32_t const face) -> bool {
+                    return bin_of(face, best_axis) < best_boundary;
+                });
+
+                return current.begin + static_cast<std::size_t>(middle - first);
+            }
+
+            std::size_t const axis = static_cast<std::size_t>(std::max_element(extent.begin(), extent.end()) - extent.begin());
+            std::size_t const middle = current.begin + count / 2UL;
+            std::nth_element(first, m_order.data() + middle, last, [&](std::uint32_t const lhs, std::uint32_t const rhs) -> bool {
+                return m_centroids[lhs][axis] < m_centroids[rhs][axis];
+            });
+
+            return middle;
+        }
+
+        std::vector<aabb> const& m_bounds;
+        std::vector<point> const& m_centroids;
+        std::vector<std::uint32_t>& m_order;
+    };
+} // namespace
+
+bvh::bvh(std::span<float const> const positions, std::span<face const> const faces, std::size_t const threads)
+{
+    std::size_t const thread_count = detail::thread_count(threads);
+    std::size_t const face_count = faces.size();
+
+    if (face_count == 0UL || face_count >= max_face_count)
+    {
+        return;
+    }
+
+    auto const position = [&](index_type const vertex) -> point {
+        std::size_t const offset = std::size_t{vertex} * 3;
+        return {positions[offset], positions[offset + 1], positions[offset + 2]};
+    };
+
+    std::vector<aabb> bounds(face_count);
+    std::vector<point> centroids(face_count);
+
+    detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t idx{begin}; idx < end; ++idx)
+        {
+            auto const [index_v1, index_v2, index_v3] = faces[idx].indices();
+            bounds[idx].extend(position(index_v1)).extend(position(index_v2)).extend(position(index_v3));
+            centroids[idx] = bounds[idx].center();
+        }
+    });
+
+    m_faces.resize(face_count);
+    std::iota(m_faces.begin(), m_faces.end(), 0U);
+    m_nodes.reserve(face_count * 2UL);
+    m_nodes.resize(1UL);
+    subtree_builder const builder{bounds, centroids, m_faces};
+    task const root{.begin = 0UL, .end = face_count, .slot = 0UL, .depth = 0UL};
+
+    if (thread_count == 1UL)
+    {
+        builder.build(m_nodes, root, 1UL, 0UL, nullptr);
+    }
+    else
+    {
+        // The top of the tree is built with parallel binning, then the subtrees below the cutoff are built independently
+        // into their own arrays and appended, their child indices shifted by their position in the final array.
+        std::size_t const cutoff = std::max(face_count / (thread_count * 4UL), grain);
+        std::vector<task> deferred;
+        builder.build(m_nodes, root, thread_count, cutoff, &deferred);
+        std::vector<std::vector<node>> subtrees(deferred.size());
+
+        detail::parallel_for(deferred.size(), thread_count, 1UL, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                subtrees[idx].reserve((deferred[idx].end - deferred[idx].begin) * 2UL);
+                subtrees[idx].resize(1UL);
+                builder.build(subtrees[idx], {deferred[idx].begin, deferred[idx].end, 0UL, deferred[idx].depth}, 1UL, 0UL,
+                              nullptr);
+            }
+        });
+
+        for (std::size_t idx{0UL}; idx < deferred.size(); ++idx)
+        {
+            auto const offset = static_cast<std::uint32_t>(m_nodes.size() - 1UL);
+            auto const relocate = [offset](node moved) -> node {
+                moved.index += moved.count == 0U ? offset : 0U;
+                return moved;
+            };
+
+            m_nodes[deferred[idx].slot] = relocate(subtrees[idx].front());
+
+            for (std::size_t slot{1UL}; slot < subtrees[idx].size(); ++slot)
+            {
+                m_nodes.push_back(relocate(subtrees[idx][slot]));
+            }
+        }
+    }
+
+    // Corners in leaf order, padded so that the four lanes read from the last leaf stay in bounds.
+    m_stride = face_count + 3UL;
+    m_corners.assign(m_stride * 9UL, 0.0F);
+
+    detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t slot{begin}; slot < end; ++slot)
+        {
+            auto const& indices = faces[m_faces[slot]].indices();
+
+            for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+            {
+                point const coordinates = position(indices[corner]);
+                m_corners[(corner * 3) * m_stride + slot] = coordinates[0];
+                m_corners[(corner * 3 + 1) * m_stride + slot] = coordinates[1];
+                m_corners[(corner * 3 + 2) * m_stride + slot] = coordinates[2];
+            }
+        }
+    });
+}
+
+auto bvh::bounds() const noexcept -> aabb
+{
+    return empty() ? aabb{} : bounds_of(m_nodes.front());
+}
+
+auto bvh::corner(std::size_t const slot, std::size_t const corner) const noexcept -> std::array<float, 3>
+{
+    return {m_corners[(corner * 3) * m_stride + slot], m_corners[(corner * 3 + 1) * m_stride + slot],
+            m_corners[(corner * 3 + 2) * m_stride + slot]};
+}
+
+auto bvh::intersect(ray const& query) const noexcept -> ray_hit
+{
+    ray_hit hit{.distance = query.t_max};
+
+    if (empty())
+    {
+        return ray_hit{};
+    }
+
+    point const inverse{1.0F / query.direction[0], 1.0F / query.direction[1], 1.0F / query.direction[2]};
+
+    // Distance at which the ray enters the node, or infinity if it misses it or only reaches it past the current hit.
+    auto const entry = [&](node const& box) -> float {
+        float near = query.t_min;
+        float far = hit.distance;
+
+        for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+        {
+            float const t1 = (box.min[axis] - query.origin[axis]) * inverse[axis];
+            float const t2 = (box.max[axis] - query.origin[axis]) * inverse[axis];
+            near = std::max(near, std::min(t1, t2));
+            far = std::min(far, std::max(t1, t2));
+        }
+
+        return near <= far ? near : infinity;
+    };
+
+    std::array<std::uint32_t, stack_size> stack;
+    std::array<float, stack_size> entries;
+    std::size_t top{0UL};
+    entries[top] = entry(m_nodes.front());
+    stack[top++] = 0U;
+
+    while (top > 0UL)
+    {
+        --top;
+        node const& current = m_nodes[stack[top]];
+
+        if (!(entries[top] < infinity) || entries[top] > hit.distance)
+        {
+            continue;
+        }
+
+        if (current.count > 0U)
+        {
+            intersect_leaf(m_corners.data(), m_stride, current.index, current.count, query, hit);
+            continue;
+        }
+
+        // The nearer child is pushed last so that it is visited first and shrinks the search for the other one.
+        std::array<float, 2> const distances{entry(m_nodes[current.index]), entry(m_nodes[current.index + 1U])};
+        std::uint32_t const near = distances[1] < distances[0] ? 1U : 0U;
+
+        for (std::uint32_t const child : {1U - near, near})
+        {
+            if (distances[child] < infinity)
+            {
+                entries[top] = distances[child];
+                stack[top++] = current.index + child;
+            }
+        }
+    }
+
+    if (hit.face == ray_hit::no_face)
+    {
+        return ray_hit{};
+    }
+
+    hit.face = m_faces[hit.face];
+
+    return hit;
+}
+
+auto bvh::intersect(std::span<ray const> const rays, std::span<ray_hit> const hits, std::size_t const threads) const noexcept
+    -> void
+{
+    std::size_t const count = std::min(rays.size(), hits.size());
+
+    detail::parallel_for(count, detail::thread_count(threads), 256UL, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t idx{begin}; idx < end; ++idx)
+        {
+            hits[idx] = intersect(rays[idx]);
+        }
+    });
+}
+
+auto bvh::closest_point(std::array<float, 3> const& point) const noexcept -> surface_point
+{
+    surface_point closest{};
+
+    if (empty())
+    {
+        return closest;
+    }
+
+    std::array<std::uint32_t, stack_size> stack;
+    std::array<float, stack_size> distances;
+    std::size_t top{0UL};
+    distances[top] = squared_distance(point, m_nodes.front());
+    stack[top++] = 0U;
+
+    while (top > 0UL)
+    {
+        --top;
+
+        if (distances[top] >= closest.squared_distance)
+        {
+            continue;
+        }
+
+        node const& current = m_nodes[stack[top]];
+
+        if (current.count > 0U)
+        {
+            for (std::size_t slot{current.index}; slot < std::size_t{current.index} + current.count; ++slot)
+            {
+                auto const candidate = closest_on_triangle(point, corner(slot, 0UL), corner(slot, 1UL), corner(slot, 2UL));
+                float const distance = squared_distance(point, candidate);
+
+                if (distance < closest.squared_distance)
+                {
+                    closest = surface_point{.position = candidate, .face = slot, .squared_distance = distance};
+                }
+            }
+
+            continue;
+        }
+
+        std::array<float, 2> const children{squared_distance(point, m_nodes[current.index]),
+                                            squared_distance(point, m_nodes[current.index + 1U])};
+        std::uint32_t const near = children[1] < children[0] ? 1U : 0U;
+
+        for (std::uint32_t const child : {1U - near, near})
+        {
+            if (children[child] < closest.squared_distance)
+            {
+                distances[top] = children[child];
+                stack[top++] = current.index + child;
+            }
+        }
+    }
+
+    // No face is at a finite distance of a point with an infinite or NaN coordinate.
+    if (closest.face == ray_hit::no_face)
+    {
+        return surface_point{};
+    }
+
+    closest.face = m_faces[closest.face];
+
+    return closest;
+}
+
+auto bvh::overlapping(aabb const& box) const -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> faces;
+
+    if (empty() || !box.overlaps(bounds()))
+    {
+        return faces;
+    }
+
+    std::array<std::uint32_t, stack_size> stack;
+    std::size_t top{0UL};
+    stack[top++] = 0U;
+
+    while (top > 0UL)
+    {
+        node const& current = m_nodes[stack[--top]];
+
+        if (current.count > 0U)
+        {
+            for (std::size_t slot{current.index}; slot < std::size_t{current.index} + current.count; ++slot)
+            {
+                aabb face_bounds;
+                face_bounds.extend(corner(slot, 0UL)).extend(corner(slot, 1UL)).extend(corner(slot, 2UL));
+
+                if (face_bounds.overlaps(box))
+                {
+                    faces.push_back(m_faces[slot]);
+                }
+            }
+
+            continue;
+        }
+
+        for (std::uint32_t child{0U}; child < 2U; ++child)
+        {
+            if (bounds_of(m_nodes[current.index + child]).overlaps(box))
+            {
+                stack[top++] = current.index + child;
+            }
+        }
+    }
+
+    std::sort(faces.begin(), faces.end());
+
+    return faces;
+}
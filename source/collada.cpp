@@ -0,0 +1,286 @@
+#include "ascii.hpp" // tml::detail::parse_number, tml::detail::skip_spaces
+#include "parallel.hpp" // tml::detail::thread_count
+#include "tml/mesh.hpp"
+#include "writer.hpp" // tml::detail::block_writer
+
+#include <algorithm> // std::max, std::min
+#include <array> // std::array
+#include <cstring> // std::strlen
+#include <fmt/format.h> // fmt::format_to
+#include <fstream> // std::ofstream
+#include <iterator> // std::back_inserter
+#include <optional> // std::optional
+#include <pugixml.hpp> // pugi::xml_document, pugi::xml_node, pugi::xml_parse_result
+#include <string_view> // std::string_view
+#include <vector> // std::vector
+
+using tml::face;
+using tml::mesh;
+
+namespace
+{
+    // Calls fn(value, position) for each whitespace-separated number of text, parsed in place from the document buffer.
+    // Returns the amount of numbers, or nothing if one of them is malformed.
+    template <typename T, typename F>
+    [[nodiscard]] auto for_each_number(char const* text, F&& fn) noexcept -> std::optional<std::size_t>
+    {
+        char const* cursor = text;
+        char const* const end = text + std::strlen(text);
+        std::size_t position{0UL};
+
+        while ((cursor = tml::detail::skip_spaces(cursor, end)) != end)
+        {
+            T value{};
+
+            if (!tml::detail::parse_number(cursor, end, value)) [[unlikely]]
+            {
+                return std::nullopt;
+            }
+
+            fn(value, position++);
+        }
+
+        return position;
+    }
+
+    [[nodiscard]] auto find_input(pugi::xml_node const& node, std::string_view const semantic) noexcept -> pugi::xml_node
+    {
+        for (auto const& input : node.children("input"))
+        {
+            if (input.attribute("semantic").value() == semantic)
+            {
+                return input;
+            }
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] auto find_source(pugi::xml_node const& mesh, std::string_view reference) noexcept -> pugi::xml_node
+    {
+        if (!reference.starts_with('#'))
+        {
+            return {};
+        }
+
+        reference.remove_prefix(1UL);
+
+        for (auto const& source : mesh.children("source"))
+        {
+            if (source.attribute("id").value() == reference)
+            {
+                return source;
+            }
+        }
+
+        return {};
+    }
+
+    // Appends the positions of a <mesh> element, read from the source its <vertices> element binds to POSITION.
+    [[nodiscard]] auto parse_positions(pugi::xml_node const& mesh, std::vector<float>& positions) -> tml::error_code
+    {
+        auto const source = find_source(mesh, find_input(mesh.child("vertices"), "POSITION").attribute("source").value());
+        auto const float_array = source.child("float_array");
+
+        if (!float_array) [[unlikely]]
+        {
+            return tml::error_code::invalid_data;
+        }
+
+        auto const declared = float_array.attribute("count").as_ullong();
+        auto const stride = source.child("technique_common").child("accessor").attribute("stride").as_ullong(3ULL);
+
+        if (stride < 3ULL || declared % stride != 0ULL) [[unlikely]]
+        {
+            return tml::error_code::invalid_data;
+        }
+
+        // Each number takes at least a digit and a separator, the declared count is not trusted past what the text can hold.
+        char const* const text = float_array.child_value();
+        positions.reserve(positions.size() + std::min<std::size_t>(declared, std::strlen(text) / 2UL + 1UL) / stride * 3ULL);
+
+        auto const count = for_each_number<float>(text, [&](float const value, std::size_t const position) {
+            if (position % stride < 3ULL)
+            {
+                positions.push_back(value);
+            }
+        });
+
+        return count && *count == declared ? tml::error_code::none : tml::error_code::invalid_data;
+    }
+
+    // Appends the faces of a <triangles> element. The <p> list interleaves one index per input, only the VERTEX one is kept.
+    [[nodiscard]] auto parse_triangles(pugi::xml_node const& triangles, std::size_t const first_vertex,
+                                       std::size_t const vertex_count, std::vector<face>& faces) -> tml::error_code
+    {
+        auto const vertex = find_input(triangles, "VERTEX");
+        std::size_t stride{1UL};
+
+        for (auto const& input : triangles.children("input"))
+        {
+            stride = std::max<std::size_t>(stride, input.attribute("offset").as_ullong() + 1ULL);
+        }
+
+        if (!vertex) [[unlikely]]
+        {
+            return tml::error_code::invalid_data;
+        }
+
+        auto const offset = vertex.attribute("offset").as_ullong();
+        auto const declared = triangles.attribute("count").as_ullong();
+        std::array<tml::index_type, 3UL> corners{};
+        std::size_t corner{0UL};
+        bool in_range{true};
+
+        // Bounded by the text like the positions, each face taking 3 * stride numbers.
+        char const* const text = triangles.child("p").child_value();
+        faces.reserve(faces.size() + std::min<std::size_t>(declared, (std::strlen(text) / 2UL + 1UL) / 3UL / stride));
+
+        auto const count = for_each_number<std::size_t>(text, [&](std::size_t const value, std::size_t const position) {
+            if (position % stride != offset)
+            {
+                return;
+            }
+
+            in_range = in_range && value < vertex_count;
+            corners[corner++] = static_cast<tml::index_type>(first_vertex + value);
+
+            if (corner == corners.size())
+            {
+                faces.emplace_back(corners[0], corners[1], corners[2]);
+                corner = 0UL;
+            }
+        });
+
+        return count && *count == declared * 3UL * stride && in_range ? tml::error_code::none : tml::error_code::invalid_data;
+    }
+
+    // Appends a <mesh> element, the indices of its faces being offset by the amount of vertices loaded before it.
+    [[nodiscard]] auto parse_mesh(pugi::xml_node const& mesh, std::vector<float>& positions, std::vector<face>& faces)
+        -> tml::error_code
+    {
+        std::size_t const first_vertex = positions.size() / 3;
+
+        if (auto const error = parse_positions(mesh, positions); error != tml::error_code::none) [[unlikely]]
+        {
+            return error;
+        }
+
+        if (positions.size() / 3 > tml::max_vertex_count) [[unlikely]]
+        {
+            return tml::error_code::index_out_of_range;
+        }
+
+        for (auto const& triangles : mesh.children("triangles"))
+        {
+            if (auto const error = parse_triangles(triangles, first_vertex, positions.size() / 3 - first_vertex, faces);
+                error != tml::error_code::none) [[unlikely]]
+            {
+                return error;
+            }
+        }
+
+        return tml::error_code::none;
+    }
+} // namespace
+
+auto mesh::load_from_collada(std::filesystem::path const& filepath) noexcept -> parse_error
+{
+    pugi::xml_document document;
+    pugi::xml_parse_result const result = document.load_file(filepath.c_str(), pugi::parse_minimal);
+
+    if (!result) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath) ? parse_error{.code = error_code::invalid_data}
+                                                 : parse_error{.code = error_code::file_not_found};
+    }
+
+    std::size_t const first_coordinate = m_positions.size();
+    std::size_t const first_face = m_faces.size();
+    auto error = error_code::none;
+
+    invalidate_topology();
+
+    for (auto const& geometry : document.child("COLLADA").child("library_geometries").children("geometry"))
+    {
+        if (auto const geometry_mesh = geometry.child("mesh"); geometry_mesh)
+        {
+            error = parse_mesh(geometry_mesh, m_positions, m_faces);
+        }
+
+        if (error != error_code::none) [[unlikely]]
+        {
+            break;
+        }
+    }
+
+    if (error != error_code::none) [[unlikely]]
+    {
+        m_positions.resize(first_coordinate);
+        m_faces.resize(first_face);
+    }
+
+    return parse_error{.code = error};
+}
+
+auto mesh::save_to_collada(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error
+{
+    if (options.encoding != encoding::ascii) [[unlikely]]
+    {
+        return write_error{.code = error_code::unsupported_format};
+    }
+
+    if (!options.can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    {
+        return write_error{.code = error_code::file_already_exists};
+    }
+
+    std::ofstream file{filepath};
+
+    if (!file)
+    {
+        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
+                                                 : write_error{.code = error_code::file_not_found};
+    }
+
+    detail::block_writer writer{file};
+    std::size_t const threads = detail::thread_count(options.threads);
+
+    writer.format(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<COLLADA version=\"1.5.0\">\n<library_geometries>\n<geometry "
+        "id=\"mesh\">\n<mesh>\n<source id=\"mesh-coords\">\n<float_array id=\"mesh-coords-array\" count=\"{}\">",
+        m_positions.size());
+
+    // Separators are written before each element but the first, so the lists never need to be trimmed afterwards.
+    writer.format_each(m_positions.size(), threads, [this](fmt::memory_buffer& buffer, std::size_t const index) -> void {
+        if (index != 0UL)
+        {
+            buffer.push_back(' ');
+        }
+
+        fmt::format_to(std::back_inserter(buffer), "{}", m_positions[index]);
+    });
+
+    writer.format("</float_array>\n<technique_common>\n<accessor count=\"{}\" offset=\"0\" source=\"#mesh-coords-array\" "
+                  "stride=\"3\">\n<param name=\"X\" type=\"float\"/>\n<param name=\"Y\" type=\"float\"/>\n<param name=\"Z\" "
+                  "type=\"float\"/>\n</accessor>\n</technique_common>\n</source>\n<vertices id=\"mesh-vertices\">\n<input "
+                  "semantic=\"POSITION\" source=\"#mesh-coords\"/>\n</vertices>\n<triangles count=\"{}\">\n<input offset=\"0\" "
+                  "semantic=\"VERTEX\" source=\"#mesh-vertices\"/>\n<p>",
+                  m_positions.size() / 3, m_faces.size());
+
+    writer.format_each(m_faces.size(), threads, [this](fmt::memory_buffer& buffer, std::size_t const index) -> void {
+        auto const [index_v1, index_v2, index_v3] = m_faces[index].indices();
+
+        if (index != 0UL)
+        {
+            buffer.push_back(' ');
+        }
+
+        fmt::format_to(std::back_inserter(buffer), "{} {} {}", index_v1, index_v2, index_v3);
+    });
+
+    writer.write("</p>\n</triangles>\n</mesh>\n</geometry>\n</library_geometries>\n</COLLADA>");
+    writer.flush();
+
+    return file ? write_error{.code = error_code::none} : write_error{.code = error_code::unknown_io_error};
+}
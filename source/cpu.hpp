@@ -0,0 +1,44 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TML_X86_64 1
+#else
+#define TML_X86_64 0
+#endif
+
+#if TML_X86_64 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // __cpuid, __cpuidex, _xgetbv
+#endif
+
+// Functions using instructions above the x86-64 baseline are compiled for them individually and only called after a
+// runtime check, so the library itself keeps targeting the baseline.
+#if TML_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define TML_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TML_TARGET_AVX2
+#endif
+
+namespace tml::detail
+{
+    [[nodiscard]] inline auto has_avx2() noexcept -> bool
+    {
+#if TML_X86_64 && (defined(__GNUC__) || defined(__clang__))
+        static bool const supported = __builtin_cpu_supports("avx2") != 0;
+
+        return supported;
+#elif TML_X86_64 && defined(_MSC_VER)
+        static bool const supported = []() -> bool {
+            int registers[4]{};
+            __cpuid(registers, 1);
+            bool const os_saves_ymm = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6U) == 0x6U;
+            __cpuidex(registers, 7, 0);
+
+            return os_saves_ymm && (registers[1] & (1 << 5)) != 0;
+        }();
+
+        return supported;
+#else
+        return false;
+#endif
+    }
+} // namespace tml::detail
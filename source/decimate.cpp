@@ -0,0 +1,853 @@
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "radix_sort.hpp" // tml::detail::radix_sort
+#include "stats.hpp" // tml::detail::record
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::min, std::max, std::sort, std::set_union, std::copy_n
+#include <array> // std::array
+#include <atomic> // std::atomic_ref
+#include <cmath> // std::abs, std::sqrt
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <iterator> // std::back_inserter
+#include <limits> // std::numeric_limits
+#include <utility> // std::move, std::pair
+#include <vector> // std::vector
+
+using tml::aabb;
+using tml::face;
+using tml::index_type;
+using tml::mesh;
+using tml::stat;
+
+namespace
+{
+    using point = std::array<double, 3>;
+    using corner_type = std::uint32_t;
+
+    constexpr std::size_t grain{1UL << 14U};
+    constexpr corner_type no_corner{std::numeric_limits<corner_type>::max()};
+
+    // Meshes of more faces than this are split into clusters of about this many faces before being decimated as a whole.
+    constexpr std::size_t cluster_size{1UL << 16U};
+    constexpr std::uint32_t locked{std::numeric_limits<std::uint32_t>::max()};
+    constexpr std::uint32_t any_cluster{locked - 1U};
+
+    // Weight of the planes holding the boundary edges in place, relative to the planes of the faces.
+    constexpr double boundary_weight{1000.0};
+
+    [[nodiscard]] constexpr auto subtract(point const& lhs, point const& rhs) noexcept -> point
+    {
+        return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+    }
+
+    [[nodiscard]] constexpr auto dot(point const& lhs, point const& rhs) noexcept -> double
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+    }
+
+    [[nodiscard]] constexpr auto cross(point const& lhs, point const& rhs) noexcept -> point
+    {
+        return {lhs[1] * rhs[2] - lhs[2] * rhs[1], lhs[2] * rhs[0] - lhs[0] * rhs[2], lhs[0] * rhs[1] - lhs[1] * rhs[0]};
+    }
+
+    // Spreads the 10 low bits of value three bits apart, to interleave them into a Morton code.
+    [[nodiscard]] constexpr auto spread(std::uint64_t value) noexcept -> std::uint64_t
+    {
+        value &= 0x3FFU;
+        value = (value | (value << 16U)) & 0x030000FFU;
+        value = (value | (value << 8U)) & 0x0300F00FU;
+        value = (value | (value << 4U)) & 0x030C30C3U;
+        value = (value | (value << 2U)) & 0x09249249U;
+
+        return value;
+    }
+
+    // Sum of the squared distances to a set of weighted planes, as the symmetric 4x4 matrix Q such that the error of a point
+    // p is [p 1] Q [p 1]^T (Garland and Heckbert, Surface Simplification Using Quadric Error Metrics). Only the upper
+    // triangle is stored, row by row.
+    struct quadric
+    {
+        std::array<double, 10> terms{};
+
+        // Plane of unit normal n through the point.
+        [[nodiscard]] static auto plane(point const& n, point const& through, double const weight) noexcept -> quadric
+        {
+            double const d = -dot(n, through);
+
+            return {{weight * n[0] * n[0], weight * n[0] * n[1], weight * n[0] * n[2], weight * n[0] * d, weight * n[1] * n[1],
+                     weight * n[1] * n[2], weight * n[1] * d, weight * n[2] * n[2], weight * n[2] * d, weight * d * d}};
+        }
+
+        auto operator+=(quadric const& other) noexcept -> quadric&
+        {
+            for (std::size_t idx{0UL}; idx < terms.size(); ++idx)
+            {
+                terms[idx] += other.terms[idx];
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] auto error(point const& p) const noexcept -> double
+        {
+            auto const& q = terms;
+
+            return p[0] * (q[0] * p[0] + 2.0 * (q[1] * p[1] + q[2] * p[2] + q[3])) +
+                   p[1] * (q[4] * p[1] + 2.0 * (q[5] * p[2] + q[6])) + p[2] * (q[7] * p[2] + 2.0 * q[8]) + q[9];
+        }
+
+        // Writes the point of least error to p, unless the 3x3 part of the matrix is close to singular, as it is on flat
+        // areas and along creases where a whole line or plane has the same error.
+        [[nodiscard]] auto minimum(point& p) const noexcept -> bool
+        {
+            static constexpr double singular{1e-10};
+            auto const& q = terms;
+            double const c00 = q[4] * q[7] - q[5] * q[5];
+            double const c01 = q[2] * q[5] - q[1] * q[7];
+            double const c02 = q[1] * q[5] - q[2] * q[4];
+            double const c11 = q[0] * q[7] - q[2] * q[2];
+            double const c12 = q[1] * q[2] - q[0] * q[5];
+            double const c22 = q[0] * q[4] - q[1] * q[1];
+            double const determinant = q[0] * c00 + q[1] * c01 + q[2] * c02;
+            double const trace = q[0] + q[4] + q[7];
+
+            if (!(std::abs(determinant) > singular * trace * trace * trace))
+            {
+                return false;
+            }
+
+            double const inverse = -1.0 / determinant;
+            p = {inverse * (c00 * q[3] + c01 * q[6] + c02 * q[8]), inverse * (c01 * q[3] + c11 * q[6] + c12 * q[8]),
+                 inverse * (c02 * q[3] + c12 * q[6] + c22 * q[8])};
+
+            return true;
+        }
+    };
+
+    // Collapse candidate, valid as long as the stamps of its vertices have not changed since it was pushed.
+    struct candidate
+    {
+        float cost;
+        index_type v1;
+        index_type v2;
+        std::uint16_t stamp1;
+        std::uint16_t stamp2;
+    };
+
+    // Min-heap of candidates by cost with four children per node, which halves the depth of a binary heap and keeps the
+    // children of a node within one or two cache lines.
+    class candidate_heap
+    {
+    public:
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return m_nodes.empty(); }
+
+        auto clear() noexcept -> void { m_nodes.clear(); }
+
+        // Appends a candidate without restoring the heap order, which make_heap then does for all of them at once.
+        auto append(candidate const& value) -> void { m_nodes.push_back(value); }
+
+        auto make_heap() noexcept -> void
+        {
+            for (std::size_t node = m_nodes.size() / arity + 1UL; node-- > 0UL;)
+            {
+                sift_down(node);
+            }
+        }
+
+        auto push(candidate const& value) -> void
+        {
+            std::size_t node = m_nodes.size();
+            m_nodes.push_back(value);
+
+            while (node > 0UL && value.cost < m_nodes[(node - 1UL) / arity].cost)
+            {
+                m_nodes[node] = m_nodes[(node - 1UL) / arity];
+                node = (node - 1UL) / arity;
+            }
+
+            m_nodes[node] = value;
+        }
+
+        auto pop() noexcept -> candidate
+        {
+            candidate const result = m_nodes.front();
+            m_nodes.front() = m_nodes.back();
+            m_nodes.pop_back();
+            sift_down(0UL);
+
+            return result;
+        }
+
+    private:
+
+        static constexpr std::size_t arity{4UL};
+
+        auto sift_down(std::size_t node) noexcept -> void
+        {
+            std::size_t const size = m_nodes.size();
+
+            if (node >= size)
+            {
+                return;
+            }
+
+            candidate const value = m_nodes[node];
+
+            for (std::size_t first = node * arity + 1UL; first < size; first = node * arity + 1UL)
+            {
+                std::size_t best = first;
+
+                for (std::size_t child = first + 1UL; child < std::min(first + arity, size); ++child)
+                {
+                    best = m_nodes[child].cost < m_nodes[best].cost ? child : best;
+                }
+
+                if (!(m_nodes[best].cost < value.cost))
+                {
+                    break;
+                }
+
+                m_nodes[node] = m_nodes[best];
+                node = best;
+            }
+
+            m_nodes[node] = value;
+        }
+
+        std::vector<candidate> m_nodes;
+    };
+
+    // Index-based connectivity shared by the collapsers. The corners of face f are 3f, 3f + 1 and 3f + 2, and the corners of
+    // each vertex are chained in a singly linked list through next, so that merging two vertices is a splice. Faces removed
+    // by a collapse are flagged in dead and unlinked lazily from the lists of their other vertices, their corners being left
+    // untouched so that each corner still names the vertex whose list it belongs to.
+    struct connectivity
+    {
+        std::vector<float> positions;
+        std::vector<index_type> corners;
+        std::vector<corner_type> next;
+        std::vector<corner_type> first;
+        std::vector<quadric> quadrics;
+
+        // Whether each face was removed by a collapse.
+        std::vector<std::uint8_t> dead;
+
+        // Bumped whenever the edges of a vertex change, which invalidates the candidates pushed before. A stamp wrapping
+        // around only lets a stale candidate through, which is checked again before it collapses.
+        std::vector<std::uint16_t> stamps;
+
+        // Whether each vertex was merged into another one.
+        std::vector<std::uint8_t> removed;
+
+        // Cluster owning each vertex, or locked for the vertices whose faces span several clusters.
+        std::vector<std::uint32_t> owners;
+
+        [[nodiscard]] auto position(index_type const vertex) const noexcept -> point
+        {
+            float const* const p = positions.data() + std::size_t{vertex} * 3;
+            return {p[0], p[1], p[2]};
+        }
+
+        [[nodiscard]] auto is_removed(std::size_t const face) const noexcept -> bool { return dead[face] != 0U; }
+
+        [[nodiscard]] auto holds(std::size_t const face, index_type const vertex) const noexcept -> bool
+        {
+            return corners[face * 3] == vertex || corners[face * 3 + 1] == vertex || corners[face * 3 + 2] == vertex;
+        }
+    };
+
+    // Greedy decimation of the vertices of one cluster, or of the whole mesh. Each collapse pushes the new edges of the
+    // kept vertex and bumps the stamps of both vertices, so that their former edges are skipped when they reach the top of
+    // the heap. The scratch buffers are kept between collapses and clusters.
+    class collapser
+    {
+    public:
+
+        explicit collapser(connectivity& mesh) noexcept : m_mesh{mesh} {}
+
+        // Collapses edges between vertices of the cluster until at most target faces of face_count remain, and returns the
+        // number of faces removed. The cluster is made of the vertices of [begin, end) owned by it.
+        auto run(std::uint32_t const cluster, std::size_t const begin, std::size_t const end, std::size_t const face_count,
+                 std::size_t const target) -> std::size_t
+        {
+            auto const& stamps = m_mesh.stamps;
+            m_cluster = cluster;
+            m_heap.clear();
+            std::uint64_t seeded{0U};
+
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const vertex = static_cast<index_type>(idx);
+
+                if (m_mesh.removed[vertex] != 0U || m_mesh.first[vertex] == no_corner || !owned(vertex))
+                {
+                    continue;
+                }
+
+                ++seeded;
+                static_cast<void>(ring(vertex, vertex, m_ring1));
+
+                for (index_type const neighbor : m_ring1)
+                {
+                    if (neighbor > vertex && owned(neighbor))
+                    {
+                        m_heap.append(make_candidate(vertex, neighbor));
+                    }
+                }
+            }
+
+            if (cluster == any_cluster)
+            {
+                tml::detail::record(stat::decimation_seeded_vertices, seeded);
+            }
+
+            m_heap.make_heap();
+            std::size_t remaining = face_count;
+
+            while (remaining > target && !m_heap.empty())
+            {
+                candidate const top = m_heap.pop();
+
+                if (stamps[top.v1] != top.stamp1 || stamps[top.v2] != top.stamp2)
+                {
+                    continue;
+                }
+
+                quadric merged;
+                auto const [p, error] = placement(top.v1, top.v2, merged);
+                remaining -= collapse(top.v1, top.v2, merged, p);
+            }
+
+            return face_count - remaining;
+        }
+
+    private:
+
+        [[nodiscard]] static auto cost_of(double const error) noexcept -> float
+        {
+            return static_cast<float>(std::max(0.0, error));
+        }
+
+        [[nodiscard]] auto make_candidate(index_type const v1, index_type const v2) const noexcept -> candidate
+        {
+            quadric merged;
+            return {cost_of(placement(v1, v2, merged).second), v1, v2, m_mesh.stamps[v1], m_mesh.stamps[v2]};
+        }
+
+        [[nodiscard]] auto owned(index_type const vertex) const noexcept -> bool
+        {
+            return m_cluster == any_cluster || m_mesh.owners[vertex] == m_cluster;
+        }
+
+        // Position minimizing the error of the merged quadrics, or the best of both ends and the middle of the edge when it
+        // is not unique.
+        [[nodiscard]] auto placement(index_type const v1, index_type const v2, quadric& merged) const noexcept
+            -> std::pair<point, double>
+        {
+            merged = m_mesh.quadrics[v1];
+            merged += m_mesh.quadrics[v2];
+            point best{};
+
+            if (merged.minimum(best))
+            {
+                return {best, merged.error(best)};
+            }
+
+            point const p1 = m_mesh.position(v1);
+            point const p2 = m_mesh.position(v2);
+            std::pair<point, double> result{p1, merged.error(p1)};
+
+            for (point const& p : {p2, point{(p1[0] + p2[0]) * 0.5, (p1[1] + p2[1]) * 0.5, (p1[2] + p2[2]) * 0.5}})
+            {
+                if (double const error = merged.error(p); error < result.second)
+                {
+                    result = {p, error};
+                }
+            }
+
+            return result;
+        }
+
+        struct ring_info
+        {
+            std::size_t shared_faces;
+            bool on_boundary;
+        };
+
+        // Writes the sorted neighbors of vertex to out, unlinking the removed faces from its list on the way. Also counts the
+        // faces holding other, and tells whether an edge of the vertex belongs to a single face.
+        auto ring(index_type const vertex, index_type const other, std::vector<index_type>& out) -> ring_info
+        {
+            auto& mesh = m_mesh;
+            ring_info info{0UL, false};
+            out.clear();
+
+            for (corner_type* link = &mesh.first[vertex]; *link != no_corner;)
+            {
+                corner_type const corner = *link;
+                std::size_t const face = corner / 3U;
+
+                if (mesh.is_removed(face))
+                {
+                    *link = mesh.next[corner];
+                    continue;
+                }
+
+                for (std::size_t const side : {1U, 2U})
+                {
+                    index_type const neighbor = mesh.corners[face * 3 + (corner % 3U + side) % 3U];
+
+                    if (neighbor != vertex)
+                    {
+                        out.push_back(neighbor);
+                    }
+                }
+
+                info.shared_faces += other != vertex && mesh.holds(face, other) ? 1UL : 0UL;
+                link = &mesh.next[corner];
+            }
+
+            std::sort(out.begin(), out.end());
+            std::size_t unique{0UL};
+
+            for (std::size_t idx{0UL}; idx < out.size();)
+            {
+                std::size_t run{idx + 1UL};
+
+                while (run < out.size() && out[run] == out[idx])
+                {
+                    ++run;
+                }
+
+                info.on_boundary = info.on_boundary || run - idx == 1UL;
+                out[unique++] = out[idx];
+                idx = run;
+            }
+
+            out.resize(unique);
+
+            return info;
+        }
+
+        // Whether moving vertex to p turns a face of it not holding other upside down or makes it degenerate.
+        [[nodiscard]] auto folds(index_type const vertex, index_type const other, point const& p) const noexcept -> bool
+        {
+            auto const& mesh = m_mesh;
+
+            for (corner_type corner = mesh.first[vertex]; corner != no_corner; corner = mesh.next[corner])
+            {
+                std::size_t const face = corner / 3U;
+
+                if (mesh.is_removed(face) || mesh.holds(face, other))
+                {
+                    continue;
+                }
+
+                point const a = mesh.position(vertex);
+                point const b = mesh.position(mesh.corners[face * 3 + (corner % 3U + 1U) % 3U]);
+                point const c = mesh.position(mesh.corners[face * 3 + (corner % 3U + 2U) % 3U]);
+                point const before = cross(subtract(b, a), subtract(c, a));
+                point const after = cross(subtract(b, p), subtract(c, p));
+
+                if (dot(before, before) > 0.0 && !(dot(before, after) > 0.0))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Merges v2 into v1 at p, pushes the new edges of v1 and returns the number of faces removed, or 0 when the collapse
+        // is rejected: when the edge is not shared by one or two faces, when the two vertices have other common neighbors
+        // than the opposite corners of these faces, which would pinch the surface, when it joins two boundaries through the
+        // inside, when fewer than three vertices would be left around the edge, or when a face would fold over.
+        auto collapse(index_type const v1, index_type const v2, quadric const& merged, point const& p) -> std::size_t
+        {
+            auto& mesh = m_mesh;
+            ring_info const info1 = ring(v1, v2, m_ring1);
+            ring_info const info2 = ring(v2, v1, m_ring2);
+            std::size_t const edge_faces = info1.shared_faces;
+
+            if (edge_faces == 0UL || edge_faces > 2UL || (edge_faces == 2UL && info1.on_boundary && info2.on_boundary))
+            {
+                return 0UL;
+            }
+
+            std::size_t common{0UL};
+
+            for (auto lhs = m_ring1.begin(), rhs = m_ring2.begin(); lhs != m_ring1.end() && rhs != m_ring2.end();)
+            {
+                if (*lhs < *rhs)
+                {
+                    ++lhs;
+                }
+                else if (*rhs < *lhs)
+                {
+                    ++rhs;
+                }
+                else
+                {
+                    ++common;
+                    ++lhs;
+                    ++rhs;
+                }
+            }
+
+            if (common != edge_faces || m_ring1.size() + m_ring2.size() - 2UL - common < 3UL)
+            {
+                return 0UL;
+            }
+
+            if (folds(v1, v2, p) || folds(v2, v1, p))
+            {
+                return 0UL;
+            }
+
+            float* const out = mesh.positions.data() + std::size_t{v1} * 3;
+            out[0] = static_cast<float>(p[0]);
+            out[1] = static_cast<float>(p[1]);
+            out[2] = static_cast<float>(p[2]);
+            mesh.quadrics[v1] = merged;
+            std::size_t removed_faces{0UL};
+            corner_type* tail = &mesh.first[v1];
+
+            while (*tail != no_corner)
+            {
+                tail = &mesh.next[*tail];
+            }
+
+            for (corner_type corner = mesh.first[v2]; corner != no_corner; corner = mesh.next[corner])
+            {
+                std::size_t const face = corner / 3U;
+
+                if (mesh.is_removed(face))
+                {
+                    continue;
+                }
+
+                if (mesh.holds(face, v1))
+                {
+                    mesh.dead[face] = 1U;
+                    ++removed_faces;
+                }
+                else
+                {
+                    mesh.corners[corner] = v1;
+                }
+            }
+
+            *tail = mesh.first[v2];
+            mesh.first[v2] = no_corner;
+            mesh.removed[v2] = 1U;
+            ++mesh.stamps[v1];
+            ++mesh.stamps[v2];
+            m_merged.clear();
+            std::set_union(m_ring1.begin(), m_ring1.end(), m_ring2.begin(), m_ring2.end(), std::back_inserter(m_merged));
+
+            for (index_type const neighbor : m_merged)
+            {
+                if (neighbor != v1 && neighbor != v2 && owned(neighbor))
+                {
+                    m_heap.push(make_candidate(v1, neighbor));
+                }
+            }
+
+            return removed_faces;
+        }
+
+        connectivity& m_mesh;
+        std::uint32_t m_cluster{any_cluster};
+        candidate_heap m_heap;
+        std::vector<index_type> m_ring1;
+        std::vector<index_type> m_ring2;
+        std::vector<index_type> m_merged;
+    };
+} // namespace
+
+auto mesh::decimate(std::size_t const target_face_count, std::size_t const threads) noexcept -> mesh&
+{
+    static constexpr std::uint64_t face_mask{(std::uint64_t{1U} << 34U) - 1U};
+    std::size_t const thread_count = detail::thread_count(threads);
+    std::size_t const vertex_count = m_positions.size() / 3;
+    std::size_t const face_count = m_faces.size();
+
+    if (face_count <= target_face_count || face_count * 3 >= no_corner)
+    {
+        return *this;
+    }
+
+    // Faces are sorted along the Morton curve of their centroids and vertices numbered in the order the sorted faces first
+    // reach them, so that the working copy of a neighborhood is packed in memory and clusters are ranges of faces.
+    aabb const box = bounds(thread_count);
+    auto const extent = box.extent();
+    std::array<double, 3> scale{};
+
+    for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+    {
+        scale[axis] = extent[axis] > 0.0F ? 1023.0 / static_cast<double>(extent[axis]) : 0.0;
+    }
+
+    std::vector<std::uint64_t> keys(face_count);
+
+    detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t idx{begin}; idx < end; ++idx)
+        {
+            auto const& indices = m_faces[idx].indices();
+            std::uint64_t code{0U};
+
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                double const centroid = (static_cast<double>(m_positions[std::size_t{indices[0]} * 3 + axis]) +
+                                         static_cast<double>(m_positions[std::size_t{indices[1]} * 3 + axis]) +
+                                         static_cast<double>(m_positions[std::size_t{indices[2]} * 3 + axis])) /
+                                        3.0;
+                double const cell = (centroid - static_cast<double>(box.min[axis])) * scale[axis];
+                code |= spread(cell > 0.0 ? static_cast<std::uint64_t>(std::min(cell, 1023.0)) : 0U) << axis;
+            }
+
+            keys[idx] = code << 34U | idx;
+        }
+    });
+
+    detail::radix_sort(keys, thread_count);
+
+    static constexpr index_type unreached{std::numeric_limits<index_type>::max()};
+    std::vector<index_type> locals(vertex_count, unreached);
+    std::vector<index_type> originals;
+    originals.reserve(vertex_count);
+    connectivity state{};
+    state.corners.resize(face_count * 3);
+
+    // Clusters are ranges of sorted faces. The vertices first reached by the faces of a cluster, among which all the ones
+    // it owns, are numbered from first_vertices[cluster] on.
+    std::size_t const cluster_count = face_count / cluster_size;
+    auto const cluster_begin = [&](std::size_t const cluster) -> std::size_t { return face_count * cluster / cluster_count; };
+    std::vector<std::size_t> first_vertices(cluster_count + 1UL, 0UL);
+    std::size_t next_cluster{0UL};
+
+    for (std::size_t idx{0UL}; idx < face_count; ++idx)
+    {
+        auto const& indices = m_faces[keys[idx] & face_mask].indices();
+
+        while (next_cluster < cluster_count && cluster_begin(next_cluster) == idx)
+        {
+            first_vertices[next_cluster++] = originals.size();
+        }
+
+        for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+        {
+            if (locals[indices[corner]] == unreached)
+            {
+                locals[indices[corner]] = static_cast<index_type>(originals.size());
+                originals.push_back(indices[corner]);
+            }
+
+            state.corners[idx * 3 + corner] = locals[indices[corner]];
+        }
+    }
+
+    std::size_t const local_count = originals.size();
+    first_vertices[cluster_count] = local_count;
+    state.positions.resize(local_count * 3);
+    state.next.resize(face_count * 3);
+    state.first.assign(local_count, no_corner);
+    state.quadrics.resize(local_count);
+    state.dead.assign(face_count, 0U);
+    state.stamps.assign(local_count, 0U);
+    state.removed.assign(local_count, 0U);
+    state.owners.assign(local_count, any_cluster);
+
+    detail::parallel_for(local_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            std::copy_n(m_positions.data() + std::size_t{originals[vertex]} * 3, 3UL, state.positions.data() + vertex * 3);
+        }
+    });
+
+    // Lists are filled backwards, so that the corners of each vertex are in increasing order.
+    for (std::size_t corner{face_count * 3}; corner-- > 0UL;)
+    {
+        index_type const vertex = state.corners[corner];
+        state.next[corner] = state.first[vertex];
+        state.first[vertex] = static_cast<corner_type>(corner);
+    }
+
+    // Each vertex sums the area-weighted planes of its faces, plus a plane orthogonal to each of its faces through each of
+    // its edges belonging to that face alone, which keeps the open boundaries in place.
+    detail::parallel_for(local_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        std::vector<std::pair<index_type, corner_type>> edges;
+
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            quadric& sum = state.quadrics[vertex];
+            point const a = state.position(static_cast<index_type>(vertex));
+            edges.clear();
+
+            for (corner_type corner = state.first[vertex]; corner != no_corner; corner = state.next[corner])
+            {
+                std::size_t const face = corner / 3U;
+                point const b = state.position(state.corners[face * 3 + (corner % 3U + 1U) % 3U]);
+                point const c = state.position(state.corners[face * 3 + (corner % 3U + 2U) % 3U]);
+                point const normal = cross(subtract(b, a), subtract(c, a));
+
+                if (double const length = std::sqrt(dot(normal, normal)); length > 0.0)
+                {
+                    sum += quadric::plane({normal[0] / length, normal[1] / length, normal[2] / length}, a, length * 0.5);
+                }
+
+                edges.emplace_back(state.corners[face * 3 + (corner % 3U + 1U) % 3U], corner);
+                edges.emplace_back(state.corners[face * 3 + (corner % 3U + 2U) % 3U], corner);
+            }
+
+            std::sort(edges.begin(), edges.end());
+
+            for (std::size_t idx{0UL}; idx < edges.size(); ++idx)
+            {
+                bool const alone = (idx == 0UL || edges[idx - 1].first != edges[idx].first) &&
+                                   (idx + 1UL == edges.size() || edges[idx + 1].first != edges[idx].first);
+
+                if (!alone || edges[idx].first == vertex)
+                {
+                    continue;
+                }
+
+                std::size_t const face = edges[idx].second / 3U;
+                point const p1 = state.position(state.corners[face * 3]);
+                point const normal = cross(subtract(state.position(state.corners[face * 3 + 1]), p1),
+                                           subtract(state.position(state.corners[face * 3 + 2]), p1));
+                point const edge = subtract(state.position(edges[idx].first), a);
+                point const side = cross(edge, normal);
+
+                if (double const length = std::sqrt(dot(side, side)); length > 0.0)
+                {
+                    sum += quadric::plane({side[0] / length, side[1] / length, side[2] / length}, a,
+                                          boundary_weight * dot(edge, edge));
+                }
+            }
+        }
+    });
+
+    std::size_t remaining = face_count;
+
+    // Large meshes are first cut into clusters of consecutive faces. Vertices whose faces all belong to one cluster are
+    // owned by it and only collapse with vertices of the same cluster, so that clusters are decimated concurrently down to
+    // their share of the target without sharing any vertex or face. The clusters do not depend on the thread count, and
+    // neither does the result.
+    if (cluster_count > 1UL)
+    {
+        detail::parallel_for(cluster_count, thread_count, 1UL, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t cluster{begin}; cluster < end; ++cluster)
+            {
+                for (std::size_t corner = cluster_begin(cluster) * 3; corner < cluster_begin(cluster + 1UL) * 3; ++corner)
+                {
+                    std::atomic_ref<std::uint32_t> owner{state.owners[state.corners[corner]]};
+                    std::uint32_t expected{any_cluster};
+
+                    if (!owner.compare_exchange_strong(expected, static_cast<std::uint32_t>(cluster), std::memory_order_relaxed) &&
+                        expected != cluster)
+                    {
+                        owner.store(locked, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+
+        std::vector<std::size_t> removed_faces(cluster_count, 0UL);
+
+        detail::parallel_for(cluster_count, thread_count, 1UL, [&](std::size_t const begin, std::size_t const end) {
+            collapser worker{state};
+
+            for (std::size_t cluster{begin}; cluster < end; ++cluster)
+            {
+                std::size_t const first = cluster_begin(cluster);
+                std::size_t const size = cluster_begin(cluster + 1UL) - first;
+                removed_faces[cluster] = worker.run(static_cast<std::uint32_t>(cluster), first_vertices[cluster],
+                                                    first_vertices[cluster + 1UL], size, size * target_face_count / face_count);
+            }
+        });
+
+        for (std::size_t const count : removed_faces)
+        {
+            remaining -= count;
+        }
+    }
+
+    // The whole mesh, borders between clusters included, is then decimated down to the target on the calling thread.
+    if (remaining > target_face_count)
+    {
+        if constexpr (tml::stats_enabled)
+        {
+            std::uint64_t live{0U};
+
+            for (std::size_t vertex{0UL}; vertex < local_count; ++vertex)
+            {
+                live += state.removed[vertex] == 0U && state.first[vertex] != no_corner ? 1U : 0U;
+            }
+
+            detail::record(stat::decimation_live_vertices, live);
+        }
+
+        remaining -= collapser{state}.run(any_cluster, 0UL, local_count, remaining, target_face_count);
+    }
+
+    // Surviving vertices and faces keep their relative order. Vertices without any face are never removed.
+    std::vector<index_type> remap(vertex_count);
+    std::size_t kept_vertices{0UL};
+
+    for (std::size_t vertex{0UL}; vertex < vertex_count; ++vertex)
+    {
+        remap[vertex] = static_cast<index_type>(kept_vertices);
+        kept_vertices += locals[vertex] == unreached || state.removed[locals[vertex]] == 0U ? 1UL : 0UL;
+    }
+
+    std::vector<float> new_positions(kept_vertices * 3);
+
+    detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            index_type const local = locals[vertex];
+
+            if (local == unreached)
+            {
+                std::copy_n(m_positions.data() + vertex * 3, 3UL, new_positions.data() + std::size_t{remap[vertex]} * 3);
+            }
+            else if (state.removed[local] == 0U)
+            {
+                std::copy_n(state.positions.data() + std::size_t{local} * 3, 3UL,
+                            new_positions.data() + std::size_t{remap[vertex]} * 3);
+            }
+        }
+    });
+
+    std::vector<corner_type> slots(face_count);
+
+    detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t idx{begin}; idx < end; ++idx)
+        {
+            slots[keys[idx] & face_mask] = static_cast<corner_type>(idx);
+        }
+    });
+
+    std::vector<face> new_faces;
+    new_faces.reserve(remaining);
+
+    for (std::size_t idx{0UL}; idx < face_count; ++idx)
+    {
+        std::size_t const slot = slots[idx];
+
+        if (!state.is_removed(slot))
+        {
+            new_faces.emplace_back(remap[originals[state.corners[slot * 3]]], remap[originals[state.corners[slot * 3 + 1]]],
+                                   remap[originals[state.corners[slot * 3 + 2]]]);
+        }
+    }
+
+    m_positions = std::move(new_positions);
+    m_faces = std::move(new_faces);
+    invalidate_topology();
+    drop_stale_attributes();
+
+    return *this;
+}
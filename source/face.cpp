@@ -2,9 +2,9 @@
 
 using tml::face;
 
-face::face(std::size_t v1, std::size_t v2, std::size_t v3) noexcept : m_indices{v1, v2, v3} {}
+face::face(index_type v1, index_type v2, index_type v3) noexcept : m_indices{v1, v2, v3} {}
 
-auto face::indices() const noexcept -> std::array<std::size_t, 3> const& { return m_indices; }
+auto face::indices() const noexcept -> std::array<index_type, 3> const& { return m_indices; }
 
 auto face::invert() noexcept -> face&
 {
@@ -0,0 +1,94 @@
+#include "tml/half_edge_topology.hpp"
+
+#include <numeric> // std::exclusive_scan
+
+using tml::face;
+using tml::half_edge_topology;
+
+half_edge_topology::half_edge_topology(std::span<face const> const faces, std::size_t const vertex_count)
+{
+    std::size_t const count = faces.size() * 3UL;
+
+    if (count >= invalid || vertex_count >= invalid)
+    {
+        return;
+    }
+
+    m_origins.resize(count);
+    m_twins.assign(count, invalid);
+    m_outgoing.assign(vertex_count, invalid);
+
+    for (std::size_t idx{0UL}; idx < faces.size(); ++idx)
+    {
+        auto const& indices = faces[idx].indices();
+        m_origins[idx * 3] = static_cast<index_type>(indices[0]);
+        m_origins[idx * 3 + 1] = static_cast<index_type>(indices[1]);
+        m_origins[idx * 3 + 2] = static_cast<index_type>(indices[2]);
+    }
+
+    // Half-edges bucketed by origin with a counting sort, so that the candidates twins of a -> b are the few half-edges
+    // leaving b. Pairing is then linear in the number of half-edges for bounded vertex degrees.
+    std::vector<index_type> offsets(vertex_count + 1UL, 0U);
+
+    for (auto const origin : m_origins)
+    {
+        ++offsets[origin];
+    }
+
+    std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 0U);
+    std::vector<index_type> buckets(count);
+    std::vector<index_type> cursors(offsets.begin(), offsets.end() - 1);
+
+    for (index_type half_edge{0U}; half_edge < count; ++half_edge)
+    {
+        buckets[cursors[m_origins[half_edge]]++] = half_edge;
+    }
+
+    // Returns the only half-edge from -> to, or invalid if there is none or several of them.
+    auto const find_unique = [&](index_type const from, index_type const to) -> index_type {
+        index_type found{invalid};
+
+        for (index_type slot = offsets[from]; slot < offsets[from + 1U]; ++slot)
+        {
+            if (target(buckets[slot]) == to)
+            {
+                if (found != invalid)
+                {
+                    return invalid;
+                }
+
+                found = buckets[slot];
+            }
+        }
+
+        return found;
+    };
+
+    for (index_type half_edge{0U}; half_edge < count; ++half_edge)
+    {
+        if (m_twins[half_edge] != invalid)
+        {
+            continue;
+        }
+
+        index_type const from = m_origins[half_edge];
+        index_type const to = target(half_edge);
+        index_type const twin = find_unique(to, from);
+
+        if (twin != invalid && find_unique(from, to) == half_edge)
+        {
+            m_twins[half_edge] = twin;
+            m_twins[twin] = half_edge;
+        }
+    }
+
+    for (index_type half_edge{0U}; half_edge < count; ++half_edge)
+    {
+        index_type& outgoing = m_outgoing[m_origins[half_edge]];
+
+        if (outgoing == invalid || (m_twins[half_edge] == invalid && m_twins[outgoing] != invalid))
+        {
+            outgoing = half_edge;
+        }
+    }
+}
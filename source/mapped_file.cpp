@@ -0,0 +1,193 @@
+#include "mapped_file.hpp"
+
+#include <system_error> // std::error_code
+#include <utility> // std::exchange
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using tml::detail::mapped_file;
+
+namespace
+{
+    auto open_error(std::filesystem::path const& filepath) noexcept -> tml::error_code
+    {
+        std::error_code ec;
+        return std::filesystem::exists(filepath, ec) ? tml::error_code::unknown_io_error : tml::error_code::file_not_found;
+    }
+} // namespace
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0UL)}
+#ifdef _WIN32
+    , m_file{std::exchange(other.m_file, nullptr)}, m_mapping{std::exchange(other.m_mapping, nullptr)}
+#endif
+{
+}
+
+mapped_file::~mapped_file() { close(); }
+
+auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file&
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0UL);
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+
+    return *this;
+}
+
+#ifdef _WIN32
+
+auto mapped_file::open(std::filesystem::path const& filepath) noexcept -> error_code
+{
+    close();
+
+    HANDLE const file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) [[unlikely]]
+    {
+        return open_error(filepath);
+    }
+
+    m_file = file;
+    LARGE_INTEGER size{};
+
+    if (GetFileSizeEx(file, &size) == 0) [[unlikely]]
+    {
+        close();
+        return error_code::unknown_io_error;
+    }
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+    if (m_size == 0UL)
+    {
+        return error_code::none;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (m_mapping == nullptr) [[unlikely]]
+    {
+        close();
+        return error_code::unknown_io_error;
+    }
+
+    m_data = static_cast<char const*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == nullptr) [[unlikely]]
+    {
+        close();
+        return error_code::unknown_io_error;
+    }
+
+    return error_code::none;
+}
+
+auto mapped_file::close() noexcept -> void
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+    }
+
+    if (m_file != nullptr)
+    {
+        CloseHandle(m_file);
+    }
+
+    m_data = nullptr;
+    m_size = 0UL;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+auto mapped_file::open(std::filesystem::path const& filepath) noexcept -> error_code
+{
+    close();
+
+    int const descriptor = ::open(filepath.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+
+    if (descriptor == -1) [[unlikely]]
+    {
+        return open_error(filepath);
+    }
+
+    struct stat status
+    {
+    };
+
+    if (::fstat(descriptor, &status) == -1 || !S_ISREG(status.st_mode)) [[unlikely]]
+    {
+        ::close(descriptor);
+        return error_code::unknown_io_error;
+    }
+
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    if (m_size == 0UL)
+    {
+        ::close(descriptor);
+        return error_code::none;
+    }
+
+    void* const address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (address == MAP_FAILED) [[unlikely]] // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    {
+        m_size = 0UL;
+        return error_code::unknown_io_error;
+    }
+
+    ::madvise(address, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<char const*>(address);
+
+    return error_code::none;
+}
+
+auto mapped_file::close() noexcept -> void
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(const_cast<char*>(m_data), m_size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+
+    m_data = nullptr;
+    m_size = 0UL;
+}
+
+#endif
+
+auto mapped_file::data() const noexcept -> char const* { return m_data; }
+
+auto mapped_file::size() const noexcept -> std::size_t { return m_size; }
+
+auto mapped_file::view() const noexcept -> std::string_view { return {m_data, m_size}; }
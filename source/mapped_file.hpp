@@ -0,0 +1,46 @@
+#pragma once
+
+#include "tml/error.hpp" // tml::error_code
+
+#include <cstddef> // std::size_t
+#include <filesystem> // std::filesystem::path
+#include <string_view> // std::string_view
+
+namespace tml::detail
+{
+    class mapped_file
+    {
+    public:
+
+        mapped_file() noexcept = default;
+
+        mapped_file(mapped_file const&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept;
+
+        ~mapped_file();
+
+        auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+        auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+        [[nodiscard]] auto open(std::filesystem::path const& filepath) noexcept -> error_code;
+
+        auto close() noexcept -> void;
+
+        [[nodiscard]] auto data() const noexcept -> char const*;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+        [[nodiscard]] auto view() const noexcept -> std::string_view;
+
+    private:
+
+        char const* m_data{nullptr};
+        std::size_t m_size{0UL};
+#ifdef _WIN32
+        void* m_file{nullptr};
+        void* m_mapping{nullptr};
+#endif
+    };
+} // namespace tml::detail
@@ -1,177 +1,118 @@
 #include "tml/mesh.hpp"
 
-#include "tml/edge.hpp" // tml::edge
-#include "tml/vec3.hpp" // tml::vec3
+#include "parallel.hpp" // tml::detail::parallel_for
+#include "stats.hpp" // tml::detail::record, tml::detail::scoped_timer
 
-#include <algorithm> // std::min, std::max
-#include <charconv> // std::from_chars
+#include <algorithm> // std::min, std::max, std::sort, std::unique, std::copy_n
+#include <atomic> // std::atomic
+#include <cstdint> // std::uint64_t
 #include <fmt/format.h> // fmt::format
-#include <fstream> // std::ifstream
-#include <pugixml.hpp> // pugi::xml_document, pugi::xml_parse_result
-#include <random> // std::mt19937, std::uniform_real_distribution, std::random_device
-#include <ranges> // std::views::iota
+#include <iterator> // std::next, std::distance
+#include <numeric> // std::inclusive_scan
+#include <span> // std::span
 #include <stdexcept> // std::runtime_error
-#include <tuple> // std::tuple
-#include <unordered_map> // std::unordered_map
 #include <vector> // std::vector
 
 using tml::face;
+using tml::matrix4;
 using tml::mesh;
-using tml::vertex;
+using tml::stat;
+using tml::vertex_view;
 
-mesh::mesh(std::filesystem::path const& filepath)
+namespace
 {
-    parse_error error;
-
-    if (filepath.extension() == ".ply")
-    {
-        error = load_from_ply(filepath);
-    }
-    else if (filepath.extension() == ".stl")
+    // Records the growth of a buffer as one allocation of its new capacity.
+    template <typename T>
+    auto record_growth(std::vector<T> const& buffer, std::size_t const previous_capacity) noexcept -> void
     {
-        error = load_from_stl(filepath);
+        if (buffer.capacity() != previous_capacity)
+        {
+            tml::detail::record(stat::allocations, 1U);
+            tml::detail::record(stat::allocated_bytes, buffer.capacity() * sizeof(T));
+        }
     }
-    else if (filepath.extension() == ".dae")
+} // namespace
+
+mesh::mesh(std::filesystem::path const& filepath, read_options const& options)
+{
+    auto const extension = filepath.extension();
+
+    // Unlike read, an unknown extension leaves the mesh empty instead of failing.
+    if (extension != ".ply" && extension != ".stl" && extension != ".dae" && extension != ".tmlb")
     {
-        error = load_from_collada(filepath);
+        return;
     }
 
+    auto const error = read(filepath, options);
+
     if (error) [[unlikely]]
     {
         throw std::runtime_error{fmt::format("Failed to load mesh: {}", error.message())};
     }
 }
 
-auto mesh::vertices() const noexcept -> std::vector<vertex> const& { return m_vertices; }
+auto mesh::vertices() const noexcept -> vertex_view { return vertex_view{*this}; }
 
-auto mesh::faces() const noexcept -> std::vector<face> const& { return m_faces; }
+auto mesh::positions() const noexcept -> std::span<float const> { return m_positions; }
 
-auto mesh::area() const noexcept -> float
+auto mesh::neighbors(std::size_t index) const noexcept -> std::span<tml::index_type const>
 {
-    float area{0.0F};
-    std::ranges::for_each(m_faces, [this, &area](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        vec3 const v1{m_vertices[index_v1].x(), m_vertices[index_v1].y(), m_vertices[index_v1].z()};
-        vec3 const v2{m_vertices[index_v2].x(), m_vertices[index_v2].y(), m_vertices[index_v2].z()};
-        vec3 const v3{m_vertices[index_v3].x(), m_vertices[index_v3].y(), m_vertices[index_v3].z()};
-        vec3 const edge1{v2.x() - v1.x(), v2.y() - v1.y(), v2.z() - v1.z()};
-        vec3 const edge2{v3.x() - v1.x(), v3.y() - v1.y(), v3.z() - v1.z()};
-
-        area += 0.5F * edge1.cross(edge2).norm();
-    });
+    auto const& graph = adjacency();
 
-    return area;
+    return std::span{graph.neighbors}.subspan(graph.offsets[index], graph.offsets[index + 1] - graph.offsets[index]);
 }
 
-auto mesh::is_closed() const noexcept -> bool
+auto mesh::faces() const noexcept -> std::vector<face> const& { return m_faces; }
+
+auto mesh::topology() const noexcept -> half_edge_topology const&
 {
-    std::unordered_map<edge, std::size_t> edges;
-    std::ranges::for_each(m_faces, [&edges](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        ++edges[{std::min(index_v1, index_v2), std::max(index_v1, index_v2)}];
-        ++edges[{std::min(index_v1, index_v3), std::max(index_v1, index_v3)}];
-        ++edges[{std::min(index_v2, index_v3), std::max(index_v2, index_v3)}];
+    return m_topology.get([this](half_edge_topology& topology) -> void {
+        topology = half_edge_topology{m_faces, m_positions.size() / 3};
     });
-
-    return std::ranges::all_of(edges, [](auto const& edge) -> bool { return edge.second == 2UL; });
 }
 
-auto mesh::center() noexcept -> mesh&
+auto mesh::centering() const noexcept -> matrix4
 {
-    auto const [min, max] = std::ranges::minmax(
-        m_vertices | std::views::transform([](vertex const& v) { return std::make_tuple(v.x(), v.y(), v.z()); }));
-
-    vec3 const center{(std::get<0>(max) + std::get<0>(min)) * 0.5F, (std::get<1>(max) + std::get<1>(min)) * 0.5F,
-                      (std::get<2>(max) + std::get<2>(min)) * 0.5F};
+    if (m_positions.empty())
+    {
+        return matrix4::identity();
+    }
 
-    std::ranges::for_each(m_vertices, [&](vertex& v) -> void { v.translate(-center); });
+    auto const [x, y, z] = bounds().center();
 
-    return *this;
+    return matrix4::translation({-x, -y, -z});
 }
 
+auto mesh::center() noexcept -> mesh& { return transform(centering()); }
+
 auto mesh::invert() noexcept -> mesh&
 {
     std::ranges::for_each(m_faces, [](auto& face) -> void { face.invert(); });
 
-    return *this;
-}
-
-auto mesh::scale(float factor) noexcept -> mesh&
-{
-    std::ranges::for_each(m_vertices, [&](vertex& vertex) -> void { vertex.scale(factor); });
+    // Reversing every face keeps the vertex adjacency but flips every half-edge. The normals are computed again rather
+    // than negated, since a face starting from another corner does not round the same way.
+    m_topology.reset();
+    invalidate_positions();
 
     return *this;
 }
 
-auto mesh::noise(float coefficient) noexcept -> mesh&
-{
-    std::mt19937 generator{std::random_device{}()};
-    std::uniform_real_distribution<float> distribution{-coefficient, coefficient};
-    std::ranges::for_each(m_vertices, [&](vertex& vertex) -> void {
-        vertex.translate(vec3{distribution(generator), distribution(generator), distribution(generator)});
-    });
-
-    return *this;
-}
-
-auto mesh::subdivide() noexcept -> mesh&
-{
-    std::vector<vertex> new_vertices;
-    std::vector<face> new_faces;
-    std::unordered_map<edge, std::size_t> edge_to_midpoint;
-    std::size_t const vertex_count = m_vertices.size();
-    std::size_t const face_count = m_faces.size();
-
-    new_vertices.reserve(vertex_count + face_count);
-    new_faces.reserve(face_count * 4);
-
-    std::ranges::for_each(m_vertices, [&](vertex const& vertex) -> void {
-        vec3 const v{vertex.x(), vertex.y(), vertex.z()};
-        std::size_t const n = vertex.neighbors().size();
-        auto const accumulator = [this](vec3 const& sum, std::size_t const neighbor) -> vec3 {
-            return sum + vec3{m_vertices[neighbor].x(), m_vertices[neighbor].y(), m_vertices[neighbor].z()};
-        };
-        auto const sum = std::accumulate(vertex.neighbors().begin(), vertex.neighbors().end(), vec3{.0F, .0F, .0F}, accumulator);
-        float const alpha = (n == 3) ? 3.0F / 16.0F : 3.0F / (8.0F * n);
-        new_vertices.emplace_back(v.x() * (1.0F - n * alpha) + sum.x() * alpha, v.y() * (1.0F - n * alpha) + sum.y() * alpha,
-                                  v.z() * (1.0F - n * alpha) + sum.z() * alpha);
-    });
-
-    std::ranges::for_each(m_faces, [&](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        std::size_t const index_v4 = new_vertices.size();
-        new_vertices.emplace_back((m_vertices[index_v1].x() + m_vertices[index_v2].x() + m_vertices[index_v3].x()) / 3.0F,
-                                  (m_vertices[index_v1].y() + m_vertices[index_v2].y() + m_vertices[index_v3].y()) / 3.0F,
-                                  (m_vertices[index_v1].z() + m_vertices[index_v2].z() + m_vertices[index_v3].z()) / 3.0F);
-        edge_to_midpoint[{std::min(index_v1, index_v2), std::max(index_v1, index_v2)}] = index_v4;
-        edge_to_midpoint[{std::min(index_v1, index_v3), std::max(index_v1, index_v3)}] = index_v4;
-        edge_to_midpoint[{std::min(index_v2, index_v3), std::max(index_v2, index_v3)}] = index_v4;
-    });
-
-    std::ranges::for_each(m_faces, [&](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        std::size_t const index_v4 = edge_to_midpoint[{std::min(index_v1, index_v2), std::max(index_v1, index_v2)}];
-        std::size_t const index_v5 = edge_to_midpoint[{std::min(index_v1, index_v3), std::max(index_v1, index_v3)}];
-        std::size_t const index_v6 = edge_to_midpoint[{std::min(index_v2, index_v3), std::max(index_v2, index_v3)}];
-        new_faces.emplace_back(index_v1, index_v4, index_v5);
-        new_faces.emplace_back(index_v2, index_v6, index_v4);
-        new_faces.emplace_back(index_v3, index_v5, index_v6);
-        new_faces.emplace_back(index_v4, index_v6, index_v5);
-    });
-
-    m_vertices = std::move(new_vertices);
-    m_faces = std::move(new_faces);
+auto mesh::scale(float factor) noexcept -> mesh& { return transform(matrix4::scaling(factor)); }
 
-    return *this;
-}
+auto mesh::read(std::filesystem::path const& filepath) noexcept -> parse_error { return read(filepath, read_options{}); }
 
-auto mesh::read(std::filesystem::path const& filepath) noexcept -> parse_error
+auto mesh::read(std::filesystem::path const& filepath, read_options const& options) noexcept -> parse_error
 {
+    detail::scoped_timer const timer{stat::read_time};
+    std::size_t const previous_vertices = m_positions.size() / 3;
+    std::size_t const previous_faces = m_faces.size();
+    std::size_t const previous_positions_capacity = m_positions.capacity();
+    std::size_t const previous_faces_capacity = m_faces.capacity();
     parse_error error;
 
     if (filepath.extension() == ".ply")
     {
-        error = load_from_ply(filepath);
+        error = load_from_ply(filepath, options);
     }
     else if (filepath.extension() == ".stl")
     {
@@ -181,375 +122,186 @@ auto mesh::read(std::filesystem::path const& filepath) noexcept -> parse_error
     {
         error = load_from_collada(filepath);
     }
+    else if (filepath.extension() == ".tmlb")
+    {
+        error = load_from_tmlb(filepath);
+    }
     else [[unlikely]]
     {
         return parse_error{.code = error_code::unsupported_format};
     }
 
+    drop_stale_attributes();
+
+    if constexpr (stats_enabled)
+    {
+        if (!error)
+        {
+            std::error_code ignored;
+            detail::record(stat::files_read, 1U);
+            detail::record(stat::bytes_read, std::filesystem::file_size(filepath, ignored));
+            detail::record(stat::vertices_read, m_positions.size() / 3 - previous_vertices);
+            detail::record(stat::faces_read, m_faces.size() - previous_faces);
+        }
+
+        record_growth(m_positions, previous_positions_capacity);
+        record_growth(m_faces, previous_faces_capacity);
+    }
+
     return error;
 }
 
 auto mesh::write(std::filesystem::path const& filepath, bool can_overwrite) const noexcept -> write_error
 {
+    return write(filepath, write_options{.can_overwrite = can_overwrite});
+}
+
+auto mesh::write(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error
+{
+    detail::scoped_timer const timer{stat::write_time};
     write_error error;
 
     if (filepath.extension() == ".ply")
     {
-        error = save_to_ply(filepath, can_overwrite);
+        error = save_to_ply(filepath, options);
     }
     else if (filepath.extension() == ".stl")
     {
-        error = save_to_stl(filepath, can_overwrite);
+        error = save_to_stl(filepath, options);
     }
     else if (filepath.extension() == ".dae")
     {
-        error = save_to_collada(filepath, can_overwrite);
-    }
-    else [[unlikely]]
-    {
-        return write_error{.code = error_code::unsupported_format};
-    }
-
-    return error;
-}
-
-auto mesh::save_to_ply(std::filesystem::path const& filepath, bool can_overwrite) const noexcept -> write_error
-{
-    if (!can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
-    {
-        return write_error{.code = error_code::file_already_exists};
+        error = save_to_collada(filepath, options);
     }
-
-    std::ofstream file{filepath};
-
-    if (!file) [[unlikely]]
+    else if (filepath.extension() == ".tmlb")
     {
-        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
-                                                 : write_error{.code = error_code::file_not_found};
+        error = save_to_tmlb(filepath, options);
     }
-
-    file << fmt::format(
-        "ply\nformat ascii 1.0\nelement vertex {}\nproperty float x\nproperty float y\nproperty float z\nelement face "
-        "{}\nproperty list uchar int vertex_indices\nend_header\n",
-        m_vertices.size(), m_faces.size());
-
-    std::ranges::for_each(m_vertices, [&file](vertex const& vertex) -> void {
-        file << fmt::format("{} {} {}\n", vertex.x(), vertex.y(), vertex.z());
-    });
-
-    std::ranges::for_each(m_faces, [&file](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        file << fmt::format("3 {} {} {}\n", index_v1, index_v2, index_v3);
-    });
-
-    return write_error{.code = error_code::none};
-}
-
-auto mesh::save_to_stl(std::filesystem::path const& filepath, bool can_overwrite) const noexcept -> write_error
-{
-    if (!can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    else [[unlikely]]
     {
-        return write_error{.code = error_code::file_already_exists};
+        return write_error{.code = error_code::unsupported_format};
     }
 
-    std::ofstream file{filepath};
-
-    if (!file) [[unlikely]]
+    if constexpr (stats_enabled)
     {
-        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
-                                                 : write_error{.code = error_code::file_not_found};
+        if (!error)
+        {
+            std::error_code ignored;
+            detail::record(stat::files_written, 1U);
+            detail::record(stat::bytes_written, std::filesystem::file_size(filepath, ignored));
+        }
     }
 
-    file << fmt::format("solid {}\n", filepath.stem().string());
-    std::ranges::for_each(m_faces, [this, &file](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        vec3 const v1{m_vertices[index_v1].x(), m_vertices[index_v1].y(), m_vertices[index_v1].z()};
-        vec3 const v2{m_vertices[index_v2].x(), m_vertices[index_v2].y(), m_vertices[index_v2].z()};
-        vec3 const v3{m_vertices[index_v3].x(), m_vertices[index_v3].y(), m_vertices[index_v3].z()};
-        vec3 const edge1{v2.x() - v1.x(), v2.y() - v1.y(), v2.z() - v1.z()};
-        vec3 const edge2{v3.x() - v1.x(), v3.y() - v1.y(), v3.z() - v1.z()};
-        vec3 const normal{edge1.cross(edge2)};
-
-        file << fmt::format(
-            "facet normal {} {} {}\nouter loop\nvertex {} {} {}\nvertex {} {} {}\nvertex {} {} {}\nendloop\nendfacet\n",
-            normal.x(), normal.y(), normal.z(), v1.x(), v1.y(), v1.z(), v2.x(), v2.y(), v2.z(), v3.x(), v3.y(), v3.z());
-    });
-
-    file << fmt::format("endsolid {}\n", filepath.stem().string());
-
-    return write_error{.code = error_code::none};
+    return error;
 }
 
-auto mesh::save_to_collada(std::filesystem::path const& filepath, bool can_overwrite) const noexcept -> write_error
+auto mesh::adjacency(std::size_t const threads) const noexcept -> csr_adjacency const&
 {
-    if (!can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
-    {
-        return write_error{.code = error_code::file_already_exists};
-    }
-
-    std::ofstream file{filepath};
-
-    if (!file)
-    {
-        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
-                                                 : write_error{.code = error_code::file_not_found};
-    }
-
-    file << fmt::format(
-        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<COLLADA version=\"1.5.0\">\n<library_geometries>\n<geometry "
-        "id=\"mesh\">\n<mesh>\n<source id=\"mesh-coords\">\n<float_array id=\"mesh-coords-array\" count=\"{}\">",
-        m_vertices.size() * 3);
-
-    std::ranges::for_each(m_vertices, [&file](vertex const& vertex) -> void {
-        file << fmt::format("{} {} {} ", vertex.x(), vertex.y(), vertex.z());
-    });
-
-    file.seekp(-1, std::ios_base::end);
-
-    file << "</float_array>\n<technique_common>\n<accessor count=\"" << m_vertices.size()
-         << "\" offset=\"0\" source=\"#mesh-coords-array\" stride=\"3\">\n<param name=\"X\" type=\"float\"/>\n<param name=\"Y\" "
-            "type=\"float\"/>\n<param name=\"Z\" type=\"float\"/>\n</accessor>\n</technique_common>\n</source>\n<vertices "
-            "id=\"mesh-vertices\">\n<input semantic=\"POSITION\" source=\"#mesh-coords\"/>\n</vertices>\n<triangles count=\""
-         << m_faces.size() << "\">\n<input offset=\"0\" semantic=\"VERTEX\" source=\"#mesh-vertices\"/>\n<p>";
-
-    std::ranges::for_each(m_faces, [&file](face const& face) -> void {
-        auto const [index_v1, index_v2, index_v3] = face.indices();
-        file << fmt::format("{} {} {} ", index_v1, index_v2, index_v3);
-    });
-
-    file.seekp(-1, std::ios_base::end);
-    file << "</p>\n</triangles>\n</mesh>\n</geometry>\n</library_geometries>\n</COLLADA>";
-
-    return write_error{.code = error_code::none};
+    return m_adjacency.get([this, threads](csr_adjacency& adjacency) -> void { build_adjacency(adjacency, threads); });
 }
 
-auto mesh::load_from_ply(std::filesystem::path const& filepath) noexcept -> parse_error
+auto mesh::build_adjacency(csr_adjacency& adjacency, std::size_t const threads) const noexcept -> void
 {
-    std::ifstream file{filepath};
-
-    if (!file) [[unlikely]]
-    {
-        return std::filesystem::exists(filepath) ? parse_error{.code = error_code::unknown_io_error}
-                                                 : parse_error{.code = error_code::file_not_found};
-    }
+    static constexpr std::size_t grain{1UL << 16U};
+    detail::scoped_timer const timer{stat::adjacency_time};
+    std::size_t const vertex_count = m_positions.size() / 3;
+    std::vector<std::atomic<std::size_t>> cursors(vertex_count + 1);
 
-    static constexpr std::ptrdiff_t vertex_count_offset{15L};
-    static constexpr std::ptrdiff_t face_count_offset{13L};
-    std::size_t vertex_count{0UL};
-    std::size_t face_count{0UL};
-    std::string line;
-
-    while (std::getline(file, line))
-    {
-        if (line.starts_with("end_header"))
-        {
-            break;
-        }
-
-        auto const* start = line.data();
-        auto const* end = line.data();
-        std::ranges::advance(end, static_cast<std::ptrdiff_t>(line.size()));
-
-        if (line.starts_with("element vertex"))
+    detail::parallel_for(m_faces.size(), threads, grain, [this, &cursors](std::size_t const begin, std::size_t const end) {
+        for (auto const& face : std::span{m_faces}.subspan(begin, end - begin))
         {
-            std::ranges::advance(start, vertex_count_offset);
-            auto const [ptr, ec] = std::from_chars(start, end, vertex_count);
-
-            if (ec != std::errc()) [[unlikely]]
+            for (auto const index : face.indices())
             {
-                return parse_error{.code = error_code::invalid_data};
+                cursors[index + 1].fetch_add(2UL, std::memory_order_relaxed);
             }
         }
-        else if (line.starts_with("element face"))
-        {
-            std::ranges::advance(start, face_count_offset);
-            auto const [ptr, ec] = std::from_chars(start, end, face_count);
-
-            if (ec != std::errc()) [[unlikely]]
-            {
-                return parse_error{.code = error_code::invalid_data};
-            }
-        }
-    }
-
-    m_vertices.reserve(vertex_count);
-    m_faces.reserve(face_count);
-
-    std::ranges::for_each(std::views::iota(0UL, vertex_count), [this, &file]([[maybe_unused]] std::size_t const idx) -> void {
-        float x{0.0F};
-        float y{0.0F};
-        float z{0.0F};
-        file >> x >> y >> z;
-        m_vertices.emplace_back(x, y, z);
-    });
-
-    std::ranges::for_each(std::views::iota(0UL, face_count), [&]([[maybe_unused]] std::size_t const idx) -> void {
-        std::size_t v1{0UL};
-        std::size_t v2{0UL};
-        std::size_t v3{0UL};
-        file >> vertex_count >> v1 >> v2 >> v3;
-        m_faces.emplace_back(v1, v2, v3);
-
-        m_vertices[v1].add_neighbor(v2);
-        m_vertices[v1].add_neighbor(v3);
-        m_vertices[v2].add_neighbor(v1);
-        m_vertices[v2].add_neighbor(v3);
-        m_vertices[v3].add_neighbor(v1);
-        m_vertices[v3].add_neighbor(v2);
     });
 
-    return parse_error{.code = error_code::none};
-}
+    // Every undirected edge is emitted once per incident face and in no particular order, rows are deduplicated below.
+    std::vector<std::size_t> offsets(vertex_count + 1, 0UL);
 
-auto mesh::load_from_stl(std::filesystem::path const& filepath) noexcept -> parse_error
-{
-    std::ifstream file{filepath};
-
-    if (!file) [[unlikely]]
+    for (std::size_t vertex{1UL}; vertex <= vertex_count; ++vertex)
     {
-        return std::filesystem::exists(filepath) ? parse_error{.code = error_code::unknown_io_error}
-                                                 : parse_error{.code = error_code::file_not_found};
+        offsets[vertex] = offsets[vertex - 1] + cursors[vertex].load(std::memory_order_relaxed);
+        cursors[vertex - 1].store(offsets[vertex - 1], std::memory_order_relaxed);
     }
 
-    std::string line;
-    std::unordered_map<vertex, std::size_t> vertex_indices;
-    std::vector<std::size_t> face_vertex_indices;
+    std::vector<index_type> entries(offsets.back());
 
-    while (std::getline(file, line))
-    {
-        if (line.starts_with("vertex"))
+    detail::parallel_for(m_faces.size(), threads, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (auto const& face : std::span{m_faces}.subspan(begin, end - begin))
         {
-            auto const* start = line.data();
-            auto const* end = line.data();
-            float x{0.0F};
-            float y{0.0F};
-            float z{0.0F};
-
-            std::ranges::advance(start, 7L);
-            std::ranges::advance(end, static_cast<std::ptrdiff_t>(line.size()));
-            auto [ptr, ec] = std::from_chars(start, end, x);
-
-            if (ec != std::errc()) [[unlikely]]
-            {
-                return parse_error{.code = error_code::invalid_data};
-            }
-
-            std::ranges::advance(ptr, 1L);
-            start = ptr;
-            auto [ptr2, ec2] = std::from_chars(start, end, y);
-
-            if (ec2 != std::errc()) [[unlikely]]
-            {
-                return parse_error{.code = error_code::invalid_data};
-            }
-
-            std::ranges::advance(ptr2, 1L);
-            start = ptr2;
-
-            auto [_, ec3] = std::from_chars(start, end, z);
+            auto const [index_v1, index_v2, index_v3] = face.indices();
+            std::size_t const slot_v1 = cursors[index_v1].fetch_add(2UL, std::memory_order_relaxed);
+            std::size_t const slot_v2 = cursors[index_v2].fetch_add(2UL, std::memory_order_relaxed);
+            std::size_t const slot_v3 = cursors[index_v3].fetch_add(2UL, std::memory_order_relaxed);
+            entries[slot_v1] = index_v2;
+            entries[slot_v1 + 1] = index_v3;
+            entries[slot_v2] = index_v1;
+            entries[slot_v2 + 1] = index_v3;
+            entries[slot_v3] = index_v1;
+            entries[slot_v3 + 1] = index_v2;
+        }
+    });
 
-            if (ec3 != std::errc()) [[unlikely]]
-            {
-                return parse_error{.code = error_code::invalid_data};
-            }
+    std::vector<std::size_t> sizes(vertex_count + 1, 0UL);
 
-            vertex const v{x, y, z};
-            auto const [it, inserted] = vertex_indices.try_emplace(v, m_vertices.size());
+    detail::parallel_for(vertex_count, threads, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            auto const row_begin = std::next(entries.begin(), static_cast<std::ptrdiff_t>(offsets[vertex]));
+            auto const row_end = std::next(entries.begin(), static_cast<std::ptrdiff_t>(offsets[vertex + 1]));
+            std::sort(row_begin, row_end);
+            sizes[vertex + 1] = static_cast<std::size_t>(std::distance(row_begin, std::unique(row_begin, row_end)));
+        }
+    });
 
-            if (inserted)
-            {
-                m_vertices.push_back(v);
-            }
+    std::inclusive_scan(sizes.begin(), sizes.end(), sizes.begin());
+    std::size_t const previous_capacity = adjacency.neighbors.capacity();
+    adjacency.neighbors.resize(sizes.back());
 
-            face_vertex_indices.push_back(it->second);
-        }
-        else if (line.starts_with("endfacet"))
+    detail::parallel_for(vertex_count, threads, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
         {
-            if (face_vertex_indices.size() == 3)
-            {
-                std::size_t const v1 = face_vertex_indices[0];
-                std::size_t const v2 = face_vertex_indices[1];
-                std::size_t const v3 = face_vertex_indices[2];
-                m_faces.emplace_back(v1, v2, v3);
-
-                m_vertices[v1].add_neighbor(v2);
-                m_vertices[v1].add_neighbor(v3);
-                m_vertices[v2].add_neighbor(v1);
-                m_vertices[v2].add_neighbor(v3);
-                m_vertices[v3].add_neighbor(v1);
-                m_vertices[v3].add_neighbor(v2);
-
-                face_vertex_indices.clear();
-            }
+            auto const row_begin = std::next(entries.begin(), static_cast<std::ptrdiff_t>(offsets[vertex]));
+            std::copy_n(row_begin, sizes[vertex + 1] - sizes[vertex],
+                        std::next(adjacency.neighbors.begin(), static_cast<std::ptrdiff_t>(sizes[vertex])));
         }
+    });
+
+    if constexpr (stats_enabled)
+    {
+        detail::record(stat::adjacency_entries, entries.size());
+        detail::record(stat::adjacency_duplicates, entries.size() - adjacency.neighbors.size());
+        detail::record(stat::allocations, 4U);
+        detail::record(stat::allocated_bytes, cursors.size() * sizeof(std::atomic<std::size_t>) +
+                                                  entries.size() * sizeof(index_type) +
+                                                  (offsets.size() + sizes.size()) * sizeof(std::size_t));
+        record_growth(adjacency.neighbors, previous_capacity);
     }
 
-    return parse_error{.code = error_code::none};
+    adjacency.offsets = std::move(sizes);
 }
 
-auto mesh::load_from_collada(std::filesystem::path const& filepath) noexcept -> parse_error
+auto mesh::invalidate_topology() noexcept -> void
 {
-    using pugi::xml_document;
-    using pugi::xml_parse_result;
-
-    xml_document document;
-    xml_parse_result const result = document.load_file(filepath.c_str());
+    m_adjacency.reset();
+    m_topology.reset();
 
-    if (!result) [[unlikely]]
-    {
-        return parse_error{.code = error_code::invalid_data};
-    }
-
-    auto const library_geometries = document.child("COLLADA").child("library_geometries");
-
-    for (auto const& geometry : library_geometries)
-    {
-        for (auto const& mesh : geometry.children("mesh"))
-        {
-            for (auto const& source : mesh.children("source"))
-            {
-                auto const* float_array = source.child("float_array").child_value();
-                std::istringstream iss{float_array};
-                std::vector<float> vertex_data(std::istream_iterator<float>{iss}, {});
-
-                if (vertex_data.size() % 3 != 0) [[unlikely]]
-                {
-                    return parse_error{.code = error_code::invalid_data};
-                }
-
-                for (auto const idx : std::views::iota(0UL, vertex_data.size() / 3))
-                {
-                    m_vertices.emplace_back(vertex_data[idx * 3], vertex_data[idx * 3 + 1], vertex_data[idx * 3 + 2]);
-                }
-            }
+    // Every operation rebuilding the faces also rewrites the positions, but only along with the normals read with them.
+    reset_position_caches();
+}
 
-            for (auto const& triangles : mesh.children("triangles"))
-            {
-                std::istringstream iss(triangles.child("p").child_value());
-                std::vector<size_t> face_data(std::istream_iterator<size_t>{iss}, {});
-
-                if (face_data.size() % 3 != 0) [[unlikely]]
-                {
-                    return parse_error{.code = error_code::invalid_data};
-                }
-
-                for (auto const idx : std::views::iota(0UL, face_data.size() / 3))
-                {
-                    std::size_t const v1 = face_data[idx * 3];
-                    std::size_t const v2 = face_data[idx * 3 + 1];
-                    std::size_t const v3 = face_data[idx * 3 + 2];
-                    m_faces.emplace_back(v1, v2, v3);
-
-                    m_vertices[v1].add_neighbor(v2);
-                    m_vertices[v1].add_neighbor(v3);
-                    m_vertices[v2].add_neighbor(v1);
-                    m_vertices[v2].add_neighbor(v3);
-                    m_vertices[v3].add_neighbor(v1);
-                    m_vertices[v3].add_neighbor(v2);
-                }
-            }
-        }
-    }
+auto mesh::invalidate_positions() noexcept -> void
+{
+    reset_position_caches();
+    drop_normal_attributes();
+}
 
-    return parse_error{.code = error_code::none};
+auto mesh::reset_position_caches() noexcept -> void
+{
+    m_bounds.reset();
+    m_face_normals.reset();
+    m_area_vertex_normals.reset();
+    m_angle_vertex_normals.reset();
 }
@@ -0,0 +1,158 @@
+#include "tml/mesh_batch.hpp"
+
+#include "noise.hpp" // tml::detail::add_noise, tml::detail::random_seed
+#include "tml/mesh_reader.hpp" // tml::mesh_reader
+
+#include <algorithm> // std::ranges::for_each, std::ranges::all_of, std::min, std::copy_n
+#include <array> // std::array
+#include <cmath> // std::sqrt
+#include <limits> // std::numeric_limits
+
+using tml::area_accumulator;
+using tml::mesh_batch;
+
+auto mesh_batch::clear() noexcept -> void
+{
+    first_vertex = 0UL;
+    first_face = 0UL;
+    positions.clear();
+    faces.clear();
+}
+
+auto mesh_batch::invert() noexcept -> mesh_batch&
+{
+    std::ranges::for_each(faces, [](auto& face) -> void { face.invert(); });
+
+    return *this;
+}
+
+auto mesh_batch::scale(float factor) noexcept -> mesh_batch&
+{
+    std::ranges::for_each(positions, [factor](float& coordinate) -> void { coordinate *= factor; });
+
+    return *this;
+}
+
+auto mesh_batch::noise(float coefficient) noexcept -> mesh_batch&
+{
+    return noise(coefficient, tml::detail::random_seed());
+}
+
+auto mesh_batch::noise(float coefficient, std::uint64_t seed) noexcept -> mesh_batch&
+{
+    tml::detail::add_noise(positions.data(), positions.size(), first_vertex * 3, seed, coefficient);
+
+    return *this;
+}
+
+auto area_accumulator::cached_position(std::size_t const index) -> float const*
+{
+    if (m_pages.empty())
+    {
+        m_pages.resize(cache_pages * page_size * 3);
+        m_page_ids.assign(cache_pages, std::numeric_limits<std::size_t>::max());
+    }
+
+    // Each page of the file has a single slot, which the faces, referring mostly to vertices read close to each other,
+    // rarely need to share.
+    std::size_t const page = index / page_size;
+    std::size_t const slot = page % cache_pages;
+    float* const positions = m_pages.data() + slot * page_size * 3;
+
+    if (m_page_ids[slot] != page)
+    {
+        std::size_t const first = page * page_size;
+        std::size_t const count = std::min(page_size, m_reader->vertex_count() - first);
+
+        if (m_reader->read_positions(first, count, positions)) [[unlikely]]
+        {
+            m_page_ids[slot] = std::numeric_limits<std::size_t>::max();
+
+            return nullptr;
+        }
+
+        m_page_ids[slot] = page;
+    }
+
+    return positions + (index - page * page_size) * 3;
+}
+
+auto area_accumulator::add(mesh_batch const& batch) -> void
+{
+    bool const rereads = m_reader != nullptr && m_reader->can_reread_positions();
+
+    if (batch.faces.empty())
+    {
+        // Only batches following the retained vertices are kept, so that the retained positions never have holes.
+        if (!rereads && batch.first_vertex == m_positions.size() / 3)
+        {
+            m_positions.insert(m_positions.end(), batch.positions.begin(), batch.positions.end());
+        }
+
+        return;
+    }
+
+    std::size_t const first = batch.first_vertex;
+    std::size_t const last = first + batch.vertex_count();
+    std::size_t const retained = m_positions.size() / 3;
+
+    for (auto const& face : batch.faces)
+    {
+        auto const& indices = face.indices();
+        std::array<float, 9UL> corners{};
+        std::array<float const*, 3UL> vertices{};
+
+        if (std::ranges::all_of(indices, [first, last](auto const index) -> bool { return first <= index && index < last; }))
+        {
+            for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+            {
+                vertices[corner] = batch.positions.data() + (std::size_t{indices[corner]} - first) * 3;
+            }
+        }
+        else if (std::ranges::all_of(indices, [retained](auto const index) -> bool { return index < retained; }))
+        {
+            for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+            {
+                vertices[corner] = m_positions.data() + std::size_t{indices[corner]} * 3;
+            }
+        }
+        else if (rereads)
+        {
+            // The corners are copied out, since reading one may evict the page of another.
+            for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+            {
+                float const* const position = cached_position(indices[corner]);
+
+                if (position == nullptr) [[unlikely]]
+                {
+                    break;
+                }
+
+                vertices[corner] = std::copy_n(position, 3UL, corners.data() + corner * 3) - 3;
+            }
+
+            if (vertices[2] == nullptr) [[unlikely]]
+            {
+                continue;
+            }
+        }
+        else [[unlikely]]
+        {
+            continue;
+        }
+
+        float const* const v1 = vertices[0];
+        float const* const v2 = vertices[1];
+        float const* const v3 = vertices[2];
+        float const e1x = v2[0] - v1[0];
+        float const e1y = v2[1] - v1[1];
+        float const e1z = v2[2] - v1[2];
+        float const e2x = v3[0] - v1[0];
+        float const e2y = v3[1] - v1[1];
+        float const e2z = v3[2] - v1[2];
+        float const cx = e1y * e2z - e1z * e2y;
+        float const cy = e1z * e2x - e1x * e2z;
+        float const cz = e1x * e2y - e1y * e2x;
+        m_area += static_cast<double>(0.5F * std::sqrt(cx * cx + cy * cy + cz * cz));
+    }
+}
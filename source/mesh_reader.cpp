@@ -0,0 +1,578 @@
+#include "tml/mesh_reader.hpp"
+
+#include "ascii.hpp" // tml::detail::parse_number, tml::detail::next_token, tml::detail::skip_spaces
+#include "binary.hpp" // tml::detail::load
+#include "buffered_file.hpp" // tml::detail::buffered_file
+#include "ply_format.hpp" // tml::detail::parse_ply_header, tml::detail::parse_binary_face, tml::detail::vertex_layout
+#include "stl_format.hpp" // tml::detail::stl_header_size, tml::detail::stl_record_size, tml::detail::is_binary_stl
+#include "tml/index.hpp" // tml::index_type, tml::max_vertex_count
+
+#include <algorithm> // std::max, std::min
+#include <array> // std::array
+#include <bit> // std::endian
+#include <cstdint> // std::uint32_t
+#include <cstring> // std::memcpy
+#include <fstream> // std::ifstream
+#include <ios> // std::ios_base, std::streamoff, std::streamsize
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <memory> // std::make_unique
+#include <utility> // std::move
+#include <vector> // std::vector
+
+using tml::error_code;
+using tml::face;
+using tml::mesh_batch;
+using tml::mesh_reader;
+using tml::parse_error;
+using tml::detail::ply_format;
+
+namespace
+{
+    enum class source_format
+    {
+        ply,
+        binary_stl,
+        ascii_stl,
+    };
+
+    // Collects the corners of the facets of an ASCII STL file, one line at a time.
+    struct facet_parser
+    {
+        std::array<float, 9UL> corners{};
+        std::size_t corner_count{0UL};
+        bool complete{false};
+
+        auto feed(std::string_view line) noexcept -> error_code
+        {
+            auto const keyword = tml::detail::next_token(line);
+            complete = false;
+
+            if (keyword == "vertex")
+            {
+                std::array<float, 3UL> coordinates{};
+                char const* cursor = line.data();
+                char const* const end = line.data() + line.size();
+
+                for (float& coordinate : coordinates)
+                {
+                    if (!tml::detail::parse_number(cursor, end, coordinate)) [[unlikely]]
+                    {
+                        return error_code::invalid_data;
+                    }
+                }
+
+                if (corner_count < 3UL)
+                {
+                    std::memcpy(corners.data() + corner_count * 3, coordinates.data(), sizeof(coordinates));
+                }
+
+                ++corner_count;
+            }
+            else if (keyword == "endfacet")
+            {
+                complete = corner_count == 3UL;
+                corner_count = 0UL;
+            }
+
+            return error_code::none;
+        }
+    };
+} // namespace
+
+struct mesh_reader::impl
+{
+    tml::detail::buffered_file file;
+    source_format format{source_format::ply};
+    std::size_t batch_size{default_batch_size};
+    std::size_t vertex_count{0UL};
+    std::size_t face_count{0UL};
+    std::size_t vertices_read{0UL};
+    std::size_t faces_read{0UL};
+    error_code error{error_code::none};
+
+    // The properties of the header refer to its text, which has to outlive them.
+    std::string header_text;
+    tml::detail::ply_header header;
+    tml::detail::vertex_layout layout;
+    tml::detail::face_layout face_layout;
+    bool swap{false};
+    bool native_xyz{false};
+
+    facet_parser facets;
+
+    // Second handle on the file for read_positions, opened on its first call.
+    std::filesystem::path filepath;
+    std::ifstream positions_file;
+    std::vector<char> records;
+
+    // Reads more of the file after the unconsumed bytes, growing the buffer when they fill most of it. Returns false when
+    // nothing more could be read.
+    auto more() noexcept -> bool
+    {
+        std::size_t const held = file.view().size();
+
+        return held < tml::detail::buffered_file::max_record_size && file.fill(held * 2UL);
+    }
+
+    auto open_ply() noexcept -> error_code
+    {
+        while (true)
+        {
+            auto const content = file.view();
+            auto const keyword = content.find("\nend_header");
+            auto const end = keyword == std::string_view::npos ? keyword : content.find('\n', keyword + 1UL);
+
+            if (end != std::string_view::npos || (keyword != std::string_view::npos && file.at_end()))
+            {
+                header_text = content.substr(0UL, end == std::string_view::npos ? end : end + 1UL);
+                break;
+            }
+
+            if (!more()) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+        }
+
+        if (auto const header_error = tml::detail::parse_ply_header(header_text, header); header_error != error_code::none)
+            [[unlikely]]
+        {
+            return header_error;
+        }
+
+        file.consume(header.body_offset);
+        vertex_count = header.vertex_count;
+        face_count = header.face_count;
+
+        if (vertex_count > tml::max_vertex_count) [[unlikely]]
+        {
+            return error_code::index_out_of_range;
+        }
+
+        if (auto const face_error = tml::detail::make_face_layout(header, face_layout); face_error != error_code::none)
+            [[unlikely]]
+        {
+            return face_error;
+        }
+
+        swap = tml::detail::swaps_bytes(header);
+        native_xyz = tml::detail::is_native_xyz(header);
+
+        return tml::detail::make_vertex_layout(header, layout);
+    }
+
+    auto open_stl() noexcept -> error_code
+    {
+        auto const content = file.view();
+
+        if (content.size() >= tml::detail::stl_header_size + sizeof(std::uint32_t))
+        {
+            auto const count = tml::detail::load<std::uint32_t>(content.data() + tml::detail::stl_header_size,
+                                                                std::endian::native == std::endian::big);
+
+            if (tml::detail::is_binary_stl(file.size(), count))
+            {
+                format = source_format::binary_stl;
+                face_count = count;
+                file.consume(tml::detail::stl_header_size + sizeof(std::uint32_t));
+            }
+        }
+
+        // The faces of an ASCII file are counted beforehand, so that the counts are known before the first batch as with
+        // the other formats.
+        if (format == source_format::ascii_stl)
+        {
+            std::string_view line;
+
+            while (file.next_line(line))
+            {
+                if (auto const line_error = facets.feed(line); line_error != error_code::none) [[unlikely]]
+                {
+                    return line_error;
+                }
+
+                face_count += facets.complete ? 1UL : 0UL;
+            }
+
+            if (!file.exhausted()) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+
+            if (auto const rewind_error = file.rewind(); rewind_error != error_code::none) [[unlikely]]
+            {
+                return rewind_error;
+            }
+
+            facets = facet_parser{};
+        }
+
+        vertex_count = face_count * 3;
+
+        return vertex_count > tml::max_vertex_count ? error_code::index_out_of_range : error_code::none;
+    }
+
+    // Calls parse(cursor, end, index) for the count next elements of an ASCII body. The buffer is only handed whole lines,
+    // and an element whose parsing stops at the end of them is parsed again once more lines have been read.
+    template <typename Parse>
+    auto parse_ascii(std::size_t const count, Parse const& parse) noexcept -> error_code
+    {
+        std::size_t done{0UL};
+
+        while (done < count)
+        {
+            auto const chunk = file.lines();
+            char const* cursor = chunk.data();
+            char const* const end = chunk.data() + chunk.size();
+            char const* stop{nullptr};
+            auto element_error = error_code::none;
+
+            for (; done < count; ++done)
+            {
+                char const* const element = cursor;
+                element_error = parse(cursor, end, done);
+
+                if (element_error != error_code::none) [[unlikely]]
+                {
+                    stop = cursor;
+                    cursor = element;
+                    break;
+                }
+            }
+
+            file.consume(static_cast<std::size_t>(cursor - chunk.data()));
+
+            if (element_error != error_code::none && (tml::detail::skip_spaces(stop, end) != end || !more())) [[unlikely]]
+            {
+                return element_error;
+            }
+        }
+
+        return error_code::none;
+    }
+
+    auto read_ply_vertices(mesh_batch& batch, std::size_t const count) noexcept -> error_code
+    {
+        batch.positions.resize(count * 3);
+        float* const positions = batch.positions.data();
+
+        if (header.format == ply_format::ascii)
+        {
+            return parse_ascii(count, [positions, this](char const*& cursor, char const* end, std::size_t const index)
+                                   -> error_code {
+                return tml::detail::parse_ascii_vertex(cursor, end, layout, positions + index * 3) ? error_code::none
+                                                                                                   : error_code::invalid_data;
+            });
+        }
+
+        for (std::size_t done{0UL}; done < count;)
+        {
+            auto const content = file.view();
+            std::size_t const available = std::min(count - done, content.size() / layout.stride);
+
+            if (available == 0UL)
+            {
+                if (!more()) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                continue;
+            }
+
+            if (native_xyz)
+            {
+                std::memcpy(positions + done * 3, content.data(), available * 3 * sizeof(float));
+            }
+            else
+            {
+                for (std::size_t vertex{0UL}; vertex < available; ++vertex)
+                {
+                    tml::detail::read_position(layout, content.data() + vertex * layout.stride, swap,
+                                               positions + (done + vertex) * 3);
+                }
+            }
+
+            file.consume(available * layout.stride);
+            done += available;
+        }
+
+        return error_code::none;
+    }
+
+    auto read_ply_faces(mesh_batch& batch, std::size_t const count) noexcept -> error_code
+    {
+        batch.faces.resize(count);
+        face* const faces = batch.faces.data();
+
+        if (header.format == ply_format::ascii)
+        {
+            return parse_ascii(count, [faces, this](char const*& cursor, char const* end, std::size_t const index) -> error_code {
+                return tml::detail::parse_ascii_face(cursor, end, face_layout, vertex_count, faces[index]);
+            });
+        }
+
+        for (std::size_t done{0UL}; done < count;)
+        {
+            auto const content = file.view();
+            char const* cursor = content.data();
+
+            while (done < count)
+            {
+                auto const face_error =
+                    tml::detail::parse_binary_face(cursor, content.data() + content.size(), face_layout, vertex_count, swap,
+                                                   faces[done]);
+
+                if (!face_error)
+                {
+                    break;
+                }
+
+                if (*face_error != error_code::none) [[unlikely]]
+                {
+                    return *face_error;
+                }
+
+                ++done;
+            }
+
+            file.consume(static_cast<std::size_t>(cursor - content.data()));
+
+            if (done < count && !more()) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+        }
+
+        return error_code::none;
+    }
+
+    auto read_stl(mesh_batch& batch, std::size_t const count) noexcept -> error_code
+    {
+        batch.positions.resize(count * 9);
+        batch.faces.resize(count);
+
+        for (std::size_t idx{0UL}; idx < count; ++idx)
+        {
+            auto const first = static_cast<tml::index_type>(batch.first_vertex + idx * 3);
+            batch.faces[idx] = face{first, first + 1U, first + 2U};
+        }
+
+        if (format == source_format::ascii_stl)
+        {
+            std::string_view line;
+
+            for (std::size_t done{0UL}; done < count;)
+            {
+                if (!file.next_line(line)) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                if (auto const line_error = facets.feed(line); line_error != error_code::none) [[unlikely]]
+                {
+                    return line_error;
+                }
+
+                if (facets.complete)
+                {
+                    std::memcpy(batch.positions.data() + done * 9, facets.corners.data(), sizeof(facets.corners));
+                    ++done;
+                }
+            }
+
+            return error_code::none;
+        }
+
+        bool const swap_bytes = std::endian::native == std::endian::big;
+
+        for (std::size_t done{0UL}; done < count;)
+        {
+            auto const content = file.view();
+            std::size_t const available = std::min(count - done, content.size() / tml::detail::stl_record_size);
+
+            if (available == 0UL)
+            {
+                if (!more()) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                continue;
+            }
+
+            for (std::size_t record{0UL}; record < available; ++record)
+            {
+                // The normal comes first and is not kept.
+                char const* coordinates = content.data() + record * tml::detail::stl_record_size + 3UL * sizeof(float);
+                float* const output = batch.positions.data() + (done + record) * 9;
+
+                for (std::size_t coordinate{0UL}; coordinate < 9UL; ++coordinate, coordinates += sizeof(float))
+                {
+                    output[coordinate] = tml::detail::load<float>(coordinates, swap_bytes);
+                }
+            }
+
+            file.consume(available * tml::detail::stl_record_size);
+            done += available;
+        }
+
+        return error_code::none;
+    }
+
+    [[nodiscard]] auto can_reread_positions() const noexcept -> bool
+    {
+        return format == source_format::ply && header.format != ply_format::ascii;
+    }
+
+    auto read_positions(std::size_t const first_vertex, std::size_t const count, float* const output) noexcept -> error_code
+    {
+        if (!positions_file.is_open())
+        {
+            positions_file.open(filepath, std::ios_base::binary);
+
+            if (!positions_file) [[unlikely]]
+            {
+                return error_code::unknown_io_error;
+            }
+        }
+
+        records.resize(count * layout.stride);
+        positions_file.clear();
+        positions_file.seekg(static_cast<std::streamoff>(header.body_offset + first_vertex * layout.stride));
+        positions_file.read(records.data(), static_cast<std::streamsize>(records.size()));
+
+        if (!positions_file) [[unlikely]]
+        {
+            return error_code::invalid_data;
+        }
+
+        if (native_xyz)
+        {
+            std::memcpy(output, records.data(), count * 3 * sizeof(float));
+        }
+        else
+        {
+            for (std::size_t vertex{0UL}; vertex < count; ++vertex)
+            {
+                tml::detail::read_position(layout, records.data() + vertex * layout.stride, swap, output + vertex * 3);
+            }
+        }
+
+        return error_code::none;
+    }
+
+    auto read(mesh_batch& batch) noexcept -> error_code
+    {
+        if (format != source_format::ply)
+        {
+            batch.first_vertex = faces_read * 3;
+            batch.first_face = faces_read;
+            std::size_t const count = std::min(batch_size, face_count - faces_read);
+            faces_read += count;
+
+            return count == 0UL ? error_code::none : read_stl(batch, count);
+        }
+
+        if (vertices_read < vertex_count)
+        {
+            batch.first_vertex = vertices_read;
+            std::size_t const count = std::min(batch_size, vertex_count - vertices_read);
+            vertices_read += count;
+
+            return read_ply_vertices(batch, count);
+        }
+
+        batch.first_vertex = vertex_count;
+        batch.first_face = faces_read;
+        std::size_t const count = std::min(batch_size, face_count - faces_read);
+        faces_read += count;
+
+        return count == 0UL ? error_code::none : read_ply_faces(batch, count);
+    }
+};
+
+mesh_reader::mesh_reader() noexcept = default;
+
+mesh_reader::mesh_reader(mesh_reader&& other) noexcept = default;
+
+mesh_reader::~mesh_reader() = default;
+
+auto mesh_reader::operator=(mesh_reader&& other) noexcept -> mesh_reader& = default;
+
+auto mesh_reader::open(std::filesystem::path const& filepath, std::size_t const batch_size) noexcept -> parse_error
+{
+    m_impl.reset();
+
+    if (filepath.extension() != ".ply" && filepath.extension() != ".stl") [[unlikely]]
+    {
+        return parse_error{.code = error_code::unsupported_format};
+    }
+
+    auto state = std::make_unique<impl>();
+    state->batch_size = std::max(batch_size, 1UL);
+    state->filepath = filepath;
+
+    if (auto const error = state->file.open(filepath); error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = error};
+    }
+
+    state->file.fill();
+    state->format = filepath.extension() == ".ply" ? source_format::ply : source_format::ascii_stl;
+    auto const error = state->format == source_format::ply ? state->open_ply() : state->open_stl();
+
+    if (error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = error};
+    }
+
+    m_impl = std::move(state);
+
+    return parse_error{.code = error_code::none};
+}
+
+auto mesh_reader::vertex_count() const noexcept -> std::size_t { return m_impl ? m_impl->vertex_count : 0UL; }
+
+auto mesh_reader::face_count() const noexcept -> std::size_t { return m_impl ? m_impl->face_count : 0UL; }
+
+auto mesh_reader::read(mesh_batch& batch) noexcept -> parse_error
+{
+    batch.clear();
+
+    if (!m_impl)
+    {
+        return parse_error{.code = error_code::none};
+    }
+
+    if (m_impl->error == error_code::none)
+    {
+        m_impl->error = m_impl->read(batch);
+    }
+
+    if (m_impl->error != error_code::none) [[unlikely]]
+    {
+        batch.clear();
+    }
+
+    return parse_error{.code = m_impl->error};
+}
+
+auto mesh_reader::can_reread_positions() const noexcept -> bool { return m_impl && m_impl->can_reread_positions(); }
+
+auto mesh_reader::read_positions(std::size_t const first_vertex, std::size_t const count, float* const output) noexcept
+    -> parse_error
+{
+    if (!can_reread_positions()) [[unlikely]]
+    {
+        return parse_error{.code = error_code::unsupported_format};
+    }
+
+    if (first_vertex > m_impl->vertex_count || count > m_impl->vertex_count - first_vertex) [[unlikely]]
+    {
+        return parse_error{.code = error_code::index_out_of_range};
+    }
+
+    return parse_error{.code = m_impl->read_positions(first_vertex, count, output)};
+}
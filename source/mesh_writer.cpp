@@ -0,0 +1,232 @@
+#include "tml/mesh_writer.hpp"
+
+#include "parallel.hpp" // tml::detail::thread_count
+#include "ply_format.hpp" // tml::detail::format_ply_header, tml::detail::format_ply_vertices, tml::detail::format_ply_faces
+#include "writer.hpp" // tml::detail::block_writer
+
+#include <algorithm> // std::ranges::any_of
+#include <cstdint> // std::uint32_t
+#include <fstream> // std::ifstream, std::ofstream
+#include <limits> // std::numeric_limits
+#include <memory> // std::make_unique
+#include <span> // std::span
+#include <system_error> // std::error_code
+#include <utility> // std::move
+#include <vector> // std::vector
+
+using tml::error_code;
+using tml::face;
+using tml::mesh_batch;
+using tml::mesh_writer;
+using tml::write_error;
+
+struct mesh_writer::impl
+{
+    std::ofstream file;
+    tml::detail::block_writer writer{file};
+    bool binary{false};
+    std::size_t threads{1UL};
+    std::size_t vertex_count{0UL};
+    std::size_t face_count{0UL};
+    std::size_t vertices_written{0UL};
+    std::size_t faces_written{0UL};
+    error_code error{error_code::none};
+
+    // Faces received before the last vertex, already encoded as they will appear in the output.
+    std::filesystem::path spill_path;
+    std::ofstream spill;
+    tml::detail::block_writer spill_writer{spill};
+
+    auto write_faces(std::ostream& stream, tml::detail::block_writer& faces_writer, std::span<face const> const faces) -> void
+    {
+        if (binary)
+        {
+            faces_writer.flush();
+            tml::detail::write_binary_ply_faces(stream, faces);
+        }
+        else
+        {
+            tml::detail::format_ply_faces(faces_writer, faces, {}, threads);
+        }
+    }
+
+    auto write(mesh_batch const& batch) -> error_code
+    {
+        std::size_t const batch_vertices = batch.vertex_count();
+
+        if ((batch_vertices != 0UL && batch.first_vertex != vertices_written) ||
+            (!batch.faces.empty() && batch.first_face != faces_written) || batch_vertices > vertex_count - vertices_written ||
+            batch.faces.size() > face_count - faces_written) [[unlikely]]
+        {
+            return error_code::invalid_data;
+        }
+
+        if (std::ranges::any_of(batch.faces, [this](face const& face) -> bool {
+                return std::ranges::any_of(face.indices(), [this](auto const index) -> bool { return index >= vertex_count; });
+            })) [[unlikely]]
+        {
+            return error_code::invalid_data;
+        }
+
+        if (binary)
+        {
+            writer.flush();
+
+            // Batches hold native-endian packed float triplets, which is the vertex block of the file.
+            auto const* const bytes = reinterpret_cast<char const*>( // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                batch.positions.data());
+            file.write(bytes, static_cast<std::streamsize>(batch.positions.size() * sizeof(float)));
+        }
+        else
+        {
+            tml::detail::format_ply_vertices(writer, batch.positions, {}, {}, threads);
+        }
+
+        vertices_written += batch_vertices;
+
+        if (batch.faces.empty())
+        {
+            return file ? error_code::none : error_code::unknown_io_error;
+        }
+
+        if (vertices_written == vertex_count && !spill.is_open())
+        {
+            write_faces(file, writer, batch.faces);
+        }
+        else
+        {
+            if (!spill.is_open())
+            {
+                spill.open(spill_path, std::ios_base::binary | std::ios_base::trunc);
+            }
+
+            write_faces(spill, spill_writer, batch.faces);
+        }
+
+        faces_written += batch.faces.size();
+
+        return file && spill ? error_code::none : error_code::unknown_io_error;
+    }
+
+    auto close() -> error_code
+    {
+        if (error == error_code::none && (vertices_written != vertex_count || faces_written != face_count)) [[unlikely]]
+        {
+            error = error_code::invalid_data;
+        }
+
+        writer.flush();
+
+        if (spill.is_open())
+        {
+            spill_writer.flush();
+            spill.close();
+
+            if (error == error_code::none)
+            {
+                std::ifstream faces{spill_path, std::ios_base::binary};
+                std::vector<char> block(tml::detail::block_writer::block_size);
+
+                while (faces && file)
+                {
+                    faces.read(block.data(), static_cast<std::streamsize>(block.size()));
+                    file.write(block.data(), faces.gcount());
+                }
+            }
+
+            std::error_code ec;
+            std::filesystem::remove(spill_path, ec);
+        }
+
+        file.close();
+
+        return error == error_code::none && !file ? error_code::unknown_io_error : error;
+    }
+};
+
+mesh_writer::mesh_writer() noexcept = default;
+
+mesh_writer::mesh_writer(mesh_writer&& other) noexcept = default;
+
+mesh_writer::~mesh_writer() { close(); }
+
+auto mesh_writer::operator=(mesh_writer&& other) noexcept -> mesh_writer&
+{
+    if (this != &other)
+    {
+        close();
+        m_impl = std::move(other.m_impl);
+    }
+
+    return *this;
+}
+
+auto mesh_writer::open(std::filesystem::path const& filepath, std::size_t const vertex_count, std::size_t const face_count,
+                       write_options const& options) noexcept -> write_error
+{
+    close();
+
+    if (filepath.extension() != ".ply") [[unlikely]]
+    {
+        return write_error{.code = error_code::unsupported_format};
+    }
+
+    if (!options.can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    {
+        return write_error{.code = error_code::file_already_exists};
+    }
+
+    bool const binary = options.encoding == encoding::binary;
+
+    if (binary && vertex_count > std::numeric_limits<std::uint32_t>::max()) [[unlikely]]
+    {
+        return write_error{.code = error_code::invalid_data};
+    }
+
+    auto state = std::make_unique<impl>();
+    state->file.open(filepath, binary ? std::ios_base::binary : std::ios_base::openmode{});
+
+    if (!state->file) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
+                                                 : write_error{.code = error_code::file_not_found};
+    }
+
+    state->binary = binary;
+    state->threads = tml::detail::thread_count(options.threads);
+    state->vertex_count = vertex_count;
+    state->face_count = face_count;
+    state->spill_path = std::filesystem::path{filepath} += ".faces.tmp";
+    tml::detail::format_ply_header(state->writer, binary, vertex_count, face_count);
+    m_impl = std::move(state);
+
+    return write_error{.code = error_code::none};
+}
+
+auto mesh_writer::write(mesh_batch const& batch) noexcept -> write_error
+{
+    if (!m_impl) [[unlikely]]
+    {
+        return write_error{.code = error_code::unknown_io_error};
+    }
+
+    if (m_impl->error == error_code::none)
+    {
+        m_impl->error = m_impl->write(batch);
+    }
+
+    return write_error{.code = m_impl->error};
+}
+
+auto mesh_writer::close() noexcept -> write_error
+{
+    if (!m_impl)
+    {
+        return write_error{.code = error_code::none};
+    }
+
+    auto const error = m_impl->close();
+    m_impl.reset();
+
+    return write_error{.code = error};
+}
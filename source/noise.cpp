@@ -0,0 +1,59 @@
+#include "noise.hpp" // tml::detail::add_noise, tml::detail::random_seed
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <vector> // std::vector
+
+using tml::mesh;
+
+namespace
+{
+    // Below this many coordinates per thread, spawning threads costs more than drawing the noise.
+    constexpr std::size_t noise_grain{1UL << 18U};
+} // namespace
+
+auto mesh::noise(float coefficient) noexcept -> mesh& { return noise(coefficient, detail::random_seed()); }
+
+auto mesh::noise(float coefficient, std::uint64_t seed, std::size_t threads) noexcept -> mesh&
+{
+    float* const positions = m_positions.data();
+
+    detail::parallel_for(m_positions.size(), detail::thread_count(threads), noise_grain,
+                         [positions, coefficient, seed](std::size_t const begin, std::size_t const end) -> void {
+                             detail::add_noise(positions + begin, end - begin, begin, seed, coefficient);
+                         });
+
+    invalidate_positions();
+
+    return *this;
+}
+
+auto mesh::noise_along_normals(float coefficient, std::uint64_t seed, std::size_t threads) noexcept -> mesh&
+{
+    std::size_t const vertex_count = m_positions.size() / 3;
+    auto const normals = vertex_normals(normal_weighting::area, threads);
+    float* const positions = m_positions.data();
+
+    detail::parallel_for(vertex_count, detail::thread_count(threads), noise_grain / 3UL,
+                         [positions, normals, coefficient, seed](std::size_t const begin, std::size_t const end) -> void {
+                             // The offsets of the whole range are drawn at once, then applied along the unit normals, which
+                             // are null for the vertices without a face.
+                             std::vector<float> offsets(end - begin, 0.0F);
+                             detail::add_noise(offsets.data(), offsets.size(), begin, seed, coefficient);
+
+                             for (std::size_t vertex{begin}; vertex < end; ++vertex)
+                             {
+                                 float const* const normal = normals.data() + vertex * 3;
+                                 float const offset = offsets[vertex - begin];
+                                 positions[vertex * 3] += offset * normal[0];
+                                 positions[vertex * 3 + 1] += offset * normal[1];
+                                 positions[vertex * 3 + 2] += offset * normal[2];
+                             }
+                         });
+
+    invalidate_positions();
+
+    return *this;
+}
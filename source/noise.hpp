@@ -0,0 +1,131 @@
+#pragma once
+
+#include "cpu.hpp" // TML_X86_64
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <random> // std::random_device
+
+#if TML_X86_64
+#include <immintrin.h> // __m128, __m128i and their intrinsics
+#endif
+
+// Counter-based noise: the value drawn for a counter only depends on that counter and on the seed, so that any range of
+// counters can be generated on its own, by any thread and in any order, and always gives the same values.
+namespace tml::detail
+{
+    // Seed of the calls that do not provide one.
+    [[nodiscard]] inline auto random_seed() -> std::uint64_t
+    {
+        std::random_device device;
+        std::uint64_t const high = device();
+
+        return (high << 32U) | device();
+    }
+
+    // Integer hash with good avalanche made of two xor-shift-multiply rounds, a bijection of the 32 bits integers.
+    [[nodiscard]] constexpr auto mix32(std::uint32_t value) noexcept -> std::uint32_t
+    {
+        value ^= value >> 16U;
+        value *= 0x7FEB352DU;
+        value ^= value >> 15U;
+        value *= 0x846CA68BU;
+        value ^= value >> 16U;
+
+        return value;
+    }
+
+    // Keys of the counters sharing their upper 32 bits, so that the hash only runs on 32 bits lanes.
+    struct noise_key
+    {
+        std::uint32_t first{0U};
+        std::uint32_t second{0U};
+    };
+
+    [[nodiscard]] constexpr auto make_noise_key(std::uint64_t const seed, std::uint64_t const counter) noexcept -> noise_key
+    {
+        auto const high = static_cast<std::uint32_t>(counter >> 32U);
+        std::uint32_t const first =
+            mix32(static_cast<std::uint32_t>(seed) ^ mix32(static_cast<std::uint32_t>(seed >> 32U) ^ high));
+
+        return {first, mix32(first ^ 0x9E3779B9U)};
+    }
+
+    // Uniform value in [-amplitude, amplitude) drawn from the low 32 bits of a counter.
+    [[nodiscard]] constexpr auto noise_value(noise_key const key, std::uint32_t const counter, float const amplitude) noexcept
+        -> float
+    {
+        std::uint32_t const bits = mix32(mix32(counter ^ key.first) + key.second);
+        float const unit = static_cast<float>(bits >> 8U) * 0x1p-24F;
+
+        return amplitude * (unit * 2.0F - 1.0F);
+    }
+
+#if TML_X86_64
+    // SSE2 has no 32 bits lane multiplication, it is made of two 32 x 32 -> 64 bits ones on the even and odd lanes.
+    [[nodiscard]] inline auto multiply(__m128i const lhs, __m128i const rhs) noexcept -> __m128i
+    {
+        __m128i const even = _mm_mul_epu32(lhs, rhs);
+        __m128i const odd = _mm_mul_epu32(_mm_srli_si128(lhs, 4), _mm_srli_si128(rhs, 4));
+
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    [[nodiscard]] inline auto mix32(__m128i value) noexcept -> __m128i
+    {
+        value = _mm_xor_si128(value, _mm_srli_epi32(value, 16));
+        value = multiply(value, _mm_set1_epi32(0x7FEB352D));
+        value = _mm_xor_si128(value, _mm_srli_epi32(value, 15));
+        value = multiply(value, _mm_set1_epi32(static_cast<int>(0x846CA68BU)));
+
+        return _mm_xor_si128(value, _mm_srli_epi32(value, 16));
+    }
+#endif
+
+    // Adds noise_value(counter) to values[i] for the counters first_counter + i. The SIMD path computes the very same
+    // floats as noise_value, four counters at a time.
+    inline auto add_noise(float* values, std::size_t const count, std::uint64_t const first_counter, std::uint64_t const seed,
+                          float const amplitude) noexcept -> void
+    {
+        std::size_t done{0UL};
+
+        while (done < count)
+        {
+            // Counters are processed by runs sharing their upper 32 bits, hence their key.
+            std::uint64_t const counter = first_counter + done;
+            std::uint64_t const run_end = (counter | 0xFFFFFFFFULL) + 1ULL;
+            std::size_t const run = run_end - counter < count - done ? static_cast<std::size_t>(run_end - counter) : count - done;
+            noise_key const key = make_noise_key(seed, counter);
+            auto const low = static_cast<std::uint32_t>(counter);
+            float* const output = values + done;
+            std::size_t idx{0UL};
+
+#if TML_X86_64
+            __m128i const first = _mm_set1_epi32(static_cast<int>(key.first));
+            __m128i const second = _mm_set1_epi32(static_cast<int>(key.second));
+            __m128 const scale = _mm_set1_ps(0x1p-24F);
+            __m128 const two = _mm_set1_ps(2.0F);
+            __m128 const one = _mm_set1_ps(1.0F);
+            __m128 const factor = _mm_set1_ps(amplitude);
+
+            for (; idx + 4UL <= run; idx += 4UL)
+            {
+                auto const base = static_cast<int>(low + static_cast<std::uint32_t>(idx));
+                __m128i const counters = _mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3));
+                __m128i const bits = mix32(_mm_add_epi32(mix32(_mm_xor_si128(counters, first)), second));
+                __m128 const unit = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 8)), scale);
+                __m128 const noise = _mm_mul_ps(factor, _mm_sub_ps(_mm_mul_ps(unit, two), one));
+                _mm_storeu_ps(output + idx, _mm_add_ps(_mm_loadu_ps(output + idx), noise));
+            }
+#endif
+
+            for (; idx < run; ++idx)
+            {
+                output[idx] += noise_value(key, low + static_cast<std::uint32_t>(idx), amplitude);
+            }
+
+            done += run;
+        }
+    }
+} // namespace tml::detail
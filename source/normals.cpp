@@ -0,0 +1,245 @@
+#include "cpu.hpp" // TML_X86_64
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <array> // std::array
+#include <cmath> // std::sqrt, std::atan2
+#include <span> // std::span
+#include <vector> // std::vector
+
+#if TML_X86_64
+#include <emmintrin.h> // __m128 and the SSE2 intrinsics
+#endif
+
+using tml::face;
+using tml::mesh;
+using tml::normal_weighting;
+
+namespace
+{
+    constexpr std::size_t normal_grain{1UL << 14U};
+
+    // Writes the unit normal (v2 - v1) x (v3 - v1) / |(v2 - v1) x (v3 - v1)| of each face, or zero when the cross product
+    // is null. Both kernels evaluate it with the same float operations, so they give identical normals.
+    using face_normal_kernel = auto (*)(float const* positions, std::span<face const> faces, float* normals) noexcept -> void;
+
+    auto face_normals_scalar(float const* positions, std::span<face const> const faces, float* normals) noexcept -> void
+    {
+        for (auto const& face : faces)
+        {
+            auto const [index_v1, index_v2, index_v3] = face.indices();
+            float const* const v1 = positions + std::size_t{index_v1} * 3;
+            float const* const v2 = positions + std::size_t{index_v2} * 3;
+            float const* const v3 = positions + std::size_t{index_v3} * 3;
+            float const e1x = v2[0] - v1[0];
+            float const e1y = v2[1] - v1[1];
+            float const e1z = v2[2] - v1[2];
+            float const e2x = v3[0] - v1[0];
+            float const e2y = v3[1] - v1[1];
+            float const e2z = v3[2] - v1[2];
+            float const cx = e1y * e2z - e1z * e2y;
+            float const cy = e1z * e2x - e1x * e2z;
+            float const cz = e1x * e2y - e1y * e2x;
+            float const length = std::sqrt(cx * cx + cy * cy + cz * cz);
+            bool const valid = length > 0.0F;
+            *normals++ = valid ? cx / length : 0.0F;
+            *normals++ = valid ? cy / length : 0.0F;
+            *normals++ = valid ? cz / length : 0.0F;
+        }
+    }
+
+#if TML_X86_64
+    // SSE2 is part of the x86-64 baseline: corners are loaded lane by lane, four faces are computed at a time and their
+    // normals transposed back to triplets.
+    auto face_normals_sse(float const* positions, std::span<face const> const faces, float* normals) noexcept -> void
+    {
+        static constexpr std::size_t lanes{4UL};
+        std::size_t const vector_count = faces.size() - faces.size() % lanes;
+        std::array<std::array<float const*, lanes>, 3UL> corners{};
+
+        for (std::size_t first{0UL}; first < vector_count; first += lanes)
+        {
+            for (std::size_t lane{0UL}; lane < lanes; ++lane)
+            {
+                auto const& indices = faces[first + lane].indices();
+                corners[0][lane] = positions + std::size_t{indices[0]} * 3;
+                corners[1][lane] = positions + std::size_t{indices[1]} * 3;
+                corners[2][lane] = positions + std::size_t{indices[2]} * 3;
+            }
+
+            auto const load = [&corners](std::size_t const corner, std::size_t const axis) -> __m128 {
+                auto const& lane = corners[corner];
+                return _mm_setr_ps(lane[0][axis], lane[1][axis], lane[2][axis], lane[3][axis]);
+            };
+
+            __m128 const x1 = load(0UL, 0UL);
+            __m128 const y1 = load(0UL, 1UL);
+            __m128 const z1 = load(0UL, 2UL);
+            __m128 const e1x = _mm_sub_ps(load(1UL, 0UL), x1);
+            __m128 const e1y = _mm_sub_ps(load(1UL, 1UL), y1);
+            __m128 const e1z = _mm_sub_ps(load(1UL, 2UL), z1);
+            __m128 const e2x = _mm_sub_ps(load(2UL, 0UL), x1);
+            __m128 const e2y = _mm_sub_ps(load(2UL, 1UL), y1);
+            __m128 const e2z = _mm_sub_ps(load(2UL, 2UL), z1);
+            __m128 const cx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y));
+            __m128 const cy = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z));
+            __m128 const cz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x));
+            __m128 const length =
+                _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz)));
+            __m128 const valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+
+            __m128 const nx = _mm_and_ps(valid, _mm_div_ps(cx, length));
+            __m128 const ny = _mm_and_ps(valid, _mm_div_ps(cy, length));
+            __m128 const nz = _mm_and_ps(valid, _mm_div_ps(cz, length));
+            // Transposed to x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3.
+            __m128 const xy_low = _mm_unpacklo_ps(nx, ny);  // x0 y0 x1 y1
+            __m128 const xy_high = _mm_unpackhi_ps(nx, ny); // x2 y2 x3 y3
+            __m128 const zx_low = _mm_shuffle_ps(nz, nx, _MM_SHUFFLE(1, 1, 0, 0));  // z0 z0 x1 x1
+            __m128 const yz = _mm_shuffle_ps(xy_low, nz, _MM_SHUFFLE(1, 1, 3, 3));   // y1 y1 z1 z1
+            __m128 const zx_high = _mm_shuffle_ps(nz, nx, _MM_SHUFFLE(3, 3, 2, 2)); // z2 z2 x3 x3
+            __m128 const yz_high = _mm_shuffle_ps(ny, nz, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+            float* const output = normals + first * 3;
+            _mm_storeu_ps(output, _mm_shuffle_ps(xy_low, zx_low, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(output + 4, _mm_shuffle_ps(yz, xy_high, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(output + 8, _mm_shuffle_ps(zx_high, yz_high, _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        face_normals_scalar(positions, faces.subspan(vector_count), normals + vector_count * 3);
+    }
+#endif
+
+    [[nodiscard]] auto select_face_normal_kernel() noexcept -> face_normal_kernel
+    {
+#if TML_X86_64
+        return face_normals_sse;
+#else
+        return face_normals_scalar;
+#endif
+    }
+
+    // Angle of the corner of a face at p between the edges towards q and r.
+    [[nodiscard]] auto corner_angle(float const* p, float const* q, float const* r) noexcept -> float
+    {
+        float const ax = q[0] - p[0];
+        float const ay = q[1] - p[1];
+        float const az = q[2] - p[2];
+        float const bx = r[0] - p[0];
+        float const by = r[1] - p[1];
+        float const bz = r[2] - p[2];
+        float const cx = ay * bz - az * by;
+        float const cy = az * bx - ax * bz;
+        float const cz = ax * by - ay * bx;
+
+        return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), ax * bx + ay * by + az * bz);
+    }
+} // namespace
+
+auto mesh::face_normals(std::size_t const threads) const noexcept -> std::span<float const>
+{
+    return m_face_normals.get([this, threads](std::vector<float>& normals) -> void {
+        face_normal_kernel const kernel = select_face_normal_kernel();
+        normals.resize(m_faces.size() * 3);
+
+        detail::parallel_for(m_faces.size(), detail::thread_count(threads), normal_grain,
+                             [this, kernel, &normals](std::size_t const begin, std::size_t const end) -> void {
+                                 kernel(m_positions.data(), std::span{m_faces}.subspan(begin, end - begin),
+                                        normals.data() + begin * 3);
+                             });
+    });
+}
+
+auto mesh::vertex_normals(normal_weighting const weighting, std::size_t const threads) const noexcept -> std::span<float const>
+{
+    auto const& cache = weighting == normal_weighting::area ? m_area_vertex_normals : m_angle_vertex_normals;
+
+    return cache.get([this, weighting, threads](std::vector<float>& normals) -> void {
+        compute_vertex_normals(normals, weighting, threads);
+    });
+}
+
+auto mesh::compute_vertex_normals(std::vector<float>& vertex_normals, normal_weighting const weighting,
+                                  std::size_t const threads) const noexcept -> void
+{
+    std::size_t const thread_count = detail::thread_count(threads);
+    std::size_t const vertex_count = m_positions.size() / 3;
+    std::size_t const corner_count = m_faces.size() * 3;
+    auto const normals = face_normals(thread_count);
+
+    // Weight of each corner, face by face.
+    std::vector<float> weights(corner_count);
+
+    if (weighting == normal_weighting::area)
+    {
+        std::vector<float> areas(m_faces.size());
+        area_per_face(areas, thread_count);
+
+        for (std::size_t idx{0UL}; idx < m_faces.size(); ++idx)
+        {
+            weights[idx * 3] = weights[idx * 3 + 1] = weights[idx * 3 + 2] = areas[idx];
+        }
+    }
+    else
+    {
+        detail::parallel_for(m_faces.size(), thread_count, normal_grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const [index_v1, index_v2, index_v3] = m_faces[idx].indices();
+                float const* const v1 = m_positions.data() + std::size_t{index_v1} * 3;
+                float const* const v2 = m_positions.data() + std::size_t{index_v2} * 3;
+                float const* const v3 = m_positions.data() + std::size_t{index_v3} * 3;
+                weights[idx * 3] = corner_angle(v1, v2, v3);
+                weights[idx * 3 + 1] = corner_angle(v2, v3, v1);
+                weights[idx * 3 + 2] = corner_angle(v3, v1, v2);
+            }
+        });
+    }
+
+    // Corners grouped by vertex in face order, so that each vertex gathers its faces in the same order whatever the number
+    // of threads and gets the same normal.
+    std::vector<std::size_t> offsets(vertex_count + 1, 0UL);
+
+    for (auto const& face : m_faces)
+    {
+        for (auto const index : face.indices())
+        {
+            ++offsets[std::size_t{index} + 1];
+        }
+    }
+
+    for (std::size_t vertex{1UL}; vertex <= vertex_count; ++vertex)
+    {
+        offsets[vertex] += offsets[vertex - 1];
+    }
+
+    std::vector<std::size_t> corners(corner_count);
+    std::vector<std::size_t> cursors(offsets.begin(), offsets.end() - 1);
+
+    for (std::size_t corner{0UL}; corner < corner_count; ++corner)
+    {
+        corners[cursors[m_faces[corner / 3].indices()[corner % 3]]++] = corner;
+    }
+
+    vertex_normals.resize(m_positions.size());
+
+    detail::parallel_for(vertex_count, thread_count, normal_grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            std::array<float, 3> sum{};
+
+            for (std::size_t slot{offsets[vertex]}; slot < offsets[vertex + 1]; ++slot)
+            {
+                std::size_t const corner = corners[slot];
+                float const* const normal = normals.data() + corner / 3 * 3;
+                sum[0] += weights[corner] * normal[0];
+                sum[1] += weights[corner] * normal[1];
+                sum[2] += weights[corner] * normal[2];
+            }
+
+            float const length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+            bool const valid = length > 0.0F;
+            vertex_normals[vertex * 3] = valid ? sum[0] / length : 0.0F;
+            vertex_normals[vertex * 3 + 1] = valid ? sum[1] / length : 0.0F;
+            vertex_normals[vertex * 3 + 2] = valid ? sum[2] / length : 0.0F;
+        }
+    });
+}
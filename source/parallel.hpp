@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm> // std::max, std::min
+#include <cstddef> // std::size_t
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+namespace tml::detail
+{
+    // Resolves a user-provided thread count, 0 meaning one thread per hardware thread.
+    [[nodiscard]] inline auto thread_count(std::size_t const requested) noexcept -> std::size_t
+    {
+        return requested != 0UL ? requested : std::max<std::size_t>(1UL, std::thread::hardware_concurrency());
+    }
+
+    // Splits [0, count) into at most `threads` contiguous ranges of at least `grain` elements and calls fn(begin, end) on
+    // each of them concurrently. The last range runs on the calling thread.
+    template <typename F>
+    auto parallel_for(std::size_t const count, std::size_t const threads, std::size_t const grain, F const& fn) -> void
+    {
+        std::size_t const workers = std::max<std::size_t>(1UL, std::min(threads, count / std::max<std::size_t>(grain, 1UL)));
+
+        if (workers == 1UL)
+        {
+            fn(std::size_t{0UL}, count);
+            return;
+        }
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1UL);
+        std::size_t const chunk = count / workers;
+        std::size_t const remainder = count % workers;
+        std::size_t begin{0UL};
+
+        for (std::size_t worker{0UL}; worker + 1UL < workers; ++worker)
+        {
+            std::size_t const end = begin + chunk + (worker < remainder ? 1UL : 0UL);
+            pool.emplace_back([&fn, begin, end]() -> void { fn(begin, end); });
+            begin = end;
+        }
+
+        fn(begin, count);
+
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    }
+} // namespace tml::detail
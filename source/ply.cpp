@@ -0,0 +1,474 @@
+#include "ascii.hpp" // tml::detail::parse_number, tml::detail::next_line, tml::detail::skip_spaces
+#include "mapped_file.hpp" // tml::detail::mapped_file
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "ply_format.hpp" // tml::detail::parse_ply_header, tml::detail::format_ply_header, tml::detail::is_normal_channel
+#include "stats.hpp" // tml::detail::scoped_timer
+#include "tml/mesh.hpp"
+#include "writer.hpp" // tml::detail::block_writer
+
+#include <algorithm> // std::count, std::min, std::ranges::find, std::ranges::none_of
+#include <cstdint> // std::uint32_t
+#include <cstring> // std::memcpy
+#include <fstream> // std::ofstream
+#include <numeric> // std::exclusive_scan
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <utility> // std::move
+#include <vector> // std::vector, std::erase_if
+
+using tml::face;
+using tml::mesh;
+using tml::stat;
+using tml::attribute_channel;
+using tml::detail::face_layout;
+using tml::detail::ply_format;
+using tml::detail::ply_header;
+using tml::detail::ply_property;
+using tml::detail::vertex_layout;
+
+namespace
+{
+    // Where the decoders store a body: the new positions and faces, and the first byte of each new attribute channel.
+    struct ply_destination
+    {
+        std::span<float> positions;
+        std::span<face> faces;
+        std::span<char* const> vertex_channels;
+        std::span<char* const> face_channels;
+
+        // Number of vertices of the mesh before the file, added to every corner.
+        tml::index_type first_vertex;
+    };
+
+    // One channel per property, sized for count elements, and the first byte of each in bases.
+    auto make_channels(std::span<ply_property const> const properties, std::size_t const count, std::vector<char*>& bases)
+        -> std::vector<attribute_channel>
+    {
+        std::vector<attribute_channel> channels;
+        channels.reserve(properties.size());
+
+        for (auto const& property : properties)
+        {
+            auto& channel =
+                channels.emplace_back(std::string{property.name}, tml::detail::to_attribute_type(property.type), count);
+            bases.push_back(static_cast<char*>(channel.data()));
+        }
+
+        return channels;
+    }
+
+    // Keeps the channels of the mesh the file also has with the same type, so that every channel covers all the elements,
+    // or takes those of the file when the mesh had no element before.
+    auto merge_channels(std::vector<attribute_channel>& channels, std::vector<attribute_channel>&& loaded, bool const replace)
+        -> void
+    {
+        if (replace)
+        {
+            channels = std::move(loaded);
+            return;
+        }
+
+        std::erase_if(channels, [&loaded](attribute_channel& channel) -> bool {
+            auto const match = std::ranges::find(loaded, channel.name(), &attribute_channel::name);
+            return match == loaded.end() || !channel.append(*match);
+        });
+    }
+
+    auto parse_ascii_body(std::string_view const body, ply_header const& header, vertex_layout const& layout,
+                          face_layout const& faces_layout, ply_destination const& destination) noexcept -> tml::error_code
+    {
+        using tml::error_code;
+        char const* cursor = body.data();
+        char const* const end = body.data() + body.size();
+
+        {
+            tml::detail::scoped_timer const timer{tml::stat::vertex_body_time};
+
+            for (std::size_t vertex{0UL}; vertex < header.vertex_count; ++vertex)
+            {
+                if (!tml::detail::parse_ascii_vertex(cursor, end, layout, destination.positions.data() + vertex * 3,
+                                                     destination.vertex_channels, vertex)) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+            }
+        }
+
+        tml::detail::scoped_timer const timer{tml::stat::face_body_time};
+
+        for (std::size_t index{0UL}; index < header.face_count; ++index)
+        {
+            auto const error = tml::detail::parse_ascii_face(cursor, end, faces_layout, header.vertex_count,
+                                                             destination.faces[index], destination.face_channels, index,
+                                                             destination.first_vertex);
+
+            if (error != error_code::none) [[unlikely]]
+            {
+                return error;
+            }
+        }
+
+        return error_code::none;
+    }
+
+    // Line-oriented parse of the ASCII body, split in newline-aligned chunks parsed concurrently. Each chunk first counts
+    // its lines so that it knows which vertex or face its first line holds. It only accepts the layout written by the
+    // common exporters (one element per line, no blank line) and returns false on anything else, in which case the caller
+    // falls back to parse_ascii_body, so both paths always produce the same mesh and the same errors.
+    [[nodiscard]] auto parse_ascii_body_parallel(std::string_view const body, ply_header const& header,
+                                                 vertex_layout const& layout, face_layout const& faces_layout,
+                                                 ply_destination const& destination, std::size_t const threads) -> bool
+    {
+        static constexpr std::size_t min_chunk_size{1UL << 16U};
+        std::size_t const chunk_count = std::min(threads * 4UL, body.size() / min_chunk_size);
+
+        if (chunk_count < 2UL)
+        {
+            return false;
+        }
+
+        std::vector<std::string_view> chunks;
+        chunks.reserve(chunk_count);
+
+        for (std::string_view remaining{body}; !remaining.empty();)
+        {
+            std::size_t const target = std::min(remaining.size(), body.size() / chunk_count);
+            std::size_t const newline = remaining.find('\n', target == 0UL ? 0UL : target - 1UL);
+            std::size_t const size = newline == std::string_view::npos ? remaining.size() : newline + 1UL;
+            chunks.push_back(remaining.substr(0UL, size));
+            remaining.remove_prefix(size);
+        }
+
+        std::vector<std::size_t> first_lines(chunks.size() + 1UL, 0UL);
+
+        tml::detail::parallel_for(chunks.size(), threads, 1UL, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t chunk{begin}; chunk < end; ++chunk)
+            {
+                first_lines[chunk] = static_cast<std::size_t>(std::count(chunks[chunk].begin(), chunks[chunk].end(), '\n'));
+            }
+        });
+
+        if (!chunks.back().ends_with('\n'))
+        {
+            ++first_lines[chunks.size() - 1UL];
+        }
+
+        std::exclusive_scan(first_lines.begin(), first_lines.end(), first_lines.begin(), 0UL);
+
+        std::size_t const vertex_count = header.vertex_count;
+        std::size_t const element_count = vertex_count + header.face_count;
+
+        if (first_lines.back() < element_count)
+        {
+            return false;
+        }
+
+        std::vector<char> succeeded(chunks.size(), 1);
+
+        // The vertices and the faces are parsed in two passes so that each gets its own timer. The chunk holding the last
+        // vertices and the first faces is gone through by both, each skipping the lines of the other.
+        auto const parse_lines = [&](std::size_t const first_element, std::size_t const last_element) -> void {
+            tml::detail::parallel_for(chunks.size(), threads, 1UL, [&](std::size_t const begin, std::size_t const end) {
+                for (std::size_t chunk{begin}; chunk < end; ++chunk)
+                {
+                    if (first_lines[chunk] >= last_element || first_lines[chunk + 1UL] <= first_element)
+                    {
+                        continue;
+                    }
+
+                    std::string_view remaining{chunks[chunk]};
+                    bool valid{true};
+
+                    for (std::size_t line_index = first_lines[chunk];
+                         valid && !remaining.empty() && line_index < last_element; ++line_index)
+                    {
+                        auto const line = tml::detail::next_line(remaining);
+                        char const* cursor = line.data();
+                        char const* const line_end = line.data() + line.size();
+
+                        if (line_index < first_element)
+                        {
+                            continue;
+                        }
+
+                        if (line_index < vertex_count)
+                        {
+                            valid = tml::detail::parse_ascii_vertex(cursor, line_end, layout,
+                                                                    destination.positions.data() + line_index * 3,
+                                                                    destination.vertex_channels, line_index);
+                        }
+                        else
+                        {
+                            std::size_t const index = line_index - vertex_count;
+                            valid = tml::detail::parse_ascii_face(cursor, line_end, faces_layout, vertex_count,
+                                                                  destination.faces[index], destination.face_channels, index,
+                                                                  destination.first_vertex) == tml::error_code::none;
+                        }
+
+                        valid = valid && tml::detail::skip_spaces(cursor, line_end) == line_end;
+                    }
+
+                    succeeded[chunk] = static_cast<char>(succeeded[chunk] != 0 && valid);
+                }
+            });
+        };
+
+        {
+            tml::detail::scoped_timer const timer{tml::stat::vertex_body_time};
+            parse_lines(0UL, vertex_count);
+        }
+
+        {
+            tml::detail::scoped_timer const timer{tml::stat::face_body_time};
+            parse_lines(vertex_count, element_count);
+        }
+
+        return std::ranges::none_of(succeeded, [](char const value) -> bool { return value == 0; });
+    }
+
+    // Whether the body is long enough for the records the header declares, so that a forged count fails before anything
+    // is allocated for it. ASCII records take at least "0 0 0" and "3 0 1 2" and a line break, except for the last one.
+    [[nodiscard]] auto fits_body(std::string_view const body, ply_header const& header, vertex_layout const& layout,
+                                 face_layout const& faces_layout) noexcept -> bool
+    {
+        bool const ascii = header.format == ply_format::ascii;
+        std::size_t const size = body.size() + (ascii ? 1UL : 0UL);
+        std::size_t const vertex_size = ascii ? 6UL : layout.stride;
+        std::size_t const face_size = ascii ? 8UL : tml::detail::min_binary_face_size(faces_layout);
+
+        if (size / vertex_size < header.vertex_count)
+        {
+            return false;
+        }
+
+        return face_size == 0UL || (size - header.vertex_count * vertex_size) / face_size >= header.face_count;
+    }
+
+    auto parse_binary_body(std::string_view const body, ply_header const& header, vertex_layout const& layout,
+                           face_layout const& faces_layout, ply_destination const& destination) noexcept -> tml::error_code
+    {
+        using tml::error_code;
+        bool const swap = tml::detail::swaps_bytes(header);
+        char const* cursor = body.data();
+        char const* const end = body.data() + body.size();
+
+        {
+            tml::detail::scoped_timer const timer{tml::stat::vertex_body_time};
+
+            if (tml::detail::is_native_xyz(header))
+            {
+                std::size_t const bytes = header.vertex_count * 3 * sizeof(float);
+
+                if (body.size() < bytes) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                std::memcpy(destination.positions.data(), cursor, bytes);
+                cursor += bytes;
+            }
+            else
+            {
+                if (body.size() / layout.stride < header.vertex_count) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                for (std::size_t vertex{0UL}; vertex < header.vertex_count; ++vertex, cursor += layout.stride)
+                {
+                    tml::detail::read_position(layout, cursor, swap, destination.positions.data() + vertex * 3);
+                    tml::detail::read_channels(layout, cursor, swap, destination.vertex_channels, vertex);
+                }
+            }
+        }
+
+        tml::detail::scoped_timer const timer{tml::stat::face_body_time};
+
+        for (std::size_t index{0UL}; index < header.face_count; ++index)
+        {
+            auto const error = tml::detail::parse_binary_face(cursor, end, faces_layout, header.vertex_count, swap,
+                                                              destination.faces[index], destination.face_channels, index,
+                                                              destination.first_vertex)
+                                   .value_or(error_code::invalid_data);
+
+            if (error != error_code::none) [[unlikely]]
+            {
+                return error;
+            }
+        }
+
+        return error_code::none;
+    }
+} // namespace
+
+auto mesh::load_from_ply(std::filesystem::path const& filepath, read_options const& options) noexcept -> parse_error
+{
+    detail::mapped_file file;
+
+    if (auto const error = file.open(filepath); error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = error};
+    }
+
+    ply_header header;
+    vertex_layout layout;
+    face_layout faces_layout;
+    auto header_error = error_code::none;
+
+    {
+        detail::scoped_timer const timer{stat::header_time};
+        header_error = detail::parse_ply_header(file.view(), header);
+
+        if (header_error == error_code::none)
+        {
+            header_error = detail::make_vertex_layout(header, layout);
+        }
+
+        if (header_error == error_code::none)
+        {
+            header_error = detail::make_face_layout(header, faces_layout);
+        }
+    }
+
+    if (header_error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = header_error};
+    }
+
+    std::size_t const first_coordinate = m_positions.size();
+    std::size_t const first_face = m_faces.size();
+    std::size_t const threads = detail::thread_count(options.threads);
+
+    if (header.vertex_count > max_vertex_count - first_coordinate / 3) [[unlikely]]
+    {
+        return parse_error{.code = error_code::index_out_of_range};
+    }
+
+    auto const body = file.view().substr(header.body_offset);
+
+    if (!fits_body(body, header, layout, faces_layout)) [[unlikely]]
+    {
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    invalidate_topology();
+
+    m_positions.resize(first_coordinate + header.vertex_count * 3);
+    m_faces.resize(first_face + header.face_count);
+
+    std::vector<char*> vertex_bases;
+    std::vector<char*> face_bases;
+    auto vertex_channels = make_channels(layout.channels, header.vertex_count, vertex_bases);
+    auto face_channels = make_channels(faces_layout.channels, header.face_count, face_bases);
+
+    ply_destination const destination{.positions = std::span{m_positions}.subspan(first_coordinate),
+                                      .faces = std::span{m_faces}.subspan(first_face),
+                                      .vertex_channels = vertex_bases,
+                                      .face_channels = face_bases,
+                                      .first_vertex = static_cast<index_type>(first_coordinate / 3)};
+    auto error = error_code::none;
+
+    if (header.format != ply_format::ascii)
+    {
+        error = parse_binary_body(body, header, layout, faces_layout, destination);
+    }
+    else if (threads == 1UL || !parse_ascii_body_parallel(body, header, layout, faces_layout, destination, threads))
+    {
+        error = parse_ascii_body(body, header, layout, faces_layout, destination);
+    }
+
+    if (error != error_code::none) [[unlikely]]
+    {
+        m_positions.resize(first_coordinate);
+        m_faces.resize(first_face);
+
+        return parse_error{.code = error};
+    }
+
+    merge_channels(m_vertex_attributes, std::move(vertex_channels), first_coordinate == 0UL);
+    merge_channels(m_face_attributes, std::move(face_channels), first_face == 0UL);
+
+    if (threads > 1UL)
+    {
+        static_cast<void>(adjacency(threads));
+    }
+
+    return parse_error{.code = error};
+}
+
+auto mesh::save_to_ply(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error
+{
+    if (!options.can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    {
+        return write_error{.code = error_code::file_already_exists};
+    }
+
+    bool const binary = options.encoding == encoding::binary;
+
+    if (binary && m_positions.size() / 3 > std::numeric_limits<std::uint32_t>::max()) [[unlikely]]
+    {
+        return write_error{.code = error_code::invalid_data};
+    }
+
+    std::ofstream file{filepath, binary ? std::ios_base::binary : std::ios_base::openmode{}};
+
+    if (!file) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
+                                                 : write_error{.code = error_code::file_not_found};
+    }
+
+    std::size_t const threads = detail::thread_count(options.threads);
+    auto const normals = options.store_normals ? vertex_normals(normal_weighting::area, threads) : std::span<float const>{};
+    std::vector<attribute_channel const*> vertex_channels;
+    std::vector<attribute_channel const*> face_channels;
+
+    if (options.store_attributes)
+    {
+        // Stored normals replace the channels they would otherwise duplicate.
+        for (auto const& channel : m_vertex_attributes)
+        {
+            if (!options.store_normals || !detail::is_normal_channel(channel.name()))
+            {
+                vertex_channels.push_back(&channel);
+            }
+        }
+
+        for (auto const& channel : m_face_attributes)
+        {
+            face_channels.push_back(&channel);
+        }
+    }
+
+    detail::block_writer writer{file};
+    detail::format_ply_header(writer, binary, m_positions.size() / 3, m_faces.size(), options.store_normals, vertex_channels,
+                              face_channels);
+
+    if (binary)
+    {
+        writer.flush();
+
+        if (options.store_normals || !vertex_channels.empty())
+        {
+            detail::write_binary_ply_vertices(file, m_positions, normals, vertex_channels);
+        }
+        else
+        {
+            // The in-memory positions already are the on-disk vertex block: native-endian packed float triplets.
+            file.write(reinterpret_cast<char const*>(m_positions.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                       static_cast<std::streamsize>(m_positions.size() * sizeof(float)));
+        }
+
+        detail::write_binary_ply_faces(file, m_faces, face_channels);
+    }
+    else
+    {
+        detail::format_ply_vertices(writer, m_positions, normals, vertex_channels, threads);
+        detail::format_ply_faces(writer, m_faces, face_channels, threads);
+        writer.flush();
+    }
+
+    return file ? write_error{.code = error_code::none} : write_error{.code = error_code::unknown_io_error};
+}
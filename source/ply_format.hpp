@@ -0,0 +1,895 @@
+#pragma once
+
+#include "ascii.hpp" // tml::detail::next_line, tml::detail::next_token, tml::detail::parse_number
+#include "binary.hpp" // tml::detail::load
+#include "tml/attribute.hpp" // tml::attribute_channel, tml::attribute_type
+#include "tml/error.hpp" // tml::error_code
+#include "tml/face.hpp" // tml::face
+#include "writer.hpp" // tml::detail::block_writer
+
+#include <algorithm> // std::min, std::reverse_copy, std::ranges::all_of, std::ranges::find_if
+#include <array> // std::array
+#include <bit> // std::endian
+#include <charconv> // std::from_chars
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t
+#include <cstring> // std::memcpy
+#include <fmt/format.h> // fmt::format_to
+#include <iterator> // std::back_inserter
+#include <optional> // std::optional
+#include <ostream> // std::ostream, std::streamsize
+#include <span> // std::span
+#include <string_view> // std::string_view
+#include <utility> // std::pair
+#include <vector> // std::vector
+
+// Header parsing and element encoding shared by the PLY loader, which reads a mapped file at once, and the streaming
+// reader and writer, which go through the file by blocks.
+namespace tml::detail
+{
+    enum class ply_format
+    {
+        ascii,
+        binary_little_endian,
+        binary_big_endian,
+    };
+
+    enum class ply_type
+    {
+        int8,
+        uint8,
+        int16,
+        uint16,
+        int32,
+        uint32,
+        float32,
+        float64,
+    };
+
+    struct ply_property
+    {
+        std::string_view name;
+        ply_type type{ply_type::float32};
+        bool is_list{false};
+        ply_type count_type{ply_type::uint8};
+    };
+
+    struct ply_header
+    {
+        ply_format format{ply_format::ascii};
+        std::size_t vertex_count{0UL};
+        std::size_t face_count{0UL};
+        std::vector<ply_property> vertex_properties;
+        std::vector<ply_property> face_properties;
+        std::size_t body_offset{0UL};
+    };
+
+    [[nodiscard]] inline auto parse_ply_type(std::string_view const name) noexcept -> std::optional<ply_type>
+    {
+        static constexpr std::array<std::pair<std::string_view, ply_type>, 16UL> names{{
+            {"char", ply_type::int8},     {"int8", ply_type::int8},       {"uchar", ply_type::uint8},
+            {"uint8", ply_type::uint8},   {"short", ply_type::int16},     {"int16", ply_type::int16},
+            {"ushort", ply_type::uint16}, {"uint16", ply_type::uint16},   {"int", ply_type::int32},
+            {"int32", ply_type::int32},   {"uint", ply_type::uint32},     {"uint32", ply_type::uint32},
+            {"float", ply_type::float32}, {"float32", ply_type::float32}, {"double", ply_type::float64},
+            {"float64", ply_type::float64},
+        }};
+
+        auto const it = std::ranges::find_if(names, [name](auto const& entry) -> bool { return entry.first == name; });
+
+        return it == names.end() ? std::nullopt : std::optional{it->second};
+    }
+
+    [[nodiscard]] constexpr auto size_of(ply_type const type) noexcept -> std::size_t
+    {
+        switch (type)
+        {
+        case ply_type::int8:
+        case ply_type::uint8:
+            return 1UL;
+        case ply_type::int16:
+        case ply_type::uint16:
+            return 2UL;
+        case ply_type::int32:
+        case ply_type::uint32:
+        case ply_type::float32:
+            return 4UL;
+        case ply_type::float64:
+            return 8UL;
+        }
+
+        return 0UL;
+    }
+
+    // Reads a binary scalar of the given PLY type and converts it to T.
+    template <typename T>
+    [[nodiscard]] auto read_as(ply_type const type, char const* source, bool const swap) noexcept -> T
+    {
+        switch (type)
+        {
+        case ply_type::int8:
+            return static_cast<T>(load<std::int8_t>(source, swap));
+        case ply_type::uint8:
+            return static_cast<T>(load<std::uint8_t>(source, swap));
+        case ply_type::int16:
+            return static_cast<T>(load<std::int16_t>(source, swap));
+        case ply_type::uint16:
+            return static_cast<T>(load<std::uint16_t>(source, swap));
+        case ply_type::int32:
+            return static_cast<T>(load<std::int32_t>(source, swap));
+        case ply_type::uint32:
+            return static_cast<T>(load<std::uint32_t>(source, swap));
+        case ply_type::float32:
+            return static_cast<T>(load<float>(source, swap));
+        case ply_type::float64:
+            return static_cast<T>(load<double>(source, swap));
+        }
+
+        return T{};
+    }
+
+    [[nodiscard]] constexpr auto is_floating_point(ply_type const type) noexcept -> bool
+    {
+        return type == ply_type::float32 || type == ply_type::float64;
+    }
+
+    [[nodiscard]] inline auto is_signed_negative(ply_type const type, char const* source, bool const swap) noexcept -> bool
+    {
+        switch (type)
+        {
+        case ply_type::int8:
+        case ply_type::int16:
+        case ply_type::int32:
+        case ply_type::float32:
+        case ply_type::float64:
+            return read_as<double>(type, source, swap) < 0.0;
+        default:
+            return false;
+        }
+    }
+
+    inline auto parse_ply_header(std::string_view const content, ply_header& header) noexcept -> error_code
+    {
+        std::string_view remaining{content};
+
+        if (next_line(remaining) != "ply") [[unlikely]]
+        {
+            return error_code::invalid_data;
+        }
+
+        std::vector<ply_property>* properties{nullptr};
+        bool has_vertices{false};
+        bool has_faces{false};
+
+        while (!remaining.empty())
+        {
+            auto line = next_line(remaining);
+            auto const keyword = next_token(line);
+
+            if (keyword == "end_header")
+            {
+                header.body_offset = content.size() - remaining.size();
+                return has_vertices ? error_code::none : error_code::invalid_data;
+            }
+
+            if (keyword == "format")
+            {
+                auto const format = next_token(line);
+
+                if (format == "ascii")
+                {
+                    header.format = ply_format::ascii;
+                }
+                else if (format == "binary_little_endian")
+                {
+                    header.format = ply_format::binary_little_endian;
+                }
+                else if (format == "binary_big_endian")
+                {
+                    header.format = ply_format::binary_big_endian;
+                }
+                else [[unlikely]]
+                {
+                    return error_code::unsupported_format;
+                }
+            }
+            else if (keyword == "element")
+            {
+                auto const name = next_token(line);
+                auto const count = next_token(line);
+                std::size_t value{0UL};
+                auto const [ptr, ec] = std::from_chars(count.data(), count.data() + count.size(), value);
+
+                if (ec != std::errc{} || ptr != count.data() + count.size()) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                properties = nullptr;
+
+                if (name == "vertex")
+                {
+                    header.vertex_count = value;
+                    properties = &header.vertex_properties;
+                    has_vertices = true;
+                }
+                else if (name == "face" && has_vertices)
+                {
+                    header.face_count = value;
+                    properties = &header.face_properties;
+                    has_faces = true;
+                }
+                else if (!has_faces && value != 0UL) [[unlikely]]
+                {
+                    // The body is read in declaration order, so only elements following the faces can be skipped.
+                    return error_code::unsupported_format;
+                }
+            }
+            else if (keyword == "property" && properties != nullptr)
+            {
+                ply_property property;
+                auto type = next_token(line);
+
+                if (type == "list")
+                {
+                    auto const count_type = parse_ply_type(next_token(line));
+
+                    if (!count_type) [[unlikely]]
+                    {
+                        return error_code::invalid_data;
+                    }
+
+                    property.is_list = true;
+                    property.count_type = *count_type;
+                    type = next_token(line);
+                }
+
+                auto const value_type = parse_ply_type(type);
+
+                if (!value_type) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                property.type = *value_type;
+                property.name = next_token(line);
+                properties->push_back(property);
+            }
+        }
+
+        return error_code::invalid_data;
+    }
+
+    [[nodiscard]] inline auto is_native_xyz(ply_header const& header) noexcept -> bool
+    {
+        auto const& properties = header.vertex_properties;
+        bool const native = (header.format == ply_format::binary_little_endian && std::endian::native == std::endian::little) ||
+                            (header.format == ply_format::binary_big_endian && std::endian::native == std::endian::big);
+
+        return native && properties.size() == 3UL &&
+               std::ranges::all_of(properties, [](ply_property const& property) -> bool {
+                   return !property.is_list && property.type == ply_type::float32;
+               }) &&
+               properties[0].name == "x" && properties[1].name == "y" && properties[2].name == "z";
+    }
+
+    [[nodiscard]] constexpr auto swaps_bytes(ply_header const& header) noexcept -> bool
+    {
+        return (header.format == ply_format::binary_little_endian) != (std::endian::native == std::endian::little);
+    }
+
+    // Both enumerations list the PLY types in the same order.
+    [[nodiscard]] constexpr auto to_attribute_type(ply_type const type) noexcept -> attribute_type
+    {
+        return static_cast<attribute_type>(type);
+    }
+
+    [[nodiscard]] constexpr auto to_ply_type(attribute_type const type) noexcept -> ply_type
+    {
+        return static_cast<ply_type>(type);
+    }
+
+    // Whether a vertex property holds a coordinate of the normal, which moving the positions leaves stale.
+    [[nodiscard]] constexpr auto is_normal_channel(std::string_view const name) noexcept -> bool
+    {
+        return name == "nx" || name == "ny" || name == "nz";
+    }
+
+    // What a decoder does with one property of a record.
+    enum class ply_action
+    {
+        position, // Stores the coordinate `target` of the position.
+        channel, // Stores the value in the attribute channel `target`.
+        indices, // Reads the corners of the face.
+        skip, // Steps over a list nothing is kept of.
+    };
+
+    // One property of a record compiled from the header, so that records decode without looking at names again.
+    struct ply_field
+    {
+        ply_action action{ply_action::skip};
+        ply_type type{ply_type::float32};
+        ply_type count_type{ply_type::uint8};
+        std::size_t offset{0UL};
+        std::size_t target{0UL};
+    };
+
+    // Decode plan of the vertex records: the byte offsets and types of x, y and z in a binary record of stride bytes, one
+    // field per property, and the other properties, which become attribute channels in this order.
+    struct vertex_layout
+    {
+        std::array<std::size_t, 3UL> offsets{};
+        std::array<ply_type, 3UL> types{};
+        std::size_t stride{0UL};
+        std::vector<ply_field> fields;
+        std::vector<ply_property> channels;
+    };
+
+    // Decode plan of the face records: one field per property, the scalar ones becoming attribute channels in this order.
+    struct face_layout
+    {
+        std::vector<ply_field> fields;
+        std::vector<ply_property> channels;
+    };
+
+    [[nodiscard]] inline auto make_vertex_layout(ply_header const& header, vertex_layout& layout) noexcept -> error_code
+    {
+        std::array<bool, 3UL> found{};
+        layout.stride = 0UL;
+        layout.fields.clear();
+        layout.channels.clear();
+
+        for (auto const& property : header.vertex_properties)
+        {
+            if (property.is_list) [[unlikely]]
+            {
+                return error_code::unsupported_format;
+            }
+
+            std::size_t const axis = property.name == "x"   ? 0UL
+                                     : property.name == "y" ? 1UL
+                                     : property.name == "z" ? 2UL
+                                                            : 3UL;
+            ply_field field{.type = property.type, .offset = layout.stride};
+
+            if (axis < 3UL && !found[axis])
+            {
+                layout.offsets[axis] = layout.stride;
+                layout.types[axis] = property.type;
+                found[axis] = true;
+                field.action = ply_action::position;
+                field.target = axis;
+            }
+            else
+            {
+                field.action = ply_action::channel;
+                field.target = layout.channels.size();
+                layout.channels.push_back(property);
+            }
+
+            layout.fields.push_back(field);
+            layout.stride += size_of(property.type);
+        }
+
+        return std::ranges::all_of(found, [](bool const axis) -> bool { return axis; }) ? error_code::none
+                                                                                         : error_code::invalid_data;
+    }
+
+    // Fails when the faces have no list of corners.
+    [[nodiscard]] inline auto make_face_layout(ply_header const& header, face_layout& layout) noexcept -> error_code
+    {
+        bool has_indices{false};
+        layout.fields.clear();
+        layout.channels.clear();
+
+        for (auto const& property : header.face_properties)
+        {
+            ply_field field{.type = property.type, .count_type = property.count_type};
+
+            // Decoding reads every count, and the corners, as integers.
+            if (property.is_list && is_floating_point(property.count_type)) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+
+            if (!property.is_list)
+            {
+                field.action = ply_action::channel;
+                field.target = layout.channels.size();
+                layout.channels.push_back(property);
+            }
+            else if (!has_indices && (property.name == "vertex_indices" || property.name == "vertex_index"))
+            {
+                if (is_floating_point(property.type)) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                field.action = ply_action::indices;
+                has_indices = true;
+            }
+
+            layout.fields.push_back(field);
+        }
+
+        return has_indices || header.face_count == 0UL ? error_code::none : error_code::invalid_data;
+    }
+
+    // Bytes taken by the shortest binary face record: its scalars, the counts of its lists and the three corners.
+    [[nodiscard]] inline auto min_binary_face_size(face_layout const& layout) noexcept -> std::size_t
+    {
+        std::size_t size{0UL};
+
+        for (auto const& field : layout.fields)
+        {
+            size += field.action == ply_action::channel   ? size_of(field.type)
+                    : field.action == ply_action::indices ? size_of(field.count_type) + 3UL * size_of(field.type)
+                                                          : size_of(field.count_type);
+        }
+
+        return size;
+    }
+
+    inline auto read_position(vertex_layout const& layout, char const* record, bool const swap, float* output) noexcept -> void
+    {
+        output[0] = read_as<float>(layout.types[0], record + layout.offsets[0], swap);
+        output[1] = read_as<float>(layout.types[1], record + layout.offsets[1], swap);
+        output[2] = read_as<float>(layout.types[2], record + layout.offsets[2], swap);
+    }
+
+    // Copies a binary scalar of size bytes to output, reversing its bytes when swap is set.
+    inline auto copy_scalar(char const* source, std::size_t const size, bool const swap, char* output) noexcept -> void
+    {
+        if (swap)
+        {
+            std::reverse_copy(source, source + size, output);
+        }
+        else
+        {
+            std::memcpy(output, source, size);
+        }
+    }
+
+    // Stores the channel values of a binary vertex record as the element `index` of the channels, given by their first
+    // byte. Does nothing when channels is empty, which discards them.
+    inline auto read_channels(vertex_layout const& layout, char const* record, bool const swap, std::span<char* const> channels,
+                              std::size_t const index) noexcept -> void
+    {
+        if (channels.empty())
+        {
+            return;
+        }
+
+        for (auto const& field : layout.fields)
+        {
+            if (field.action == ply_action::channel)
+            {
+                std::size_t const size = size_of(field.type);
+                copy_scalar(record + field.offset, size, swap, channels[field.target] + index * size);
+            }
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] auto parse_scalar(char const*& cursor, char const* const end, char* output) noexcept -> bool
+    {
+        T value{};
+
+        if (!parse_number(cursor, end, value)) [[unlikely]]
+        {
+            return false;
+        }
+
+        std::memcpy(output, &value, sizeof(T));
+
+        return true;
+    }
+
+    // Parses an ASCII number of the given type into output, or parses and drops any number when output is null.
+    [[nodiscard]] inline auto parse_ascii_scalar(char const*& cursor, char const* const end, ply_type const type,
+                                                 char* output) noexcept -> bool
+    {
+        if (output == nullptr)
+        {
+            double value{0.0};
+            return parse_number(cursor, end, value);
+        }
+
+        switch (type)
+        {
+        case ply_type::int8:
+            return parse_scalar<std::int8_t>(cursor, end, output);
+        case ply_type::uint8:
+            return parse_scalar<std::uint8_t>(cursor, end, output);
+        case ply_type::int16:
+            return parse_scalar<std::int16_t>(cursor, end, output);
+        case ply_type::uint16:
+            return parse_scalar<std::uint16_t>(cursor, end, output);
+        case ply_type::int32:
+            return parse_scalar<std::int32_t>(cursor, end, output);
+        case ply_type::uint32:
+            return parse_scalar<std::uint32_t>(cursor, end, output);
+        case ply_type::float32:
+            return parse_scalar<float>(cursor, end, output);
+        case ply_type::float64:
+            return parse_scalar<double>(cursor, end, output);
+        }
+
+        return false;
+    }
+
+    // Parses the numbers of an ASCII vertex record, keeping x, y and z, and the other properties as the element `index` of
+    // the channels, given by their first byte. Drops the other properties when channels is empty.
+    [[nodiscard]] inline auto parse_ascii_vertex(char const*& cursor, char const* const end, vertex_layout const& layout,
+                                                 float* output, std::span<char* const> const channels = {},
+                                                 std::size_t const index = 0UL) noexcept -> bool
+    {
+        for (auto const& field : layout.fields)
+        {
+            bool const parsed = field.action == ply_action::position
+                                    ? parse_number(cursor, end, output[field.target])
+                                    : parse_ascii_scalar(cursor, end, field.type,
+                                                         channels.empty() ? nullptr
+                                                                          : channels[field.target] + index * size_of(field.type));
+
+            if (!parsed) [[unlikely]]
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Parses the ASCII face record at cursor, keeping its scalar properties like parse_ascii_vertex. Corners are checked
+    // against the vertex count of the file, then offset by first_vertex, the number of vertices the mesh had before it.
+    [[nodiscard]] inline auto parse_ascii_face(char const*& cursor, char const* const end, face_layout const& layout,
+                                               std::size_t const vertex_count, face& face,
+                                               std::span<char* const> const channels = {}, std::size_t const index = 0UL,
+                                               index_type const first_vertex = 0U) noexcept -> error_code
+    {
+        for (auto const& field : layout.fields)
+        {
+            if (field.action == ply_action::channel)
+            {
+                if (!parse_ascii_scalar(cursor, end, field.type,
+                                        channels.empty() ? nullptr : channels[field.target] + index * size_of(field.type)))
+                    [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                continue;
+            }
+
+            std::size_t count{0UL};
+
+            if (!parse_number(cursor, end, count)) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+
+            if (field.action == ply_action::skip)
+            {
+                for (std::size_t value{0UL}; value < count; ++value)
+                {
+                    if (!parse_ascii_scalar(cursor, end, field.type, nullptr)) [[unlikely]]
+                    {
+                        return error_code::invalid_data;
+                    }
+                }
+
+                continue;
+            }
+
+            if (count != 3UL) [[unlikely]]
+            {
+                return error_code::unsupported_format;
+            }
+
+            std::array<index_type, 3UL> corners{};
+
+            for (auto& corner : corners)
+            {
+                if (!parse_number(cursor, end, corner) || corner >= vertex_count) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+            }
+
+            face = tml::face{corners[0] + first_vertex, corners[1] + first_vertex, corners[2] + first_vertex};
+        }
+
+        return error_code::none;
+    }
+
+    // Parses the binary face record at cursor and moves cursor past it, keeping its scalar properties like read_channels.
+    // Returns std::nullopt, leaving cursor unchanged, when the record goes on past end. Corners are offset like in
+    // parse_ascii_face.
+    [[nodiscard]] inline auto parse_binary_face(char const*& cursor, char const* const end, face_layout const& layout,
+                                                std::size_t const vertex_count, bool const swap, face& face,
+                                                std::span<char* const> const channels = {}, std::size_t const index = 0UL,
+                                                index_type const first_vertex = 0U) noexcept -> std::optional<error_code>
+    {
+        char const* position = cursor;
+        auto const remaining = [&position, end]() -> std::size_t { return static_cast<std::size_t>(end - position); };
+
+        for (auto const& field : layout.fields)
+        {
+            if (field.action == ply_action::channel)
+            {
+                std::size_t const size = size_of(field.type);
+
+                if (remaining() < size) [[unlikely]]
+                {
+                    return std::nullopt;
+                }
+
+                if (!channels.empty())
+                {
+                    copy_scalar(position, size, swap, channels[field.target] + index * size);
+                }
+
+                position += size;
+                continue;
+            }
+
+            if (remaining() < size_of(field.count_type)) [[unlikely]]
+            {
+                return std::nullopt;
+            }
+
+            if (is_signed_negative(field.count_type, position, swap)) [[unlikely]]
+            {
+                return error_code::invalid_data;
+            }
+
+            auto const count = read_as<std::size_t>(field.count_type, position, swap);
+            position += size_of(field.count_type);
+            std::size_t const value_size = size_of(field.type);
+
+            if (remaining() / value_size < count) [[unlikely]]
+            {
+                return std::nullopt;
+            }
+
+            if (field.action == ply_action::skip)
+            {
+                position += count * value_size;
+                continue;
+            }
+
+            if (count != 3UL) [[unlikely]]
+            {
+                return error_code::unsupported_format;
+            }
+
+            std::array<std::size_t, 3UL> corners{};
+
+            for (std::size_t& corner : corners)
+            {
+                if (is_signed_negative(field.type, position, swap)) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+
+                corner = read_as<std::size_t>(field.type, position, swap);
+                position += value_size;
+
+                if (corner >= vertex_count) [[unlikely]]
+                {
+                    return error_code::invalid_data;
+                }
+            }
+
+            face = tml::face{static_cast<index_type>(corners[0] + first_vertex),
+                             static_cast<index_type>(corners[1] + first_vertex),
+                             static_cast<index_type>(corners[2] + first_vertex)};
+        }
+
+        cursor = position;
+
+        return error_code::none;
+    }
+
+    [[nodiscard]] constexpr auto ply_type_name(ply_type const type) noexcept -> std::string_view
+    {
+        constexpr std::array<std::string_view, 8UL> names{"char", "uchar", "short", "ushort", "int", "uint", "float", "double"};
+
+        return names[static_cast<std::size_t>(type)];
+    }
+
+    // Binary files are written in native byte order with 32-bit indices, so that the vertex block is a plain copy of the
+    // positions unless the vertices also carry their normals or attributes.
+    inline auto format_ply_header(block_writer& writer, bool const binary, std::size_t const vertex_count,
+                                  std::size_t const face_count, bool const normals = false,
+                                  std::span<attribute_channel const* const> const vertex_channels = {},
+                                  std::span<attribute_channel const* const> const face_channels = {}) -> void
+    {
+        static constexpr std::string_view native_format =
+            std::endian::native == std::endian::little ? "binary_little_endian" : "binary_big_endian";
+
+        writer.format("ply\nformat {} 1.0\nelement vertex {}\nproperty float x\nproperty float y\nproperty float z\n{}",
+                      binary ? native_format : "ascii", vertex_count,
+                      normals ? "property float nx\nproperty float ny\nproperty float nz\n" : "");
+
+        for (auto const* const channel : vertex_channels)
+        {
+            writer.format("property {} {}\n", ply_type_name(to_ply_type(channel->type())), channel->name());
+        }
+
+        writer.format("element face {}\nproperty list uchar {} vertex_indices\n", face_count, binary ? "uint" : "int");
+
+        for (auto const* const channel : face_channels)
+        {
+            writer.format("property {} {}\n", ply_type_name(to_ply_type(channel->type())), channel->name());
+        }
+
+        writer.format("end_header\n");
+    }
+
+    template <typename T>
+    auto format_value(fmt::memory_buffer& buffer, attribute_channel const& channel, std::size_t const index) -> void
+    {
+        // The unary plus prints 8-bit integers as numbers rather than characters.
+        fmt::format_to(std::back_inserter(buffer), " {}", +channel.values<T>()[index]);
+    }
+
+    // Appends the element `index` of each channel to an ASCII record.
+    inline auto format_channel_values(fmt::memory_buffer& buffer, std::span<attribute_channel const* const> const channels,
+                                      std::size_t const index) -> void
+    {
+        for (auto const* const channel : channels)
+        {
+            switch (channel->type())
+            {
+            case attribute_type::int8:
+                format_value<std::int8_t>(buffer, *channel, index);
+                break;
+            case attribute_type::uint8:
+                format_value<std::uint8_t>(buffer, *channel, index);
+                break;
+            case attribute_type::int16:
+                format_value<std::int16_t>(buffer, *channel, index);
+                break;
+            case attribute_type::uint16:
+                format_value<std::uint16_t>(buffer, *channel, index);
+                break;
+            case attribute_type::int32:
+                format_value<std::int32_t>(buffer, *channel, index);
+                break;
+            case attribute_type::uint32:
+                format_value<std::uint32_t>(buffer, *channel, index);
+                break;
+            case attribute_type::float32:
+                format_value<float>(buffer, *channel, index);
+                break;
+            case attribute_type::float64:
+                format_value<double>(buffer, *channel, index);
+                break;
+            }
+        }
+    }
+
+    // Appends the element `index` of each channel to a binary record and returns the position past it.
+    inline auto copy_channel_values(char* output, std::span<attribute_channel const* const> const channels,
+                                    std::size_t const index) noexcept -> char*
+    {
+        for (auto const* const channel : channels)
+        {
+            std::size_t const size = channel->element_size();
+            std::memcpy(output, static_cast<char const*>(channel->data()) + index * size, size);
+            output += size;
+        }
+
+        return output;
+    }
+
+    [[nodiscard]] inline auto record_size_of(std::span<attribute_channel const* const> const channels) noexcept -> std::size_t
+    {
+        std::size_t size{0UL};
+
+        for (auto const* const channel : channels)
+        {
+            size += channel->element_size();
+        }
+
+        return size;
+    }
+
+    // Normals, when not empty, hold three values per vertex written after its position, and are followed by the channels.
+    inline auto format_ply_vertices(block_writer& writer, std::span<float const> const positions,
+                                    std::span<float const> const normals,
+                                    std::span<attribute_channel const* const> const channels, std::size_t const threads) -> void
+    {
+        writer.format_each(positions.size() / 3, threads,
+                           [positions, normals, channels](fmt::memory_buffer& buffer, std::size_t const index) -> void {
+                               fmt::format_to(std::back_inserter(buffer), "{} {} {}", positions[index * 3],
+                                              positions[index * 3 + 1], positions[index * 3 + 2]);
+
+                               if (!normals.empty())
+                               {
+                                   fmt::format_to(std::back_inserter(buffer), " {} {} {}", normals[index * 3],
+                                                  normals[index * 3 + 1], normals[index * 3 + 2]);
+                               }
+
+                               format_channel_values(buffer, channels, index);
+                               buffer.push_back('\n');
+                           });
+    }
+
+    // Interleaves the positions with their normals, if any, and the values of the channels in native-endian records.
+    inline auto write_binary_ply_vertices(std::ostream& stream, std::span<float const> const positions,
+                                          std::span<float const> const normals,
+                                          std::span<attribute_channel const* const> const channels = {}) -> void
+    {
+        static constexpr std::size_t records_per_block{4096UL};
+        std::size_t const coordinates = normals.empty() ? 3UL : 6UL;
+        std::size_t const record_size = coordinates * sizeof(float) + record_size_of(channels);
+        std::vector<char> block(record_size * records_per_block);
+
+        for (std::size_t first{0UL}; first < positions.size() / 3; first += records_per_block)
+        {
+            std::size_t const count = std::min(records_per_block, positions.size() / 3 - first);
+            char* output = block.data();
+
+            for (std::size_t vertex{first}; vertex < first + count; ++vertex)
+            {
+                std::memcpy(output, positions.data() + vertex * 3, 3 * sizeof(float));
+                output += 3 * sizeof(float);
+
+                if (!normals.empty())
+                {
+                    std::memcpy(output, normals.data() + vertex * 3, 3 * sizeof(float));
+                    output += 3 * sizeof(float);
+                }
+
+                output = copy_channel_values(output, channels, vertex);
+            }
+
+            stream.write(block.data(), static_cast<std::streamsize>(count * record_size));
+        }
+    }
+
+    inline auto format_ply_faces(block_writer& writer, std::span<face const> const faces,
+                                 std::span<attribute_channel const* const> const channels, std::size_t const threads) -> void
+    {
+        writer.format_each(faces.size(), threads,
+                           [faces, channels](fmt::memory_buffer& buffer, std::size_t const index) -> void {
+                               auto const [index_v1, index_v2, index_v3] = faces[index].indices();
+                               fmt::format_to(std::back_inserter(buffer), "3 {} {} {}", index_v1, index_v2, index_v3);
+                               format_channel_values(buffer, channels, index);
+                               buffer.push_back('\n');
+                           });
+    }
+
+    inline auto write_binary_ply_faces(std::ostream& stream, std::span<face const> const faces,
+                                       std::span<attribute_channel const* const> const channels = {}) -> void
+    {
+        static constexpr std::size_t records_per_block{4096UL};
+        std::size_t const record_size = 1UL + 3UL * sizeof(std::uint32_t) + record_size_of(channels);
+        std::vector<char> block(record_size * std::min(records_per_block, faces.size()));
+
+        for (std::size_t first{0UL}; first < faces.size(); first += records_per_block)
+        {
+            std::size_t const count = std::min(records_per_block, faces.size() - first);
+            char* output = block.data();
+
+            for (std::size_t record{first}; record < first + count; ++record)
+            {
+                *output++ = 3;
+
+                for (auto const index : faces[record].indices())
+                {
+                    auto const value = static_cast<std::uint32_t>(index);
+                    std::memcpy(output, &value, sizeof(value));
+                    output += sizeof(value);
+                }
+
+                output = copy_channel_values(output, channels, record);
+            }
+
+            stream.write(block.data(), static_cast<std::streamsize>(count * record_size));
+        }
+    }
+} // namespace tml::detail
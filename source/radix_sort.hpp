@@ -0,0 +1,78 @@
+#pragma once
+
+#include "parallel.hpp" // tml::detail::parallel_for
+
+#include <algorithm> // std::clamp
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <vector> // std::vector
+
+namespace tml::detail
+{
+    // Least-significant-digit radix sort of 64 bits keys on bytes. Passes whose digit is the same for every key are skipped,
+    // which is the case of the high bytes of keys built from small indices. With several threads, each pass counts and
+    // scatters contiguous chunks concurrently, the chunks being laid out in order so that the sort stays stable.
+    inline auto radix_sort(std::vector<std::uint64_t>& keys, std::size_t const threads) -> void
+    {
+        static constexpr std::size_t radix{256UL};
+        static constexpr std::size_t grain{1UL << 16U};
+        std::size_t const count = keys.size();
+        std::size_t const workers = std::clamp<std::size_t>(count / grain, 1UL, std::max<std::size_t>(threads, 1UL));
+        std::vector<std::uint64_t> scratch(count);
+        std::vector<std::array<std::size_t, radix>> histograms(workers);
+        auto const chunk = [count, workers](std::size_t const worker) -> std::size_t { return count * worker / workers; };
+
+        for (unsigned shift{0U}; shift < 64U; shift += 8U)
+        {
+            parallel_for(workers, workers, 1UL, [&](std::size_t const begin, std::size_t const end) {
+                for (std::size_t worker{begin}; worker < end; ++worker)
+                {
+                    auto& histogram = histograms[worker];
+                    histogram.fill(0UL);
+
+                    for (std::size_t idx = chunk(worker); idx < chunk(worker + 1UL); ++idx)
+                    {
+                        ++histogram[(keys[idx] >> shift) & 0xFFU];
+                    }
+                }
+            });
+
+            bool trivial{false};
+            std::size_t offset{0UL};
+
+            for (std::size_t digit{0UL}; digit < radix && !trivial; ++digit)
+            {
+                std::size_t const start = offset;
+
+                for (auto& histogram : histograms)
+                {
+                    std::size_t const digit_count = histogram[digit];
+                    histogram[digit] = offset;
+                    offset += digit_count;
+                }
+
+                trivial = offset - start == count;
+            }
+
+            if (trivial)
+            {
+                continue;
+            }
+
+            parallel_for(workers, workers, 1UL, [&](std::size_t const begin, std::size_t const end) {
+                for (std::size_t worker{begin}; worker < end; ++worker)
+                {
+                    auto& cursors = histograms[worker];
+
+                    for (std::size_t idx = chunk(worker); idx < chunk(worker + 1UL); ++idx)
+                    {
+                        scratch[cursors[(keys[idx] >> shift) & 0xFFU]++] = keys[idx];
+                    }
+                }
+            });
+
+            keys.swap(scratch);
+        }
+    }
+} // namespace tml::detail
@@ -0,0 +1,65 @@
+#include "tml/stats.hpp"
+
+#include "stats.hpp" // tml::detail::record
+
+#include <array> // std::array
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::move
+
+namespace
+{
+    std::array<std::atomic<std::uint64_t>, tml::stat_count> counters{};
+
+    // The flag spares recording the mutex as long as no sink is installed.
+    std::atomic<bool> has_sink{false};
+    std::mutex sink_mutex;
+    tml::stats_sink sink;
+} // namespace
+
+#if defined(TML_ENABLE_STATS)
+auto tml::detail::record(stat const value, std::uint64_t const amount) noexcept -> void
+{
+    counters[static_cast<std::size_t>(value)].fetch_add(amount, std::memory_order_relaxed);
+
+    if (has_sink.load(std::memory_order_acquire)) [[unlikely]]
+    {
+        std::lock_guard const lock{sink_mutex};
+
+        try
+        {
+            sink(value, amount);
+        }
+        catch (...) // NOLINT(bugprone-empty-catch): a throwing sink must not abort the operation being measured.
+        {
+        }
+    }
+}
+#endif
+
+auto tml::stats_snapshot() noexcept -> stats
+{
+    stats snapshot;
+
+    for (std::size_t idx{0UL}; idx < stat_count; ++idx)
+    {
+        snapshot.values[idx] = counters[idx].load(std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+auto tml::reset_stats() noexcept -> void
+{
+    for (auto& counter : counters)
+    {
+        counter.store(0U, std::memory_order_relaxed);
+    }
+}
+
+auto tml::set_stats_sink(stats_sink new_sink) -> void
+{
+    std::lock_guard const lock{sink_mutex};
+    sink = std::move(new_sink);
+    has_sink.store(static_cast<bool>(sink), std::memory_order_release);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "tml/stats.hpp" // tml::stat
+
+#include <chrono> // std::chrono::steady_clock, std::chrono::nanoseconds
+#include <cstdint> // std::uint64_t
+
+namespace tml::detail
+{
+#if defined(TML_ENABLE_STATS)
+    // Adds the amount to the process-wide counter and forwards it to the sink, if any.
+    auto record(stat value, std::uint64_t amount) noexcept -> void;
+
+    // Adds the time elapsed between its construction and its destruction to a duration counter.
+    class scoped_timer
+    {
+    public:
+
+        explicit scoped_timer(stat const value) noexcept : m_stat{value}, m_start{std::chrono::steady_clock::now()} {}
+
+        scoped_timer(scoped_timer const&) = delete;
+        auto operator=(scoped_timer const&) -> scoped_timer& = delete;
+
+        ~scoped_timer()
+        {
+            auto const elapsed = std::chrono::steady_clock::now() - m_start;
+            record(m_stat, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+    private:
+
+        stat m_stat;
+        std::chrono::steady_clock::time_point m_start;
+    };
+#else
+    inline auto record(stat /*value*/, std::uint64_t /*amount*/) noexcept -> void {}
+
+    class scoped_timer
+    {
+    public:
+
+        explicit scoped_timer(stat /*value*/) noexcept {}
+    };
+#endif
+} // namespace tml::detail
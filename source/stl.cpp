@@ -0,0 +1,359 @@
+#include "ascii.hpp" // tml::detail::parse_number, tml::detail::next_line, tml::detail::next_token
+#include "binary.hpp" // tml::detail::load, tml::detail::store_le
+#include "mapped_file.hpp" // tml::detail::mapped_file
+#include "parallel.hpp" // tml::detail::thread_count
+#include "stats.hpp" // tml::detail::record
+#include "stl_format.hpp" // tml::detail::stl_header_size, tml::detail::stl_record_size, tml::detail::is_binary_stl
+#include "tml/mesh.hpp"
+#include "tml/vec3.hpp" // tml::vec3
+#include "writer.hpp" // tml::detail::block_writer
+
+#include <algorithm> // std::max, std::min, std::ranges::copy, std::ranges::for_each
+#include <array> // std::array
+#include <bit> // std::bit_cast, std::bit_ceil, std::endian
+#include <cstdint> // std::uint16_t, std::uint32_t, std::uint64_t
+#include <fmt/format.h> // fmt::format_to
+#include <fstream> // std::ofstream
+#include <iterator> // std::next, std::back_inserter
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <string_view> // std::string_view
+#include <vector> // std::vector
+
+using tml::face;
+using tml::mesh;
+using tml::vec3;
+using tml::detail::stl_header_size;
+using tml::detail::stl_record_size;
+
+namespace
+{
+    // Open-addressing (linear probing) table from a position to its vertex index. Keys are compared on their exact bit
+    // patterns and only the vertex index is stored, the coordinates being read back from the position array. The slots
+    // visited by the insertions are recorded as hash probes when the table goes away.
+    class vertex_table
+    {
+    public:
+
+        // Returned by insert instead of a new index once the mesh holds tml::max_vertex_count vertices.
+        static constexpr tml::index_type full{std::numeric_limits<tml::index_type>::max()};
+
+        vertex_table(std::vector<float>& positions, std::size_t expected_vertices)
+            : m_positions{positions}, m_slots(std::bit_ceil(std::max(expected_vertices * 2UL, 16UL)), empty)
+        {
+        }
+
+        vertex_table(vertex_table const&) = delete;
+        auto operator=(vertex_table const&) -> vertex_table& = delete;
+
+        ~vertex_table() { tml::detail::record(tml::stat::hash_probes, m_probes); }
+
+        auto insert(float const x, float const y, float const z) -> tml::index_type
+        {
+            // -0.0 and 0.0 compare equal but differ in their bits, fold them so they still weld together.
+            std::array const key{x + 0.0F, y + 0.0F, z + 0.0F};
+            std::size_t const mask = m_slots.size() - 1UL;
+
+            for (std::size_t slot = hash(key) & mask;; slot = (slot + 1UL) & mask)
+            {
+                if constexpr (tml::stats_enabled)
+                {
+                    ++m_probes;
+                }
+
+                if (m_slots[slot] == empty)
+                {
+                    if (m_positions.size() / 3 >= tml::max_vertex_count) [[unlikely]]
+                    {
+                        return full;
+                    }
+
+                    auto const index = static_cast<tml::index_type>(m_positions.size() / 3);
+                    m_positions.insert(m_positions.end(), key.begin(), key.end());
+                    m_slots[slot] = index;
+
+                    if (++m_size * 2UL > m_slots.size())
+                    {
+                        grow();
+                    }
+
+                    return index;
+                }
+
+                if (equals(m_slots[slot], key))
+                {
+                    return m_slots[slot];
+                }
+            }
+        }
+
+    private:
+
+        static constexpr tml::index_type empty{full};
+
+        [[nodiscard]] static auto hash(std::array<float, 3UL> const& key) noexcept -> std::size_t
+        {
+            auto h = (static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(key[0])) << 32U) ^
+                     std::bit_cast<std::uint32_t>(key[1]);
+            h ^= static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(key[2])) * 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 33U;
+            h *= 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 33U;
+            h *= 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 33U;
+
+            return static_cast<std::size_t>(h);
+        }
+
+        [[nodiscard]] auto equals(tml::index_type const index, std::array<float, 3UL> const& key) const noexcept -> bool
+        {
+            auto const* const position = std::next(m_positions.data(), static_cast<std::ptrdiff_t>(std::size_t{index} * 3));
+
+            return std::bit_cast<std::uint32_t>(position[0]) == std::bit_cast<std::uint32_t>(key[0]) &&
+                   std::bit_cast<std::uint32_t>(position[1]) == std::bit_cast<std::uint32_t>(key[1]) &&
+                   std::bit_cast<std::uint32_t>(position[2]) == std::bit_cast<std::uint32_t>(key[2]);
+        }
+
+        auto grow() -> void
+        {
+            std::vector<tml::index_type> slots(m_slots.size() * 2UL, empty);
+            std::size_t const mask = slots.size() - 1UL;
+
+            for (auto const index : m_slots)
+            {
+                if (index == empty)
+                {
+                    continue;
+                }
+
+                auto const* const position = std::next(m_positions.data(), static_cast<std::ptrdiff_t>(std::size_t{index} * 3));
+                std::size_t slot = hash({position[0], position[1], position[2]}) & mask;
+
+                while (slots[slot] != empty)
+                {
+                    slot = (slot + 1UL) & mask;
+                }
+
+                slots[slot] = index;
+            }
+
+            m_slots = std::move(slots);
+        }
+
+        std::vector<float>& m_positions;
+        std::vector<tml::index_type> m_slots;
+        std::size_t m_size{0UL};
+        std::uint64_t m_probes{0U};
+    };
+
+    [[nodiscard]] auto is_binary_stl(std::string_view const content) noexcept -> bool
+    {
+        if (content.size() < stl_header_size + sizeof(std::uint32_t))
+        {
+            return false;
+        }
+
+        bool const swap = std::endian::native == std::endian::big;
+        auto const count = tml::detail::load<std::uint32_t>(content.data() + stl_header_size, swap);
+
+        return tml::detail::is_binary_stl(content.size(), count);
+    }
+
+    auto parse_binary_stl(std::string_view const content, std::vector<float>& positions, std::vector<face>& faces)
+        -> tml::error_code
+    {
+        bool const swap = std::endian::native == std::endian::big;
+        auto const count = tml::detail::load<std::uint32_t>(content.data() + stl_header_size, swap);
+        char const* record = content.data() + stl_header_size + sizeof(std::uint32_t);
+        vertex_table table{positions, count / 2UL};
+
+        faces.reserve(faces.size() + count);
+
+        for (std::uint32_t idx{0U}; idx < count; ++idx, record += stl_record_size)
+        {
+            std::array<tml::index_type, 3UL> corners{};
+            char const* coordinates = record + 3UL * sizeof(float);
+
+            for (tml::index_type& corner : corners)
+            {
+                corner = table.insert(tml::detail::load<float>(coordinates, swap),
+                                      tml::detail::load<float>(coordinates + sizeof(float), swap),
+                                      tml::detail::load<float>(coordinates + 2UL * sizeof(float), swap));
+                coordinates += 3UL * sizeof(float);
+
+                if (corner == vertex_table::full) [[unlikely]]
+                {
+                    return tml::error_code::index_out_of_range;
+                }
+            }
+
+            faces.emplace_back(corners[0], corners[1], corners[2]);
+        }
+
+        return tml::error_code::none;
+    }
+
+    auto parse_ascii_stl(std::string_view content, std::vector<float>& positions, std::vector<face>& faces) -> tml::error_code
+    {
+        vertex_table table{positions, content.size() / 256UL};
+        std::array<tml::index_type, 3UL> corners{};
+        std::size_t corner_count{0UL};
+
+        while (!content.empty())
+        {
+            auto line = tml::detail::next_line(content);
+            auto const keyword = tml::detail::next_token(line);
+
+            if (keyword == "vertex")
+            {
+                std::array<float, 3UL> coordinates{};
+                char const* cursor = line.data();
+                char const* const end = line.data() + line.size();
+
+                for (float& coordinate : coordinates)
+                {
+                    if (!tml::detail::parse_number(cursor, end, coordinate)) [[unlikely]]
+                    {
+                        return tml::error_code::invalid_data;
+                    }
+                }
+
+                tml::index_type const index = table.insert(coordinates[0], coordinates[1], coordinates[2]);
+
+                if (index == vertex_table::full) [[unlikely]]
+                {
+                    return tml::error_code::index_out_of_range;
+                }
+
+                if (corner_count < corners.size())
+                {
+                    corners[corner_count] = index;
+                }
+
+                ++corner_count;
+            }
+            else if (keyword == "endfacet")
+            {
+                if (corner_count == 3UL)
+                {
+                    faces.emplace_back(corners[0], corners[1], corners[2]);
+                }
+
+                corner_count = 0UL;
+            }
+        }
+
+        return tml::error_code::none;
+    }
+} // namespace
+
+auto mesh::load_from_stl(std::filesystem::path const& filepath) noexcept -> parse_error
+{
+    detail::mapped_file file;
+
+    if (auto const error = file.open(filepath); error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = error};
+    }
+
+    std::size_t const first_coordinate = m_positions.size();
+    std::size_t const first_face = m_faces.size();
+    auto const error = is_binary_stl(file.view()) ? parse_binary_stl(file.view(), m_positions, m_faces)
+                                                  : parse_ascii_stl(file.view(), m_positions, m_faces);
+
+    invalidate_topology();
+
+    if (error != error_code::none) [[unlikely]]
+    {
+        m_positions.resize(first_coordinate);
+        m_faces.erase(std::next(m_faces.begin(), static_cast<std::ptrdiff_t>(first_face)), m_faces.end());
+    }
+
+    return parse_error{.code = error};
+}
+
+auto mesh::save_to_stl(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error
+{
+    if (!options.can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    {
+        return write_error{.code = error_code::file_already_exists};
+    }
+
+    bool const binary = options.encoding == encoding::binary;
+
+    if (binary && m_faces.size() > std::numeric_limits<std::uint32_t>::max()) [[unlikely]]
+    {
+        return write_error{.code = error_code::invalid_data};
+    }
+
+    std::ofstream file{filepath, binary ? std::ios_base::binary : std::ios_base::openmode{}};
+
+    if (!file) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
+                                                 : write_error{.code = error_code::file_not_found};
+    }
+
+    // Facets carry the cached unit normals of the faces, as the format expects.
+    auto const normals = face_normals(detail::thread_count(options.threads));
+    auto const corners = [this, normals](std::size_t const index) -> std::array<vec3, 4UL> {
+        auto const position = [this](std::size_t const vertex) -> vec3 {
+            return {m_positions[vertex * 3], m_positions[vertex * 3 + 1], m_positions[vertex * 3 + 2]};
+        };
+        auto const [index_v1, index_v2, index_v3] = m_faces[index].indices();
+
+        return {vec3{normals[index * 3], normals[index * 3 + 1], normals[index * 3 + 2]}, position(index_v1),
+                position(index_v2), position(index_v3)};
+    };
+
+    if (!binary)
+    {
+        detail::block_writer writer{file};
+        writer.format("solid {}\n", filepath.stem().string());
+        writer.format_each(m_faces.size(), detail::thread_count(options.threads),
+                           [this, &corners](fmt::memory_buffer& buffer, std::size_t const index) -> void {
+                               auto const [normal, v1, v2, v3] = corners(index);
+
+                               fmt::format_to(std::back_inserter(buffer),
+                                              "facet normal {} {} {}\nouter loop\nvertex {} {} {}\nvertex {} {} {}\nvertex {} {} "
+                                              "{}\nendloop\nendfacet\n",
+                                              normal.x(), normal.y(), normal.z(), v1.x(), v1.y(), v1.z(), v2.x(), v2.y(), v2.z(),
+                                              v3.x(), v3.y(), v3.z());
+                           });
+        writer.format("endsolid {}\n", filepath.stem().string());
+        writer.flush();
+
+        return file ? write_error{.code = error_code::none} : write_error{.code = error_code::unknown_io_error};
+    }
+
+    std::array<char, stl_header_size + sizeof(std::uint32_t)> header{};
+    static constexpr std::string_view signature{"binary STL written by tml"};
+    std::ranges::copy(signature, header.begin());
+    detail::store_le(std::next(header.data(), stl_header_size), static_cast<std::uint32_t>(m_faces.size()));
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    static constexpr std::size_t records_per_block{4096UL};
+    std::vector<char> block(stl_record_size * records_per_block);
+
+    for (std::size_t first{0UL}; first < m_faces.size(); first += records_per_block)
+    {
+        std::size_t const count = std::min(records_per_block, m_faces.size() - first);
+        char* output = block.data();
+
+        for (std::size_t index{first}; index < first + count; ++index)
+        {
+            for (vec3 const& v : corners(index))
+            {
+                output = detail::store_le(output, v.x());
+                output = detail::store_le(output, v.y());
+                output = detail::store_le(output, v.z());
+            }
+
+            output = detail::store_le(output, std::uint16_t{0U});
+        }
+
+        file.write(block.data(), static_cast<std::streamsize>(count * stl_record_size));
+    }
+
+    return file ? write_error{.code = error_code::none} : write_error{.code = error_code::unknown_io_error};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+namespace tml::detail
+{
+    constexpr std::size_t stl_header_size{80UL};
+    constexpr std::size_t stl_record_size{50UL};
+
+    // A binary STL is recognized by its size matching the triangle count of its header, since many exporters also start
+    // binary files with "solid".
+    [[nodiscard]] constexpr auto is_binary_stl(std::size_t const file_size, std::uint32_t const count) noexcept -> bool
+    {
+        return file_size == stl_header_size + sizeof(std::uint32_t) + std::size_t{count} * stl_record_size;
+    }
+} // namespace tml::detail
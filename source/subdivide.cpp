@@ -0,0 +1,221 @@
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::minmax, std::lower_bound, std::upper_bound
+#include <array> // std::array
+#include <atomic> // std::atomic
+#include <cstdint> // std::uint32_t
+#include <limits> // std::numeric_limits
+#include <numeric> // std::inclusive_scan
+#include <span> // std::span
+#include <vector> // std::vector
+
+using tml::face;
+using tml::mesh;
+
+auto mesh::subdivide(std::size_t const levels, std::size_t const threads) noexcept -> mesh&
+{
+    static constexpr std::size_t grain{1UL << 14U};
+    static constexpr std::size_t no_edge{std::numeric_limits<std::size_t>::max()};
+    std::size_t const thread_count = detail::thread_count(threads);
+
+    for (std::size_t level{0UL}; level < levels; ++level)
+    {
+        auto const& graph = adjacency(thread_count);
+        std::size_t const vertex_count = m_positions.size() / 3;
+        std::size_t const face_count = m_faces.size();
+        auto const row = [&graph](std::size_t const vertex) -> std::span<index_type const> {
+            return std::span{graph.neighbors}.subspan(graph.offsets[vertex], graph.offsets[vertex + 1] - graph.offsets[vertex]);
+        };
+
+        // Edge (a, b) with a < b is numbered after the edges of the vertices below a, by the rank of b among the neighbors
+        // of a above a. Adjacency rows are sorted, so the rank is a binary search and no edge table has to be built.
+        std::vector<std::size_t> edge_offsets(vertex_count + 1, 0UL);
+
+        detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t vertex{begin}; vertex < end; ++vertex)
+            {
+                auto const neighbors = row(vertex);
+                edge_offsets[vertex + 1] =
+                    static_cast<std::size_t>(neighbors.end() - std::upper_bound(neighbors.begin(), neighbors.end(), vertex));
+            }
+        });
+
+        std::inclusive_scan(edge_offsets.begin(), edge_offsets.end(), edge_offsets.begin());
+        std::size_t const edge_count = edge_offsets.back();
+
+        if (edge_count > max_vertex_count - vertex_count) [[unlikely]]
+        {
+            break;
+        }
+
+        auto const edge_of = [&](std::size_t const v1, std::size_t const v2) -> std::size_t {
+            if (v1 == v2) [[unlikely]]
+            {
+                return no_edge;
+            }
+
+            auto const [low, high] = std::minmax(v1, v2);
+            auto const neighbors = row(low);
+
+            return edge_offsets[low] + static_cast<std::size_t>(std::lower_bound(neighbors.begin(), neighbors.end(), high) -
+                                                                std::upper_bound(neighbors.begin(), neighbors.end(), low));
+        };
+
+        // Each face records its three edges and registers its third corner as an opposite vertex of each of them. An edge
+        // with exactly two incident faces is interior, any other count makes it a crease.
+        std::vector<std::array<std::size_t, 3>> face_edges(face_count);
+        std::vector<std::array<std::size_t, 2>> opposites(edge_count);
+        std::vector<std::atomic<std::uint32_t>> incidences(edge_count);
+
+        detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const [index_v1, index_v2, index_v3] = m_faces[idx].indices();
+                face_edges[idx] = {edge_of(index_v1, index_v2), edge_of(index_v2, index_v3), edge_of(index_v3, index_v1)};
+                std::array<std::size_t, 3> const opposite{index_v3, index_v1, index_v2};
+
+                for (std::size_t side{0UL}; side < 3UL; ++side)
+                {
+                    std::size_t const edge = face_edges[idx][side];
+
+                    if (edge == no_edge)
+                    {
+                        continue;
+                    }
+
+                    std::uint32_t const slot = incidences[edge].fetch_add(1U, std::memory_order_relaxed);
+
+                    if (slot < 2U)
+                    {
+                        opposites[edge][slot] = opposite[side];
+                    }
+                }
+            }
+        });
+
+        std::vector<float> new_positions((vertex_count + edge_count) * 3);
+        float const* const positions = m_positions.data();
+
+        // Vertex points: interior vertices get the Loop weights, boundary vertices the cubic B-spline rule along their two
+        // boundary edges, and vertices where more than two boundary edges meet are kept in place.
+        detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t vertex{begin}; vertex < end; ++vertex)
+            {
+                float const* const v = positions + vertex * 3;
+                float* const out = new_positions.data() + vertex * 3;
+                auto const neighbors = row(vertex);
+                std::array<std::size_t, 2> boundary{};
+                std::size_t boundary_count{0UL};
+                std::array<float, 3> sum{};
+
+                for (index_type const neighbor : neighbors)
+                {
+                    if (neighbor == vertex) [[unlikely]]
+                    {
+                        continue;
+                    }
+
+                    if (incidences[edge_of(vertex, neighbor)].load(std::memory_order_relaxed) != 2U)
+                    {
+                        if (boundary_count < 2UL)
+                        {
+                            boundary[boundary_count] = neighbor;
+                        }
+
+                        ++boundary_count;
+                    }
+
+                    sum[0] += positions[std::size_t{neighbor} * 3];
+                    sum[1] += positions[std::size_t{neighbor} * 3 + 1];
+                    sum[2] += positions[std::size_t{neighbor} * 3 + 2];
+                }
+
+                if (neighbors.empty() || boundary_count == 1UL || boundary_count > 2UL)
+                {
+                    out[0] = v[0];
+                    out[1] = v[1];
+                    out[2] = v[2];
+                }
+                else if (boundary_count == 2UL)
+                {
+                    float const* const b1 = positions + boundary[0] * 3;
+                    float const* const b2 = positions + boundary[1] * 3;
+                    out[0] = 0.75F * v[0] + 0.125F * (b1[0] + b2[0]);
+                    out[1] = 0.75F * v[1] + 0.125F * (b1[1] + b2[1]);
+                    out[2] = 0.75F * v[2] + 0.125F * (b1[2] + b2[2]);
+                }
+                else
+                {
+                    auto const n = static_cast<float>(neighbors.size());
+                    float const beta = neighbors.size() == 3UL ? 3.0F / 16.0F : 3.0F / (8.0F * n);
+                    float const weight = 1.0F - n * beta;
+                    out[0] = weight * v[0] + beta * sum[0];
+                    out[1] = weight * v[1] + beta * sum[1];
+                    out[2] = weight * v[2] + beta * sum[2];
+                }
+            }
+        });
+
+        // Edge points, each edge enumerated from its lower endpoint.
+        detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t vertex{begin}; vertex < end; ++vertex)
+            {
+                auto const neighbors = row(vertex);
+                auto const above = std::upper_bound(neighbors.begin(), neighbors.end(), vertex);
+                std::size_t edge = edge_offsets[vertex];
+
+                for (auto it = above; it != neighbors.end(); ++it, ++edge)
+                {
+                    float const* const a = positions + vertex * 3;
+                    float const* const b = positions + std::size_t{*it} * 3;
+                    float* const out = new_positions.data() + (vertex_count + edge) * 3;
+
+                    if (incidences[edge].load(std::memory_order_relaxed) == 2U)
+                    {
+                        float const* const c = positions + opposites[edge][0] * 3;
+                        float const* const d = positions + opposites[edge][1] * 3;
+                        out[0] = 0.375F * (a[0] + b[0]) + 0.125F * (c[0] + d[0]);
+                        out[1] = 0.375F * (a[1] + b[1]) + 0.125F * (c[1] + d[1]);
+                        out[2] = 0.375F * (a[2] + b[2]) + 0.125F * (c[2] + d[2]);
+                    }
+                    else
+                    {
+                        out[0] = 0.5F * (a[0] + b[0]);
+                        out[1] = 0.5F * (a[1] + b[1]);
+                        out[2] = 0.5F * (a[2] + b[2]);
+                    }
+                }
+            }
+        });
+
+        // Each face is split into its three corner triangles and the middle one, keeping its orientation. The "edge point"
+        // of a collapsed edge is its single vertex.
+        std::vector<face> new_faces(face_count * 4);
+
+        detail::parallel_for(face_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const [index_v1, index_v2, index_v3] = m_faces[idx].indices();
+                auto const point = [&](std::size_t const side, index_type const corner) -> index_type {
+                    std::size_t const edge = face_edges[idx][side];
+                    return edge == no_edge ? corner : static_cast<index_type>(vertex_count + edge);
+                };
+                index_type const index_v12 = point(0UL, index_v1);
+                index_type const index_v23 = point(1UL, index_v2);
+                index_type const index_v31 = point(2UL, index_v3);
+                new_faces[idx * 4] = face{index_v1, index_v12, index_v31};
+                new_faces[idx * 4 + 1] = face{index_v2, index_v23, index_v12};
+                new_faces[idx * 4 + 2] = face{index_v3, index_v31, index_v23};
+                new_faces[idx * 4 + 3] = face{index_v12, index_v23, index_v31};
+            }
+        });
+
+        m_positions = std::move(new_positions);
+        m_faces = std::move(new_faces);
+        invalidate_topology();
+        drop_stale_attributes();
+    }
+
+    return *this;
+}
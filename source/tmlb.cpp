@@ -0,0 +1,362 @@
+#include "mapped_file.hpp" // tml::detail::mapped_file
+#include "parallel.hpp" // tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::is_sorted, std::ranges::all_of, std::ranges::for_each
+#include <array> // std::array
+#include <bit> // std::rotl
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+#include <fstream> // std::ofstream
+#include <iterator> // std::next
+#include <limits> // std::numeric_limits
+#include <span> // std::span
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_trivially_copyable_v
+#include <utility> // std::move
+#include <vector> // std::vector
+
+using tml::face;
+using tml::mesh;
+
+namespace
+{
+    // File layout: a 64 bytes header followed by the position, face, adjacency offset and adjacency blocks, each of them
+    // starting on a 64 bytes boundary. Vertex indices are stored with the width of the writer's index type and converted
+    // on load when it differs from the reader's one, adjacency offsets always take 64 bits.
+    constexpr std::array<char, 4UL> tmlb_magic{'T', 'M', 'L', 'B'};
+    constexpr std::uint32_t tmlb_version{1U};
+    constexpr std::uint32_t tmlb_byte_order{0x01020304U};
+    constexpr std::uint32_t tmlb_has_adjacency{1U};
+    constexpr std::size_t tmlb_alignment{64UL};
+
+    struct tmlb_header
+    {
+        std::array<char, 4UL> magic{tmlb_magic};
+        std::uint32_t version{tmlb_version};
+        std::uint32_t byte_order{tmlb_byte_order};
+        std::uint32_t index_size{0U};
+        std::uint32_t flags{0U};
+        std::uint32_t reserved{0U};
+        std::uint64_t vertex_count{0U};
+        std::uint64_t face_count{0U};
+        std::uint64_t adjacency_size{0U};
+        std::uint64_t checksum{0U};
+        std::array<char, 8UL> padding{};
+    };
+
+    static_assert(sizeof(tmlb_header) == tmlb_alignment && std::is_trivially_copyable_v<tmlb_header>);
+    static_assert(sizeof(face) == 3UL * sizeof(tml::index_type) && std::is_trivially_copyable_v<face>);
+
+    struct tmlb_layout
+    {
+        std::size_t positions{0UL};
+        std::size_t faces{0UL};
+        std::size_t offsets{0UL};
+        std::size_t adjacency{0UL};
+        std::size_t size{0UL};
+    };
+
+    [[nodiscard]] constexpr auto align(std::size_t const offset) noexcept -> std::size_t
+    {
+        return (offset + tmlb_alignment - 1UL) & ~(tmlb_alignment - 1UL);
+    }
+
+    [[nodiscard]] constexpr auto layout_of(tmlb_header const& header) noexcept -> tmlb_layout
+    {
+        bool const has_adjacency = (header.flags & tmlb_has_adjacency) != 0U;
+        tmlb_layout layout;
+        layout.positions = sizeof(tmlb_header);
+        layout.faces = align(layout.positions + header.vertex_count * 3UL * sizeof(float));
+        layout.offsets = align(layout.faces + header.face_count * 3UL * header.index_size);
+        layout.adjacency = align(layout.offsets + (has_adjacency ? (header.vertex_count + 1UL) * sizeof(std::uint64_t) : 0UL));
+        layout.size = align(layout.adjacency + header.adjacency_size * header.index_size);
+
+        return layout;
+    }
+
+    // Counts are bounded by the file size before computing the layout so that the offsets cannot overflow.
+    [[nodiscard]] constexpr auto fits(tmlb_header const& header, std::size_t const file_size) noexcept -> bool
+    {
+        return header.vertex_count < file_size / (3UL * sizeof(float)) + 1UL &&
+               header.face_count < file_size / (3UL * header.index_size) + 1UL &&
+               header.adjacency_size < file_size / header.index_size + 1UL && layout_of(header).size == file_size;
+    }
+
+    // Word-wise multiply-rotate hash over four independent lanes, fast enough to validate a cache file at memory bandwidth.
+    [[nodiscard]] auto checksum(std::string_view const data, std::uint64_t const seed) noexcept -> std::uint64_t
+    {
+        static constexpr std::uint64_t prime1{0x9E3779B185EBCA87ULL};
+        static constexpr std::uint64_t prime2{0xC2B2AE3D27D4EB4FULL};
+        std::array<std::uint64_t, 4UL> lanes{seed + prime1, seed ^ prime2, seed, seed - prime1};
+        std::size_t offset{0UL};
+
+        for (; offset + sizeof(lanes) <= data.size(); offset += sizeof(lanes))
+        {
+            std::array<std::uint64_t, 4UL> words{};
+            std::memcpy(words.data(), data.data() + offset, sizeof(words));
+
+            for (std::size_t lane{0UL}; lane < lanes.size(); ++lane)
+            {
+                lanes[lane] = std::rotl(lanes[lane] + words[lane] * prime2, 31) * prime1;
+            }
+        }
+
+        std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+
+        for (; offset < data.size(); ++offset)
+        {
+            hash = std::rotl(hash ^ (static_cast<std::uint64_t>(static_cast<unsigned char>(data[offset])) * prime1), 11) * prime2;
+        }
+
+        hash ^= data.size();
+        hash ^= hash >> 33U;
+        hash *= prime2;
+        hash ^= hash >> 29U;
+
+        return hash;
+    }
+
+    [[nodiscard]] auto bytes_of(auto const& values) noexcept -> std::string_view
+    {
+        return {reinterpret_cast<char const*>(values.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                values.size() * sizeof(values[0])};
+    }
+
+    // Copies count stored indices into destination as Index values, widening or narrowing them when the writer used another
+    // width. Fails when a stored value does not fit in Index.
+    template <typename Index>
+    [[nodiscard]] auto load_indices(char const* source, std::size_t const index_size, void* destination,
+                                    std::size_t const count) noexcept -> bool
+    {
+        if (index_size == sizeof(Index))
+        {
+            std::memcpy(destination, source, count * sizeof(Index));
+            return true;
+        }
+
+        auto* output = static_cast<char*>(destination);
+
+        for (std::size_t idx{0UL}; idx < count; ++idx, source += index_size, output += sizeof(Index))
+        {
+            std::uint64_t value{0U};
+
+            if (index_size == sizeof(std::uint32_t))
+            {
+                std::uint32_t narrow{0U};
+                std::memcpy(&narrow, source, sizeof(narrow));
+                value = narrow;
+            }
+            else
+            {
+                std::memcpy(&value, source, sizeof(value));
+            }
+
+            if (value > std::numeric_limits<Index>::max()) [[unlikely]]
+            {
+                return false;
+            }
+
+            auto const index = static_cast<Index>(value);
+            std::memcpy(output, &index, sizeof(index));
+        }
+
+        return true;
+    }
+
+    auto write_block(std::ofstream& file, std::string_view const block) -> void
+    {
+        static constexpr std::array<char, tmlb_alignment> zeros{};
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        file.write(zeros.data(), static_cast<std::streamsize>(align(block.size()) - block.size()));
+    }
+} // namespace
+
+auto mesh::load_from_tmlb(std::filesystem::path const& filepath) noexcept -> parse_error
+{
+    detail::mapped_file file;
+
+    if (auto const error = file.open(filepath); error != error_code::none) [[unlikely]]
+    {
+        return parse_error{.code = error};
+    }
+
+    auto const content = file.view();
+    tmlb_header header;
+
+    if (content.size() < sizeof(header)) [[unlikely]]
+    {
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    std::memcpy(&header, content.data(), sizeof(header));
+
+    if (header.magic != tmlb_magic) [[unlikely]]
+    {
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    if (header.version != tmlb_version || header.byte_order != tmlb_byte_order) [[unlikely]]
+    {
+        return parse_error{.code = error_code::unsupported_format};
+    }
+
+    if ((header.index_size != sizeof(std::uint32_t) && header.index_size != sizeof(std::uint64_t)) ||
+        !fits(header, content.size())) [[unlikely]]
+    {
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    auto const layout = layout_of(header);
+    bool const has_adjacency = (header.flags & tmlb_has_adjacency) != 0U;
+    auto const vertex_count = static_cast<std::size_t>(header.vertex_count);
+    auto const face_count = static_cast<std::size_t>(header.face_count);
+    auto const adjacency_size = static_cast<std::size_t>(header.adjacency_size);
+    std::size_t const index_size = header.index_size;
+    auto const block = [&content](std::size_t const offset, std::size_t const size) -> std::string_view {
+        return content.substr(offset, size);
+    };
+
+    auto stored = header;
+    stored.checksum = 0U;
+    std::uint64_t hash = checksum(bytes_of(std::span{&stored, 1UL}), 0U);
+    hash = checksum(block(layout.positions, vertex_count * 3UL * sizeof(float)), hash);
+    hash = checksum(block(layout.faces, face_count * 3UL * index_size), hash);
+
+    if (has_adjacency)
+    {
+        hash = checksum(block(layout.offsets, (vertex_count + 1UL) * sizeof(std::uint64_t)), hash);
+        hash = checksum(block(layout.adjacency, adjacency_size * index_size), hash);
+    }
+
+    if (hash != header.checksum) [[unlikely]]
+    {
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    std::size_t const first_coordinate = m_positions.size();
+    std::size_t const first_face = m_faces.size();
+    std::size_t const first_vertex = first_coordinate / 3;
+
+    if (vertex_count > max_vertex_count - first_vertex) [[unlikely]]
+    {
+        return parse_error{.code = error_code::index_out_of_range};
+    }
+
+    invalidate_topology();
+    m_positions.resize(first_coordinate + vertex_count * 3UL);
+    m_faces.resize(first_face + face_count);
+    std::memcpy(std::next(m_positions.data(), static_cast<std::ptrdiff_t>(first_coordinate)), content.data() + layout.positions,
+                vertex_count * 3UL * sizeof(float));
+
+    auto const faces = std::span{m_faces}.subspan(first_face);
+    bool const loaded = load_indices<index_type>(content.data() + layout.faces, index_size, faces.data(), face_count * 3UL);
+
+    auto const in_range = [vertex_count](std::size_t const index) -> bool { return index < vertex_count; };
+
+    if (!loaded || !std::ranges::all_of(faces, [&in_range](face const& face) -> bool {
+            return std::ranges::all_of(face.indices(), in_range);
+        })) [[unlikely]]
+    {
+        m_positions.resize(first_coordinate);
+        m_faces.resize(first_face);
+        return parse_error{.code = error_code::invalid_data};
+    }
+
+    if (first_vertex != 0UL)
+    {
+        std::ranges::for_each(faces, [first_vertex](face& face) -> void {
+            auto const [index_v1, index_v2, index_v3] = face.indices();
+            auto const offset = static_cast<index_type>(first_vertex);
+            face = tml::face{index_v1 + offset, index_v2 + offset, index_v3 + offset};
+        });
+
+        return parse_error{.code = error_code::none};
+    }
+
+    // The stored adjacency only describes this file, so it is kept only when the mesh was empty before loading it.
+    if (has_adjacency)
+    {
+        csr_adjacency stored;
+        stored.offsets.resize(vertex_count + 1UL);
+        stored.neighbors.resize(adjacency_size);
+        bool const valid =
+            load_indices<std::size_t>(content.data() + layout.offsets, sizeof(std::uint64_t), stored.offsets.data(),
+                                      vertex_count + 1UL) &&
+            load_indices<index_type>(content.data() + layout.adjacency, index_size, stored.neighbors.data(), adjacency_size) &&
+            stored.offsets.front() == 0UL && stored.offsets.back() == adjacency_size &&
+            std::is_sorted(stored.offsets.begin(), stored.offsets.end()) &&
+            std::ranges::all_of(stored.neighbors, [vertex_count](std::size_t const index) -> bool { return index < vertex_count; });
+
+        if (!valid) [[unlikely]]
+        {
+            invalidate_topology();
+            m_positions.resize(first_coordinate);
+            m_faces.resize(first_face);
+            return parse_error{.code = error_code::invalid_data};
+        }
+
+        m_adjacency.assign(std::move(stored));
+    }
+
+    return parse_error{.code = error_code::none};
+}
+
+auto mesh::save_to_tmlb(std::filesystem::path const& filepath, write_options const& options) const noexcept -> write_error
+{
+    if (!options.can_overwrite && std::filesystem::exists(filepath)) [[unlikely]]
+    {
+        return write_error{.code = error_code::file_already_exists};
+    }
+
+    std::ofstream file{filepath, std::ios_base::binary};
+
+    if (!file) [[unlikely]]
+    {
+        return std::filesystem::exists(filepath) ? write_error{.code = error_code::unknown_io_error}
+                                                 : write_error{.code = error_code::file_not_found};
+    }
+
+    csr_adjacency const none;
+    auto const& graph = options.store_adjacency ? adjacency(detail::thread_count(options.threads)) : none;
+    bool const has_adjacency = options.store_adjacency && !m_positions.empty();
+    tmlb_header header;
+    header.index_size = sizeof(index_type);
+    header.flags = has_adjacency ? tmlb_has_adjacency : 0U;
+    header.vertex_count = m_positions.size() / 3;
+    header.face_count = m_faces.size();
+    header.adjacency_size = has_adjacency ? graph.neighbors.size() : 0UL;
+
+    auto const positions = bytes_of(m_positions);
+    auto const faces = bytes_of(m_faces);
+    std::vector<std::uint64_t> wide_offsets;
+
+    if (has_adjacency && sizeof(std::size_t) != sizeof(std::uint64_t))
+    {
+        wide_offsets.assign(graph.offsets.begin(), graph.offsets.end());
+    }
+
+    auto const offsets = sizeof(std::size_t) == sizeof(std::uint64_t) ? bytes_of(graph.offsets) : bytes_of(wide_offsets);
+    std::uint64_t hash = checksum(bytes_of(std::span{&header, 1UL}), 0U);
+    hash = checksum(positions, hash);
+    hash = checksum(faces, hash);
+
+    if (has_adjacency)
+    {
+        hash = checksum(offsets, hash);
+        hash = checksum(bytes_of(graph.neighbors), hash);
+    }
+
+    header.checksum = hash;
+    write_block(file, bytes_of(std::span{&header, 1UL}));
+    write_block(file, positions);
+    write_block(file, faces);
+
+    if (has_adjacency)
+    {
+        write_block(file, offsets);
+        write_block(file, bytes_of(graph.neighbors));
+    }
+
+    return file ? write_error{.code = error_code::none} : write_error{.code = error_code::unknown_io_error};
+}
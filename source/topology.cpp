@@ -0,0 +1,248 @@
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "radix_sort.hpp" // tml::detail::radix_sort
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::minmax, std::sort, std::unique, std::lower_bound, std::copy
+#include <cstddef> // std::ptrdiff_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <limits> // std::numeric_limits
+#include <numeric> // std::inclusive_scan
+#include <span> // std::span
+#include <utility> // std::pair
+#include <vector> // std::vector
+
+using tml::edge;
+using tml::face;
+using tml::mesh;
+using tml::topology_report;
+
+namespace
+{
+    // Undirected edges are packed as (min << 32 | max), which keeps their lexicographic order.
+    [[nodiscard]] constexpr auto pack(std::size_t const v1, std::size_t const v2) noexcept -> std::uint64_t
+    {
+        auto const [low, high] = std::minmax(v1, v2);
+        return (static_cast<std::uint64_t>(low) << 32U) | static_cast<std::uint64_t>(high);
+    }
+
+    [[nodiscard]] constexpr auto unpack(std::uint64_t const key) noexcept -> edge
+    {
+        return {static_cast<tml::index_type>(key >> 32U), static_cast<tml::index_type>(key & 0xFFFFFFFFU)};
+    }
+
+    // Sorted keys hold each edge once per incident face: a run of one is a boundary edge, of more than two a non-manifold one.
+    template <typename Key, typename Edge>
+    auto count_runs(std::span<Key const> const keys, Edge const& to_edge, topology_report& report) -> void
+    {
+        for (std::size_t first{0UL}; first < keys.size();)
+        {
+            std::size_t last = first + 1UL;
+
+            while (last < keys.size() && keys[last] == keys[first])
+            {
+                ++last;
+            }
+
+            if (last - first == 1UL)
+            {
+                report.boundary_edges.push_back(to_edge(keys[first]));
+            }
+            else if (last - first > 2UL)
+            {
+                report.non_manifold_edges.push_back(to_edge(keys[first]));
+            }
+
+            first = last;
+        }
+    }
+
+    // Boundary loops are traced along the boundary edges, each oriented as in its only face, so that two holes meeting at a
+    // vertex count apart. A walk goes from edge to edge, closing a loop whenever it comes back to a vertex it went through
+    // and resuming from there. A walk stopping at a vertex with no edge left, which only faces of inconsistent
+    // orientations or non-manifold edges leave, counts as one loop as well; walks start from the vertices more edges leave
+    // than reach, so that such an open chain is followed from one of its ends.
+    [[nodiscard]] auto count_loops(std::span<face const> const faces, std::vector<edge> const& edges, std::size_t const threads)
+        -> std::size_t
+    {
+        if (edges.empty())
+        {
+            return 0UL;
+        }
+
+        auto const less = [](edge const& lhs, edge const& rhs) -> bool {
+            return lhs.v1 != rhs.v1 ? lhs.v1 < rhs.v1 : lhs.v2 < rhs.v2;
+        };
+
+        // A boundary edge has a single face, so each slot is written once.
+        std::vector<edge> directed(edges.size());
+
+        tml::detail::parallel_for(faces.size(), threads, 1UL << 16U, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const& corners = faces[idx].indices();
+
+                for (std::size_t side{0UL}; side < 3UL; ++side)
+                {
+                    auto const from = corners[side];
+                    auto const to = corners[(side + 1UL) % 3UL];
+                    auto const [low, high] = std::minmax(from, to);
+                    auto const found = std::lower_bound(edges.begin(), edges.end(), edge{low, high}, less);
+
+                    if (found != edges.end() && *found == edge{low, high})
+                    {
+                        directed[static_cast<std::size_t>(found - edges.begin())] = edge{from, to};
+                    }
+                }
+            }
+        });
+
+        std::vector<std::size_t> vertices;
+        vertices.reserve(edges.size() * 2UL);
+
+        for (auto const& edge : edges)
+        {
+            vertices.push_back(edge.v1);
+            vertices.push_back(edge.v2);
+        }
+
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+        auto const id = [&vertices](std::size_t const vertex) -> std::size_t {
+            return static_cast<std::size_t>(std::lower_bound(vertices.begin(), vertices.end(), vertex) - vertices.begin());
+        };
+
+        // Edges leaving each vertex, as ranges of targets, and the balance of the edges leaving and reaching it.
+        std::vector<std::size_t> offsets(vertices.size() + 1UL, 0UL);
+        std::vector<std::ptrdiff_t> balance(vertices.size(), 0);
+
+        for (auto const& edge : directed)
+        {
+            ++offsets[id(edge.v1) + 1UL];
+            ++balance[id(edge.v1)];
+            --balance[id(edge.v2)];
+        }
+
+        std::inclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<std::size_t> cursors(offsets.begin(), offsets.end() - 1);
+        std::vector<std::size_t> targets(directed.size());
+
+        for (auto const& edge : directed)
+        {
+            targets[cursors[id(edge.v1)]++] = id(edge.v2);
+        }
+
+        std::copy(offsets.begin(), offsets.end() - 1, cursors.begin());
+
+        static constexpr std::size_t off_path{std::numeric_limits<std::size_t>::max()};
+        std::vector<std::size_t> positions(vertices.size(), off_path);
+        std::vector<std::size_t> path;
+        std::size_t loops{0UL};
+
+        auto const walk = [&](std::size_t const start) -> void {
+            while (cursors[start] < offsets[start + 1UL])
+            {
+                path.push_back(start);
+                positions[start] = 0UL;
+
+                while (!path.empty())
+                {
+                    std::size_t const vertex = path.back();
+
+                    if (cursors[vertex] == offsets[vertex + 1UL])
+                    {
+                        // An open chain, or the start of a walk whose loops all closed.
+                        loops += path.size() > 1UL ? 1UL : 0UL;
+
+                        for (auto const node : path)
+                        {
+                            positions[node] = off_path;
+                        }
+
+                        path.clear();
+                        break;
+                    }
+
+                    std::size_t const next = targets[cursors[vertex]++];
+
+                    if (positions[next] == off_path)
+                    {
+                        positions[next] = path.size();
+                        path.push_back(next);
+                        continue;
+                    }
+
+                    ++loops;
+
+                    while (path.size() > positions[next] + 1UL)
+                    {
+                        positions[path.back()] = off_path;
+                        path.pop_back();
+                    }
+                }
+            }
+        };
+
+        for (std::size_t vertex{0UL}; vertex < vertices.size(); ++vertex)
+        {
+            if (balance[vertex] > 0)
+            {
+                walk(vertex);
+            }
+        }
+
+        for (std::size_t vertex{0UL}; vertex < vertices.size(); ++vertex)
+        {
+            walk(vertex);
+        }
+
+        return loops;
+    }
+} // namespace
+
+auto mesh::is_closed() const noexcept -> bool { return analyze_topology().is_closed(); }
+
+auto mesh::analyze_topology(std::size_t const threads) const noexcept -> topology_report
+{
+    std::size_t const thread_count = detail::thread_count(threads);
+    topology_report report;
+
+    if (m_positions.size() / 3 <= std::numeric_limits<std::uint32_t>::max())
+    {
+        std::vector<std::uint64_t> keys(m_faces.size() * 3UL);
+
+        detail::parallel_for(m_faces.size(), thread_count, 1UL << 16U, [&](std::size_t const begin, std::size_t const end) {
+            for (std::size_t idx{begin}; idx < end; ++idx)
+            {
+                auto const [index_v1, index_v2, index_v3] = m_faces[idx].indices();
+                keys[idx * 3] = pack(index_v1, index_v2);
+                keys[idx * 3 + 1] = pack(index_v2, index_v3);
+                keys[idx * 3 + 2] = pack(index_v3, index_v1);
+            }
+        });
+
+        detail::radix_sort(keys, thread_count);
+        count_runs(std::span<std::uint64_t const>{keys}, unpack, report);
+    }
+    else
+    {
+        std::vector<std::pair<index_type, index_type>> keys;
+        keys.reserve(m_faces.size() * 3UL);
+
+        for (auto const& face : m_faces)
+        {
+            auto const [index_v1, index_v2, index_v3] = face.indices();
+            keys.push_back(std::minmax(index_v1, index_v2));
+            keys.push_back(std::minmax(index_v2, index_v3));
+            keys.push_back(std::minmax(index_v3, index_v1));
+        }
+
+        std::sort(keys.begin(), keys.end());
+        count_runs(std::span<std::pair<index_type, index_type> const>{keys},
+                   [](auto const& key) -> edge { return {key.first, key.second}; }, report);
+    }
+
+    report.boundary_loops = count_loops(m_faces, report.boundary_edges, thread_count);
+
+    return report;
+}
@@ -0,0 +1,136 @@
+#include "cpu.hpp" // TML_X86_64
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <cstddef> // std::size_t
+
+#if TML_X86_64
+#include <immintrin.h> // __m128 and its intrinsics
+#endif
+
+using tml::aabb;
+using tml::matrix4;
+using tml::mesh;
+
+namespace
+{
+    // Below this many vertices per thread, spawning threads costs more than transforming the vertices.
+    constexpr std::size_t transform_grain{1UL << 16U};
+
+    // A kernel transforms count consecutive vertices in place. Every kernel evaluates each row as ((m0 * x + m1 * y) + m2 *
+    // z) + m3 with the same float operations, so they give identical positions.
+    using transform_kernel = auto (*)(float* positions, std::size_t count, matrix4 const& matrix) noexcept -> void;
+
+    template <bool Projective>
+    auto transform_scalar(float* positions, std::size_t const count, matrix4 const& matrix) noexcept -> void
+    {
+        auto const& [r0, r1, r2, r3] = matrix.rows;
+
+        for (float* position = positions; position != positions + count * 3; position += 3)
+        {
+            float const x = position[0];
+            float const y = position[1];
+            float const z = position[2];
+            position[0] = r0[0] * x + r0[1] * y + r0[2] * z + r0[3];
+            position[1] = r1[0] * x + r1[1] * y + r1[2] * z + r1[3];
+            position[2] = r2[0] * x + r2[1] * y + r2[2] * z + r2[3];
+
+            if constexpr (Projective)
+            {
+                float const w = r3[0] * x + r3[1] * y + r3[2] * z + r3[3];
+                position[0] /= w;
+                position[1] /= w;
+                position[2] /= w;
+            }
+        }
+    }
+
+#if TML_X86_64
+    // SSE2 is part of the x86-64 baseline: four packed vertices are loaded as three registers, transposed to one register
+    // per axis, transformed and transposed back, so that the whole pass streams through contiguous memory.
+    template <bool Projective>
+    auto transform_sse(float* positions, std::size_t const count, matrix4 const& matrix) noexcept -> void
+    {
+        static constexpr std::size_t lanes{4UL};
+        std::size_t const vector_count = count - count % lanes;
+
+        // The broadcasts are loop invariant and hoisted out of the loop once inlined.
+        auto const evaluate = [&matrix](std::size_t const row, __m128 const x, __m128 const y, __m128 const z) -> __m128 {
+            auto const& m = matrix.rows[row];
+            return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0]), x), _mm_mul_ps(_mm_set1_ps(m[1]), y)),
+                                         _mm_mul_ps(_mm_set1_ps(m[2]), z)),
+                              _mm_set1_ps(m[3]));
+        };
+
+        for (float* position = positions; position != positions + vector_count * 3; position += lanes * 3)
+        {
+            // a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3).
+            __m128 const a = _mm_loadu_ps(position);
+            __m128 const b = _mm_loadu_ps(position + 4);
+            __m128 const c = _mm_loadu_ps(position + 8);
+            __m128 const x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+            __m128 const y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 const z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+            __m128 tx = evaluate(0UL, x, y, z);
+            __m128 ty = evaluate(1UL, x, y, z);
+            __m128 tz = evaluate(2UL, x, y, z);
+
+            if constexpr (Projective)
+            {
+                __m128 const w = evaluate(3UL, x, y, z);
+                tx = _mm_div_ps(tx, w);
+                ty = _mm_div_ps(ty, w);
+                tz = _mm_div_ps(tz, w);
+            }
+
+            _mm_storeu_ps(position, _mm_shuffle_ps(_mm_shuffle_ps(tx, ty, _MM_SHUFFLE(0, 0, 0, 0)),
+                                                   _mm_shuffle_ps(tz, tx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(position + 4, _mm_shuffle_ps(_mm_shuffle_ps(ty, tz, _MM_SHUFFLE(1, 1, 1, 1)),
+                                                       _mm_shuffle_ps(tx, ty, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(position + 8, _mm_shuffle_ps(_mm_shuffle_ps(tz, tx, _MM_SHUFFLE(3, 3, 2, 2)),
+                                                       _mm_shuffle_ps(ty, tz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        transform_scalar<Projective>(positions + vector_count * 3, count - vector_count, matrix);
+    }
+#endif
+
+    [[nodiscard]] auto select_transform_kernel(bool const affine) noexcept -> transform_kernel
+    {
+#if TML_X86_64
+        return affine ? transform_sse<false> : transform_sse<true>;
+#else
+        return affine ? transform_scalar<false> : transform_scalar<true>;
+#endif
+    }
+} // namespace
+
+auto mesh::transform(matrix4 const& matrix, std::size_t const threads) noexcept -> mesh&
+{
+    transform_kernel const kernel = select_transform_kernel(matrix.is_affine());
+    float* const positions = m_positions.data();
+
+    detail::parallel_for(m_positions.size() / 3, detail::thread_count(threads), transform_grain,
+                         [kernel, positions, &matrix](std::size_t const begin, std::size_t const end) -> void {
+                             kernel(positions + begin * 3, end - begin, matrix);
+                         });
+
+    // Without rotation nor shear, each coordinate goes through a monotonic function of itself only, so the transformed
+    // corners of the cached box bound the transformed vertices exactly.
+    bool const axis_aligned = matrix.is_affine() && matrix.rows[0][1] == 0.0F && matrix.rows[0][2] == 0.0F &&
+                              matrix.rows[1][0] == 0.0F && matrix.rows[1][2] == 0.0F && matrix.rows[2][0] == 0.0F &&
+                              matrix.rows[2][1] == 0.0F;
+
+    bool const keep_bounds = m_bounds.valid() && axis_aligned && !m_positions.empty();
+    aabb const& previous = m_bounds.peek();
+    aabb const bounds = keep_bounds ? aabb{}.extend(matrix.apply(previous.min)).extend(matrix.apply(previous.max)) : aabb{};
+    invalidate_positions();
+
+    if (keep_bounds)
+    {
+        m_bounds.assign(bounds);
+    }
+
+    return *this;
+}
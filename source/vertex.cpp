@@ -2,6 +2,8 @@
 
 #include "tml/vec3.hpp" // tml::vec3
 
+#include <algorithm> // std::ranges::find
+
 using tml::vertex;
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
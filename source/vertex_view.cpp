@@ -0,0 +1,44 @@
+#include "tml/vertex_view.hpp"
+
+#include "tml/mesh.hpp" // tml::mesh
+
+using tml::mesh;
+using tml::vertex;
+using tml::vertex_ref;
+using tml::vertex_view;
+
+vertex_ref::vertex_ref(mesh const& owner, std::size_t index) noexcept : m_mesh{&owner}, m_index{index} {}
+
+auto vertex_ref::x() const noexcept -> float { return m_mesh->positions()[m_index * 3]; }
+
+auto vertex_ref::y() const noexcept -> float { return m_mesh->positions()[m_index * 3 + 1]; }
+
+auto vertex_ref::z() const noexcept -> float { return m_mesh->positions()[m_index * 3 + 2]; }
+
+auto vertex_ref::index() const noexcept -> std::size_t { return m_index; }
+
+auto vertex_ref::neighbors() const noexcept -> std::span<tml::index_type const> { return m_mesh->neighbors(m_index); }
+
+vertex_ref::operator vertex() const noexcept
+{
+    vertex v{x(), y(), z()};
+
+    for (auto const neighbor : neighbors())
+    {
+        v.add_neighbor(neighbor);
+    }
+
+    return v;
+}
+
+vertex_view::vertex_view(mesh const& owner) noexcept : m_mesh{&owner} {}
+
+auto vertex_view::size() const noexcept -> std::size_t { return m_mesh->positions().size() / 3; }
+
+auto vertex_view::empty() const noexcept -> bool { return size() == 0UL; }
+
+auto vertex_view::begin() const noexcept -> iterator { return iterator{*m_mesh, 0UL}; }
+
+auto vertex_view::end() const noexcept -> iterator { return iterator{*m_mesh, size()}; }
+
+auto vertex_view::operator[](std::size_t index) const noexcept -> vertex_ref { return vertex_ref{*m_mesh, index}; }
@@ -0,0 +1,267 @@
+#include "parallel.hpp" // tml::detail::parallel_for, tml::detail::thread_count
+#include "tml/mesh.hpp"
+
+#include <algorithm> // std::min
+#include <array> // std::array
+#include <atomic> // std::atomic
+#include <bit> // std::bit_cast, std::bit_ceil
+#include <cmath> // std::floor
+#include <cstdint> // std::int64_t, std::uint32_t, std::uint64_t
+#include <numeric> // std::inclusive_scan
+#include <span> // std::span
+#include <utility> // std::swap
+#include <vector> // std::vector
+
+using tml::face;
+using tml::mesh;
+
+namespace
+{
+    using cell = std::array<std::int64_t, 3UL>;
+
+    [[nodiscard]] constexpr auto hash(cell const& coordinates) noexcept -> std::uint64_t
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(coordinates[0]) * 0x9E3779B97F4A7C15ULL;
+        h ^= static_cast<std::uint64_t>(coordinates[1]) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= static_cast<std::uint64_t>(coordinates[2]) * 0x165667B19E3779F9ULL;
+        h ^= h >> 32U;
+
+        return h;
+    }
+} // namespace
+
+auto mesh::weld(float const epsilon, std::size_t const threads) noexcept -> mesh&
+{
+    static constexpr std::size_t grain{1UL << 14U};
+    static constexpr double cell_limit{0x1p62};
+    std::size_t const thread_count = detail::thread_count(threads);
+    std::size_t const vertex_count = m_positions.size() / 3;
+
+    if (vertex_count == 0UL)
+    {
+        return *this;
+    }
+
+    // Vertices are bucketed on a uniform grid of cell size epsilon, so that any vertex within epsilon of another one lies in
+    // one of the 27 cells around it. Without tolerance, the cell of a vertex is its bit pattern and only its own is searched.
+    bool const exact = !(epsilon > 0.0F);
+    double const inverse = exact ? 0.0 : 1.0 / static_cast<double>(epsilon);
+    float const squared_epsilon = epsilon * epsilon;
+    std::int64_t const reach = exact ? 0 : 1;
+    float const* const positions = m_positions.data();
+
+    auto const cell_of = [&](std::size_t const vertex) -> cell {
+        cell coordinates{};
+
+        for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+        {
+            // -0.0 and 0.0 are equal but differ in their bits, fold them into the same cell.
+            float const coordinate = positions[vertex * 3 + axis] + 0.0F;
+
+            if (exact)
+            {
+                coordinates[axis] = std::bit_cast<std::uint32_t>(coordinate);
+                continue;
+            }
+
+            double const scaled = std::floor(static_cast<double>(coordinate) * inverse);
+            coordinates[axis] = scaled >= -cell_limit && scaled <= cell_limit ? static_cast<std::int64_t>(scaled) : 0;
+        }
+
+        return coordinates;
+    };
+
+    auto const close = [&](std::size_t const v1, std::size_t const v2) -> bool {
+        float const* const p1 = positions + v1 * 3;
+        float const* const p2 = positions + v2 * 3;
+
+        if (exact)
+        {
+            return p1[0] == p2[0] && p1[1] == p2[1] && p1[2] == p2[2];
+        }
+
+        float const dx = p1[0] - p2[0];
+        float const dy = p1[1] - p2[1];
+        float const dz = p1[2] - p2[2];
+
+        return dx * dx + dy * dy + dz * dz <= squared_epsilon;
+    };
+
+    // Hash table of the cells laid out as compressed rows: the vertices of bucket b are slots[offsets[b], offsets[b + 1]).
+    std::size_t const mask = std::bit_ceil(vertex_count) - 1UL;
+    std::vector<std::size_t> buckets(vertex_count);
+    std::vector<std::atomic<std::size_t>> cursors(mask + 2UL);
+
+    detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            buckets[vertex] = static_cast<std::size_t>(hash(cell_of(vertex))) & mask;
+            cursors[buckets[vertex] + 1].fetch_add(1UL, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<std::size_t> offsets(mask + 2UL, 0UL);
+
+    for (std::size_t bucket{1UL}; bucket < offsets.size(); ++bucket)
+    {
+        offsets[bucket] = offsets[bucket - 1] + cursors[bucket].load(std::memory_order_relaxed);
+        cursors[bucket - 1].store(offsets[bucket - 1], std::memory_order_relaxed);
+    }
+
+    std::vector<index_type> slots(vertex_count);
+
+    detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            slots[cursors[buckets[vertex]].fetch_add(1UL, std::memory_order_relaxed)] = static_cast<index_type>(vertex);
+        }
+    });
+
+    // Close pairs are merged in a union-find whose links always go from the higher index root to the lower one, so that
+    // every group of vertices connected by close pairs ends up rooted at its lowest index vertex. The groups and their
+    // roots do not depend on the order the pairs are merged in, and neither does the result on the thread count.
+    std::vector<std::atomic<index_type>> parents(vertex_count);
+
+    for (std::size_t vertex{0UL}; vertex < vertex_count; ++vertex)
+    {
+        parents[vertex].store(static_cast<index_type>(vertex), std::memory_order_relaxed);
+    }
+
+    auto const find = [&parents](index_type vertex) -> index_type {
+        for (index_type parent = parents[vertex].load(); parent != vertex; parent = parents[vertex].load())
+        {
+            // Path halving: pointing to the grandparent only ever skips ancestors, whatever the other threads do.
+            index_type const grandparent = parents[parent].load();
+            parents[vertex].compare_exchange_weak(parent, grandparent);
+            vertex = grandparent;
+        }
+
+        return vertex;
+    };
+
+    auto const unite = [&parents, &find](index_type v1, index_type v2) -> void {
+        while (true)
+        {
+            v1 = find(v1);
+            v2 = find(v2);
+
+            if (v1 == v2)
+            {
+                return;
+            }
+
+            if (v1 < v2)
+            {
+                std::swap(v1, v2);
+            }
+
+            if (index_type expected{v1}; parents[v1].compare_exchange_strong(expected, v2))
+            {
+                return;
+            }
+        }
+    };
+
+    detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            cell const center = cell_of(vertex);
+
+            for (std::int64_t dx{-reach}; dx <= reach; ++dx)
+            {
+                for (std::int64_t dy{-reach}; dy <= reach; ++dy)
+                {
+                    for (std::int64_t dz{-reach}; dz <= reach; ++dz)
+                    {
+                        std::size_t const bucket =
+                            static_cast<std::size_t>(hash({center[0] + dx, center[1] + dy, center[2] + dz})) & mask;
+
+                        auto const candidates = std::span{slots}.subspan(offsets[bucket], offsets[bucket + 1] - offsets[bucket]);
+
+                        for (index_type const other : candidates)
+                        {
+                            if (other < vertex && close(other, vertex))
+                            {
+                                unite(static_cast<index_type>(vertex), other);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // Roots have the lowest index of their group, so numbering them in index order keeps the relative order of the
+    // surviving vertices and every other vertex finds the number of its root already set.
+    std::vector<index_type> representatives(vertex_count);
+    std::vector<index_type> remap(vertex_count);
+    index_type welded_count{0U};
+
+    for (std::size_t vertex{0UL}; vertex < vertex_count; ++vertex)
+    {
+        index_type const representative = find(static_cast<index_type>(vertex));
+        representatives[vertex] = representative;
+        remap[vertex] = representative == vertex ? welded_count++ : remap[representative];
+    }
+
+    std::vector<float> new_positions(std::size_t{welded_count} * 3);
+
+    detail::parallel_for(vertex_count, thread_count, grain, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t vertex{begin}; vertex < end; ++vertex)
+        {
+            if (representatives[vertex] == vertex)
+            {
+                std::size_t const target = std::size_t{remap[vertex]} * 3;
+                new_positions[target] = positions[vertex * 3];
+                new_positions[target + 1] = positions[vertex * 3 + 1];
+                new_positions[target + 2] = positions[vertex * 3 + 2];
+            }
+        }
+    });
+
+    // Faces are remapped in place by blocks, then the non-degenerate ones are gathered in their original order.
+    std::size_t const face_count = m_faces.size();
+    std::size_t const block_count = (face_count + grain - 1UL) / grain;
+    std::vector<std::size_t> kept(block_count + 1UL, 0UL);
+    auto const degenerate = [](face const& face) -> bool {
+        auto const [index_v1, index_v2, index_v3] = face.indices();
+        return index_v1 == index_v2 || index_v2 == index_v3 || index_v3 == index_v1;
+    };
+
+    detail::parallel_for(block_count, thread_count, 1UL, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t block{begin}; block < end; ++block)
+        {
+            for (std::size_t idx = block * grain; idx < std::min(face_count, (block + 1UL) * grain); ++idx)
+            {
+                auto const [index_v1, index_v2, index_v3] = m_faces[idx].indices();
+                m_faces[idx] = face{remap[index_v1], remap[index_v2], remap[index_v3]};
+                kept[block + 1] += degenerate(m_faces[idx]) ? 0UL : 1UL;
+            }
+        }
+    });
+
+    std::inclusive_scan(kept.begin(), kept.end(), kept.begin());
+    std::vector<face> new_faces(kept.back());
+
+    detail::parallel_for(block_count, thread_count, 1UL, [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t block{begin}; block < end; ++block)
+        {
+            std::size_t output = kept[block];
+
+            for (std::size_t idx = block * grain; idx < std::min(face_count, (block + 1UL) * grain); ++idx)
+            {
+                if (!degenerate(m_faces[idx]))
+                {
+                    new_faces[output++] = m_faces[idx];
+                }
+            }
+        }
+    });
+
+    m_positions = std::move(new_positions);
+    m_faces = std::move(new_faces);
+    invalidate_topology();
+    drop_stale_attributes();
+
+    return *this;
+}
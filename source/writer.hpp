@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm> // std::clamp, std::min
+#include <atomic> // std::atomic, std::memory_order_acquire, std::memory_order_release, std::memory_order_relaxed
+#include <cstddef> // std::size_t
+#include <fmt/format.h> // fmt::memory_buffer, fmt::format_to, fmt::format_string
+#include <iterator> // std::back_inserter
+#include <ostream> // std::ostream, std::streamsize
+#include <string_view> // std::string_view
+#include <thread> // std::thread
+#include <utility> // std::forward
+#include <vector> // std::vector
+
+namespace tml::detail
+{
+    // Formats text into a single reusable buffer and hands it to the stream in large blocks, so that writing a mesh neither
+    // allocates per element nor has to seek backwards in the output.
+    class block_writer
+    {
+    public:
+
+        static constexpr std::size_t block_size{1UL << 20U};
+
+        explicit block_writer(std::ostream& stream) : m_stream{stream} { m_buffer.reserve(block_size); }
+
+        template <typename... Args>
+        auto format(fmt::format_string<Args...> format, Args&&... args) -> void
+        {
+            fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
+            flush_if_full();
+        }
+
+        auto write(std::string_view const text) -> void
+        {
+            m_buffer.append(text.data(), text.data() + text.size());
+            flush_if_full();
+        }
+
+        // Calls fn(buffer, index) for every index of [0, count). With several threads the indices are formatted by batches
+        // of up to max_batch_size elements, several megabytes of text, by as many workers started once for the whole call.
+        // The calling thread writes the batches in order as they complete, so that writing overlaps the formatting of the
+        // next ones, and at most two batches per worker are held at once.
+        template <typename F>
+        auto format_each(std::size_t const count, std::size_t const threads, F const& fn) -> void
+        {
+            std::size_t const batch_size = std::clamp(count / (threads * 4UL), min_batch_size, max_batch_size);
+            std::size_t const batches = (count + batch_size - 1UL) / batch_size;
+
+            if (threads == 1UL || batches < 2UL)
+            {
+                for (std::size_t index{0UL}; index < count; ++index)
+                {
+                    fn(m_buffer, index);
+                    flush_if_full();
+                }
+
+                return;
+            }
+
+            flush();
+
+            // A slot goes through the stages 2 * batch, free for that batch, then 2 * batch + 1, once it is formatted, and
+            // becomes free again for the batch a window later once written.
+            std::size_t const workers = std::min(threads, batches);
+            std::size_t const window = std::min(batches, workers * 2UL);
+            std::vector<batch_slot> slots(window);
+
+            for (std::size_t slot{0UL}; slot < window; ++slot)
+            {
+                slots[slot].stage.store(slot * 2UL, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::size_t> next{0UL};
+            std::vector<std::thread> pool;
+            pool.reserve(workers);
+
+            for (std::size_t worker{0UL}; worker < workers; ++worker)
+            {
+                pool.emplace_back([&]() -> void {
+                    for (std::size_t batch = next.fetch_add(1UL); batch < batches; batch = next.fetch_add(1UL))
+                    {
+                        auto& slot = slots[batch % window];
+                        slot.wait_for(batch * 2UL);
+                        slot.buffer.clear();
+                        std::size_t const last = std::min(count, (batch + 1UL) * batch_size);
+
+                        for (std::size_t index = batch * batch_size; index < last; ++index)
+                        {
+                            fn(slot.buffer, index);
+                        }
+
+                        slot.advance_to(batch * 2UL + 1UL);
+                    }
+                });
+            }
+
+            for (std::size_t batch{0UL}; batch < batches; ++batch)
+            {
+                auto& slot = slots[batch % window];
+                slot.wait_for(batch * 2UL + 1UL);
+                m_stream.write(slot.buffer.data(), static_cast<std::streamsize>(slot.buffer.size()));
+                slot.advance_to((batch + window) * 2UL);
+            }
+
+            for (auto& thread : pool)
+            {
+                thread.join();
+            }
+        }
+
+        auto flush() -> void
+        {
+            m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_buffer.clear();
+        }
+
+    private:
+
+        static constexpr std::size_t min_batch_size{1UL << 14U};
+
+        static constexpr std::size_t max_batch_size{1UL << 18U};
+
+        // Text of one batch of format_each and the stage it is at, which the workers and the writing thread wait on.
+        struct batch_slot
+        {
+            fmt::memory_buffer buffer;
+            std::atomic<std::size_t> stage{0UL};
+
+            auto wait_for(std::size_t const target) const noexcept -> void
+            {
+                for (std::size_t current = stage.load(std::memory_order_acquire); current != target;
+                     current = stage.load(std::memory_order_acquire))
+                {
+                    stage.wait(current, std::memory_order_acquire);
+                }
+            }
+
+            auto advance_to(std::size_t const target) noexcept -> void
+            {
+                stage.store(target, std::memory_order_release);
+                stage.notify_all();
+            }
+        };
+
+        auto flush_if_full() -> void
+        {
+            if (m_buffer.size() >= block_size)
+            {
+                flush();
+            }
+        }
+
+        std::ostream& m_stream;
+        fmt::memory_buffer m_buffer;
+    };
+} // namespace tml::detail
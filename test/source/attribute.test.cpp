@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <tml/attribute.hpp>
+#include <tml/matrix4.hpp>
+#include <tml/mesh.hpp>
+#include <vector>
+
+namespace
+{
+    // Compares the name, type and values of every channel.
+    auto same_channels(std::span<tml::attribute_channel const> const lhs, std::span<tml::attribute_channel const> const rhs)
+        -> bool
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+
+        for (std::size_t channel{0UL}; channel < lhs.size(); ++channel)
+        {
+            if (lhs[channel].name() != rhs[channel].name() || lhs[channel].type() != rhs[channel].type() ||
+                lhs[channel].size() != rhs[channel].size())
+            {
+                return false;
+            }
+
+            for (std::size_t idx{0UL}; idx < lhs[channel].size(); ++idx)
+            {
+                if (lhs[channel].value(idx) != rhs[channel].value(idx))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+TEST_CASE("Attribute channels tests", "[library]")
+{
+    SECTION("Load the other properties of a PLY file with their type")
+    {
+        tml::mesh const mesh{"attributes_input.ply"};
+        REQUIRE(mesh.vertices().size() == 4UL);
+        REQUIRE(mesh.faces().size() == 4UL);
+        REQUIRE(mesh.faces()[2].indices() == std::array<tml::index_type, 3UL>{0U, 3U, 2U});
+        REQUIRE(mesh.positions()[9] == 0.0F);
+        REQUIRE(mesh.positions()[11] == 1.0F);
+
+        REQUIRE(mesh.vertex_attributes().size() == 4UL);
+        REQUIRE(mesh.vertex_attributes()[0].name() == "red");
+        REQUIRE(mesh.vertex_attributes()[3].name() == "quality");
+
+        auto const* const green = mesh.vertex_attribute("green");
+        REQUIRE(green != nullptr);
+        REQUIRE(green->type() == tml::attribute_type::uint8);
+        REQUIRE(std::ranges::equal(green->values<std::uint8_t>(), std::array<std::uint8_t, 4UL>{0U, 255U, 0U, 20U}));
+
+        auto const* const quality = mesh.vertex_attribute("quality");
+        REQUIRE(quality != nullptr);
+        REQUIRE(quality->type() == tml::attribute_type::float64);
+        REQUIRE(std::ranges::equal(quality->values<double>(), std::array{0.5, 1.5, 2.5, -3.25}));
+
+        // The list of texture coordinates is skipped.
+        REQUIRE(mesh.face_attributes().size() == 2UL);
+        REQUIRE(mesh.face_attribute("texcoord") == nullptr);
+        REQUIRE(std::ranges::equal(mesh.face_attribute("flags")->values<std::uint8_t>(),
+                                   std::array<std::uint8_t, 4UL>{1U, 2U, 4U, 8U}));
+        REQUIRE(std::ranges::equal(mesh.face_attribute("confidence")->values<float>(),
+                                   std::array{0.125F, 0.25F, 0.5F, 1.0F}));
+        REQUIRE(mesh.vertex_attribute("confidence") == nullptr);
+    }
+
+    SECTION("Write the channels back to PLY files")
+    {
+        tml::mesh const mesh{"attributes_input.ply"};
+
+        for (auto const encoding : {tml::encoding::ascii, tml::encoding::binary})
+        {
+            REQUIRE(mesh.write("attributes_output.ply", tml::write_options{.can_overwrite = true, .encoding = encoding}) ==
+                    tml::error_code::none);
+            tml::mesh const written{"attributes_output.ply"};
+
+            REQUIRE(std::ranges::equal(written.positions(), mesh.positions()));
+            REQUIRE(same_channels(written.vertex_attributes(), mesh.vertex_attributes()));
+            REQUIRE(same_channels(written.face_attributes(), mesh.face_attributes()));
+        }
+
+        REQUIRE(mesh.write("attributes_output.ply", tml::write_options{.can_overwrite = true, .store_attributes = false}) ==
+                tml::error_code::none);
+        REQUIRE(tml::mesh{"attributes_output.ply"}.vertex_attributes().empty());
+    }
+
+    SECTION("Parse the channels of large ASCII files the same with several threads")
+    {
+        static constexpr std::size_t vertex_count{30'000UL};
+        std::ofstream file{"large_attributes_input.ply"};
+        file << "ply\nformat ascii 1.0\nelement vertex " << vertex_count
+             << "\nproperty float x\nproperty float y\nproperty float z\nproperty short label\n"
+             << "element face " << vertex_count - 2 << "\nproperty list uchar int vertex_indices\nproperty uint group\n"
+             << "end_header\n";
+
+        for (std::size_t vertex{0UL}; vertex < vertex_count; ++vertex)
+        {
+            file << vertex << " " << vertex % 7 << " 0 " << static_cast<int>(vertex % 601) - 300 << "\n";
+        }
+
+        for (std::size_t face{0UL}; face < vertex_count - 2; ++face)
+        {
+            file << "3 " << face << " " << face + 1 << " " << face + 2 << " " << face * 3 << "\n";
+        }
+
+        file.close();
+
+        tml::mesh const serial{"large_attributes_input.ply", tml::read_options{.threads = 1UL}};
+        tml::mesh const parallel{"large_attributes_input.ply", tml::read_options{.threads = 4UL}};
+        REQUIRE(serial.vertex_attribute("label")->values<std::int16_t>()[601] == -300);
+        REQUIRE(serial.face_attribute("group")->values<std::uint32_t>()[1000] == 3000U);
+        REQUIRE(same_channels(parallel.vertex_attributes(), serial.vertex_attributes()));
+        REQUIRE(same_channels(parallel.face_attributes(), serial.face_attributes()));
+    }
+
+    SECTION("Keep the channels while they cover every element")
+    {
+        tml::mesh mesh{"attributes_input.ply"};
+        mesh.scale(2.0F).invert();
+        REQUIRE(mesh.vertex_attributes().size() == 4UL);
+
+        REQUIRE(mesh.read("attributes_input.ply") == tml::error_code::none);
+        REQUIRE(mesh.vertex_attribute("red")->size() == 8UL);
+        REQUIRE(mesh.face_attribute("flags")->values<std::uint8_t>()[7] == 8U);
+
+        // The faces of input.ply have no attribute, and the colors no longer cover its vertices.
+        REQUIRE(mesh.read("input.ply") == tml::error_code::none);
+        REQUIRE(mesh.vertex_attributes().empty());
+        REQUIRE(mesh.face_attributes().empty());
+
+        tml::mesh subdivided{"attributes_input.ply"};
+        subdivided.subdivide();
+        REQUIRE(subdivided.vertex_attributes().empty());
+        REQUIRE(subdivided.face_attributes().empty());
+
+        REQUIRE(tml::mesh{"input.ply"}.write("attributes_input.stl", {.can_overwrite = true}) == tml::error_code::none);
+        tml::mesh stl{"attributes_input.ply"};
+        REQUIRE(stl.read("attributes_input.stl") == tml::error_code::none);
+        REQUIRE(stl.vertex_attributes().empty());
+    }
+
+    SECTION("Drop the normals read once the positions move")
+    {
+        {
+            std::ofstream file{"normals_input.ply"};
+            file << "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+                    "property float nx\nproperty float ny\nproperty float nz\nproperty uchar red\nelement face 1\n"
+                    "property list uchar int vertex_indices\nend_header\n"
+                    "0 0 0 0 0 1 10\n1 0 0 0 0 1 20\n0 1 0 0 0 1 30\n3 0 1 2\n";
+        }
+
+        tml::mesh const read{"normals_input.ply"};
+        REQUIRE(read.vertex_attribute("nz")->values<float>()[0] == 1.0F);
+
+        // A quarter turn around x takes the normals from z to -y, which the ones read would no longer say.
+        tml::mesh rotated = read;
+        rotated.transform(tml::matrix4::rotation({1.0F, 0.0F, 0.0F}, 1.57079632679F));
+        REQUIRE(rotated.vertex_attribute("nx") == nullptr);
+        REQUIRE(rotated.vertex_attribute("nz") == nullptr);
+        REQUIRE(rotated.vertex_attribute("red") != nullptr);
+
+        REQUIRE(rotated.write("normals_output.ply", {.can_overwrite = true}) == tml::error_code::none);
+        tml::mesh const written{"normals_output.ply"};
+        REQUIRE(written.vertex_attribute("nz") == nullptr);
+        REQUIRE(written.vertex_attribute("red")->values<std::uint8_t>()[2] == 30U);
+
+        REQUIRE(rotated.write("normals_output.ply", {.can_overwrite = true, .store_normals = true}) == tml::error_code::none);
+        tml::mesh const stored{"normals_output.ply"};
+        REQUIRE(stored.vertex_attribute("ny")->values<float>()[1] < -0.999F);
+        REQUIRE(std::abs(stored.vertex_attribute("nz")->values<float>()[1]) < 1e-6F);
+
+        tml::mesh inverted = read;
+        inverted.invert();
+        REQUIRE(inverted.vertex_attribute("nz") == nullptr);
+
+        tml::mesh noisy = read;
+        noisy.noise(0.1F, 5U);
+        REQUIRE(noisy.vertex_attribute("nz") == nullptr);
+
+        tml::mesh along = read;
+        along.noise_along_normals(0.1F, 5U);
+        REQUIRE(along.vertex_attribute("nz") == nullptr);
+    }
+
+    SECTION("Access the values of a channel")
+    {
+        tml::attribute_channel channel{"label", tml::attribute_type::int16, 3UL};
+        channel.values<std::int16_t>()[1] = -7;
+        REQUIRE(channel.size() == 3UL);
+        REQUIRE(channel.element_size() == 2UL);
+        REQUIRE(channel.value(1UL) == -7.0);
+        REQUIRE(channel.values<float>().empty());
+
+        tml::attribute_channel const other{"label", tml::attribute_type::int16, 2UL};
+        REQUIRE(channel.append(other));
+        REQUIRE(channel.size() == 5UL);
+        REQUIRE_FALSE(channel.append(tml::attribute_channel{"label", tml::attribute_type::float32, 1UL}));
+        REQUIRE(channel.size() == 5UL);
+    }
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <tml/bvh.hpp>
+#include <tml/face.hpp>
+#include <tml/mesh.hpp>
+#include <vector>
+
+TEST_CASE("Bounding volume hierarchy tests", "[library]")
+{
+    auto const close = [](float const lhs, float const rhs) -> bool { return std::abs(lhs - rhs) <= 1e-5F; };
+
+    SECTION("Cast rays against a cube")
+    {
+        tml::mesh const mesh{"input.ply"};
+        tml::bvh const bvh{mesh.positions(), mesh.faces()};
+        REQUIRE_FALSE(bvh.empty());
+        REQUIRE(bvh.bounds().min == std::array{-1.0F, -1.0F, -1.0F});
+        REQUIRE(bvh.bounds().max == std::array{1.0F, 1.0F, 1.0F});
+
+        auto const hit = bvh.intersect({.origin = {0.25F, -0.5F, 5.0F}, .direction = {0.0F, 0.0F, -1.0F}});
+        REQUIRE(hit);
+        REQUIRE(close(hit.distance, 4.0F));
+        REQUIRE(std::ranges::all_of(mesh.faces()[hit.face].indices(), [&mesh](auto const index) -> bool {
+            return mesh.positions()[std::size_t{index} * 3 + 2] == 1.0F;
+        }));
+
+        REQUIRE_FALSE(bvh.intersect({.origin = {3.0F, 0.0F, 5.0F}, .direction = {0.0F, 0.0F, -1.0F}}));
+        REQUIRE_FALSE(bvh.intersect({.origin = {0.0F, 0.0F, 5.0F}, .direction = {0.0F, 0.0F, -1.0F}, .t_max = 3.5F}));
+        REQUIRE(close(bvh.intersect({.origin = {0.1F, 0.2F, 0.0F}, .direction = {1.0F, 0.0F, 0.0F}}).distance, 0.9F));
+        REQUIRE_FALSE(tml::bvh{}.intersect({.direction = {1.0F, 0.0F, 0.0F}}));
+    }
+
+    SECTION("Find the closest point and the faces overlapping a box")
+    {
+        tml::mesh const mesh{"input.ply"};
+        tml::bvh const bvh{mesh.positions(), mesh.faces()};
+
+        auto const inside = bvh.closest_point({0.2F, 0.1F, 0.7F});
+        REQUIRE(close(inside.position[2], 1.0F));
+        REQUIRE(close(inside.squared_distance, 0.09F));
+
+        auto const corner = bvh.closest_point({2.0F, 3.0F, 4.0F});
+        REQUIRE(corner.position == std::array{1.0F, 1.0F, 1.0F});
+        REQUIRE(close(corner.squared_distance, 14.0F));
+        REQUIRE_FALSE(bvh.closest_point({std::numeric_limits<float>::infinity(), 0.0F, 0.0F}));
+        REQUIRE_FALSE(bvh.closest_point({std::numeric_limits<float>::quiet_NaN(), 0.0F, 0.0F}));
+
+        auto const top = bvh.overlapping({.min = {-0.5F, -0.5F, 0.9F}, .max = {0.5F, 0.5F, 2.0F}});
+        REQUIRE(top.size() == 2UL);
+        REQUIRE(std::ranges::is_sorted(top));
+        REQUIRE(bvh.overlapping({.min = {2.0F, 2.0F, 2.0F}, .max = {3.0F, 3.0F, 3.0F}}).empty());
+    }
+
+    SECTION("Build over faces with non-finite corners")
+    {
+        constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        std::vector<float> positions{0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, nan, nan, nan, inf, 0.0F, 0.0F};
+        std::vector<tml::face> faces;
+
+        for (std::size_t idx{0UL}; idx < 16UL; ++idx)
+        {
+            faces.emplace_back(0U, 1U, 2U);
+            faces.emplace_back(3U, 3U, 3U);
+            faces.emplace_back(0U, 4U, 2U);
+        }
+
+        tml::bvh const bvh{positions, faces, 2UL};
+        auto const hit = bvh.intersect({.origin = {0.25F, 0.25F, 1.0F}, .direction = {0.0F, 0.0F, -1.0F}});
+        REQUIRE(hit);
+        REQUIRE(close(hit.distance, 1.0F));
+    }
+
+    SECTION("Build and query on several threads")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide(6UL, 4UL);
+        tml::bvh const serial{mesh.positions(), mesh.faces(), 1UL};
+        tml::bvh const parallel{mesh.positions(), mesh.faces(), 4UL};
+        REQUIRE(serial.nodes().size() == parallel.nodes().size());
+
+        std::vector<tml::ray> rays;
+
+        for (std::size_t idx{0UL}; idx < 1000UL; ++idx)
+        {
+            auto const x = static_cast<float>(idx % 7UL) - 3.0F;
+            auto const y = static_cast<float>(idx % 5UL) - 2.0F;
+            rays.push_back({.direction = {x, y, static_cast<float>(idx) * 0.37F - 180.0F}});
+        }
+
+        std::vector<tml::ray_hit> serial_hits(rays.size());
+        std::vector<tml::ray_hit> parallel_hits(rays.size());
+        serial.intersect(rays, serial_hits, 1UL);
+        parallel.intersect(rays, parallel_hits, 4UL);
+
+        for (std::size_t idx{0UL}; idx < rays.size(); ++idx)
+        {
+            REQUIRE(serial_hits[idx]);
+            REQUIRE(serial_hits[idx].face == parallel_hits[idx].face);
+            REQUIRE(serial_hits[idx].distance == parallel_hits[idx].distance);
+        }
+
+        // Compared against faces taken one at a time.
+        for (std::array<float, 3> const point : {std::array{0.3F, -0.2F, 0.1F}, std::array{2.0F, 1.0F, -3.0F}})
+        {
+            auto const closest = parallel.closest_point(point);
+            REQUIRE(closest);
+            REQUIRE(serial.closest_point(point).squared_distance == closest.squared_distance);
+
+            for (std::size_t idx{0UL}; idx < mesh.faces().size(); idx += 101UL)
+            {
+                tml::bvh const single{mesh.positions(), std::span{mesh.faces()}.subspan(idx, 1UL)};
+                REQUIRE(closest.squared_distance <= single.closest_point(point).squared_distance);
+            }
+        }
+    }
+}
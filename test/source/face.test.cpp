@@ -19,4 +19,9 @@ TEST_CASE("Faces tests", "[library]")
         REQUIRE(face.indices()[1] == 1);
         REQUIRE(face.indices()[2] == 0);
     }
+
+    SECTION("Store the indices with the configured width")
+    {
+        REQUIRE(sizeof(tml::face) == 3UL * sizeof(tml::index_type));
+    }
 }
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <tml/half_edge_topology.hpp>
+#include <tml/mesh.hpp>
+#include <vector>
+
+TEST_CASE("Half-edge topology tests", "[library]")
+{
+    SECTION("Pair the half-edges of two triangles sharing an edge")
+    {
+        std::array const faces{tml::face{0, 1, 2}, tml::face{2, 1, 3}};
+        tml::half_edge_topology const topology{faces, 4};
+        REQUIRE(topology.size() == 6UL);
+        REQUIRE(topology.origin(1) == 1U);
+        REQUIRE(topology.target(1) == 2U);
+        REQUIRE(topology.twin(1) == 3U);
+        REQUIRE(topology.twin(3) == 1U);
+        REQUIRE(tml::half_edge_topology::face_of(topology.twin(1)) == 1U);
+        REQUIRE(tml::half_edge_topology::next(tml::half_edge_topology::next(tml::half_edge_topology::next(4))) == 4U);
+        REQUIRE(tml::half_edge_topology::prev(tml::half_edge_topology::next(5)) == 5U);
+        REQUIRE(std::ranges::count_if(std::array{0U, 1U, 2U, 3U, 4U, 5U}, [&topology](auto const half_edge) -> bool {
+                    return topology.is_boundary(half_edge);
+                }) == 4);
+    }
+
+    SECTION("Walk around the vertices of a closed mesh")
+    {
+        tml::mesh const mesh{"input.ply"};
+        auto const& topology = mesh.topology();
+        REQUIRE(topology.size() == mesh.faces().size() * 3UL);
+
+        for (std::size_t half_edge{0UL}; half_edge < topology.size(); ++half_edge)
+        {
+            auto const index = static_cast<tml::half_edge_topology::index_type>(half_edge);
+            REQUIRE_FALSE(topology.is_boundary(index));
+            REQUIRE(topology.twin(topology.twin(index)) == index);
+            REQUIRE(topology.origin(topology.twin(index)) == topology.target(index));
+        }
+
+        for (std::size_t vertex{0UL}; vertex < mesh.vertices().size(); ++vertex)
+        {
+            std::vector<std::size_t> ring;
+            topology.for_each_outgoing(static_cast<tml::half_edge_topology::index_type>(vertex),
+                                       [&](auto const half_edge) -> void { ring.push_back(topology.target(half_edge)); });
+            std::ranges::sort(ring);
+
+            auto const neighbors = mesh.neighbors(vertex);
+            REQUIRE(std::ranges::equal(ring, neighbors));
+        }
+    }
+
+    SECTION("Walk around a boundary vertex from one side of its fan to the other")
+    {
+        std::array const faces{tml::face{0, 1, 2}, tml::face{0, 2, 3}, tml::face{0, 3, 4}};
+        tml::half_edge_topology const topology{faces, 5};
+        std::vector<std::size_t> ring;
+        tml::half_edge_topology::index_type last{tml::half_edge_topology::invalid};
+        topology.for_each_outgoing(0U, [&](auto const half_edge) -> void {
+            ring.push_back(topology.target(half_edge));
+            last = half_edge;
+        });
+        REQUIRE(ring == std::vector<std::size_t>{1UL, 2UL, 3UL});
+        REQUIRE(topology.is_boundary(tml::half_edge_topology::prev(last)));
+        REQUIRE(topology.origin(tml::half_edge_topology::prev(last)) == 4U);
+        REQUIRE(topology.outgoing(4U) != tml::half_edge_topology::invalid);
+    }
+}
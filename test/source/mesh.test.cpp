@@ -1,9 +1,23 @@
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fmt/core.h>
 #include <fstream>
+#include <iterator>
 #include <numeric>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <tml/mesh.hpp>
+#include <tml/stats.hpp>
+#include <utility>
+#include <vector>
 
 TEST_CASE("Meshes tests", "[library]")
 {
@@ -58,6 +72,257 @@ TEST_CASE("Meshes tests", "[library]")
         REQUIRE(mesh.vertices().size() == 8UL);
     }
 
+    SECTION("Reject a truncated PLY file")
+    {
+        tml::mesh mesh;
+        REQUIRE(mesh.read("truncated_input.ply") == tml::error_code::invalid_data);
+        REQUIRE(mesh.vertices().empty());
+        REQUIRE(mesh.faces().empty());
+    }
+
+    SECTION("Reject a PLY file with lists of floats where integers are expected")
+    {
+        tml::mesh mesh;
+        REQUIRE(mesh.read("float_indices_input.ply") == tml::error_code::invalid_data);
+        REQUIRE(mesh.read("float_count_input.ply") == tml::error_code::invalid_data);
+        REQUIRE(mesh.faces().empty());
+    }
+
+    SECTION("Reject a PLY file declaring more elements than its body holds")
+    {
+        {
+            std::ofstream file{"forged_ascii_input.ply"};
+            file << "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\nelement "
+                    "face 99999999999999\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n3 0 1 2\n";
+        }
+
+        {
+            std::ofstream file{"forged_binary_input.ply", std::ios_base::binary};
+            file << "ply\nformat binary_little_endian 1.0\nelement vertex 1000000000\nproperty float x\nproperty float "
+                    "y\nproperty float z\nelement face 0\nproperty list uchar int vertex_indices\nend_header\n";
+        }
+
+        tml::mesh mesh;
+        REQUIRE(mesh.read("forged_ascii_input.ply") == tml::error_code::invalid_data);
+        REQUIRE(mesh.read("forged_binary_input.ply") == tml::error_code::invalid_data);
+        REQUIRE(mesh.vertices().empty());
+        REQUIRE(mesh.faces().empty());
+    }
+
+    SECTION("Load a large ASCII PLY file on several threads")
+    {
+        static constexpr std::size_t side{300UL};
+
+        {
+            std::ofstream file{"grid_input.ply"};
+            file << fmt::format("ply\nformat ascii 1.0\nelement vertex {}\nproperty float x\nproperty float y\nproperty float "
+                                "z\nelement face {}\nproperty list uchar int vertex_indices\nend_header\n",
+                                side * side, (side - 1) * (side - 1) * 2);
+
+            for (std::size_t row{0UL}; row < side; ++row)
+            {
+                for (std::size_t column{0UL}; column < side; ++column)
+                {
+                    file << fmt::format("{} {} {}\n", static_cast<float>(column) * 0.1F, static_cast<float>(row) * 0.1F,
+                                        static_cast<float>(row * column % 7UL) * 0.01F);
+                }
+            }
+
+            for (std::size_t row{0UL}; row + 1 < side; ++row)
+            {
+                for (std::size_t column{0UL}; column + 1 < side; ++column)
+                {
+                    std::size_t const corner = row * side + column;
+                    file << fmt::format("3 {} {} {}\n3 {} {} {}\n", corner, corner + 1, corner + side, corner + 1,
+                                        corner + side + 1, corner + side);
+                }
+            }
+        }
+
+        tml::mesh serial;
+        tml::mesh parallel;
+        REQUIRE(serial.read("grid_input.ply", {.threads = 1}) == tml::error_code::none);
+        REQUIRE(parallel.read("grid_input.ply", {.threads = 4}) == tml::error_code::none);
+        REQUIRE(parallel.vertices().size() == side * side);
+        REQUIRE(std::ranges::equal(serial.positions(), parallel.positions()));
+        REQUIRE(std::ranges::equal(serial.faces(), parallel.faces(), [](tml::face const& lhs, tml::face const& rhs) -> bool {
+            return lhs.indices() == rhs.indices();
+        }));
+
+        for (std::size_t index{0UL}; index < side * side; index += 97UL)
+        {
+            REQUIRE(std::ranges::equal(serial.neighbors(index), parallel.neighbors(index)));
+        }
+    }
+
+    SECTION("Write the same text files on several threads")
+    {
+        tml::mesh const mesh{"grid_input.ply"};
+        auto const content = [](char const* filepath) -> std::string {
+            std::ifstream const file{filepath};
+            std::ostringstream stream;
+            stream << file.rdbuf();
+            return stream.str();
+        };
+
+        std::filesystem::create_directories("serial");
+        std::filesystem::create_directories("parallel");
+
+        for (auto const* extension : {".ply", ".stl", ".dae"})
+        {
+            auto const serial = fmt::format("serial/output{}", extension);
+            auto const parallel = fmt::format("parallel/output{}", extension);
+            REQUIRE(mesh.write(serial, {.can_overwrite = true, .threads = 1}) == tml::error_code::none);
+            REQUIRE(mesh.write(parallel, {.can_overwrite = true, .threads = 4}) == tml::error_code::none);
+            REQUIRE(content(serial.c_str()) == content(parallel.c_str()));
+        }
+
+        auto const collada = content("parallel/output.dae");
+        REQUIRE(collada.find(" </") == std::string::npos);
+        REQUIRE(collada.ends_with("</COLLADA>"));
+    }
+
+    SECTION("Save and load a native binary cache file")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("output.tmlb", {.can_overwrite = true, .store_adjacency = true}) == tml::error_code::none);
+        REQUIRE(std::filesystem::file_size("output.tmlb") % 64UL == 0UL);
+
+        tml::mesh const loaded{"output.tmlb"};
+        REQUIRE(std::ranges::equal(mesh.positions(), loaded.positions()));
+        REQUIRE(std::ranges::equal(mesh.faces(), loaded.faces(), [](tml::face const& lhs, tml::face const& rhs) -> bool {
+            return lhs.indices() == rhs.indices();
+        }));
+
+        for (std::size_t index{0UL}; index < mesh.vertices().size(); ++index)
+        {
+            REQUIRE(std::ranges::equal(mesh.neighbors(index), loaded.neighbors(index)));
+        }
+
+        {
+            std::fstream file{"output.tmlb", std::ios_base::in | std::ios_base::out | std::ios_base::binary};
+            file.seekp(70);
+            file.put('\x7F');
+        }
+
+        tml::mesh corrupted;
+        REQUIRE(corrupted.read("output.tmlb") == tml::error_code::invalid_data);
+        REQUIRE(corrupted.vertices().empty());
+    }
+
+    SECTION("Load a Collada file with several geometries")
+    {
+        tml::mesh const mesh{"two_geometries_input.dae"};
+        REQUIRE(mesh.vertices().size() == 7UL);
+        REQUIRE(mesh.faces().size() == 3UL);
+        REQUIRE(mesh.faces()[0].indices() == std::array<tml::index_type, 3UL>{0U, 1U, 2U});
+        REQUIRE(mesh.faces()[2].indices() == std::array<tml::index_type, 3UL>{4U, 6U, 5U});
+        REQUIRE(mesh.positions()[3 * 3 + 2] == 1.0F);
+    }
+
+    SECTION("Reject a Collada file declaring more numbers than it holds")
+    {
+        tml::mesh mesh;
+        REQUIRE(mesh.read("forged_positions_input.dae") == tml::error_code::invalid_data);
+        REQUIRE(mesh.read("forged_triangles_input.dae") == tml::error_code::invalid_data);
+        REQUIRE(mesh.vertices().empty());
+        REQUIRE(mesh.faces().empty());
+    }
+
+    SECTION("Successfully save and load a binary PLY file")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("output_binary.ply", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        tml::mesh const loaded{"output_binary.ply"};
+        REQUIRE(std::ranges::equal(loaded.positions(), mesh.positions()));
+        REQUIRE(std::ranges::equal(loaded.faces(), mesh.faces(), {}, &tml::face::indices, &tml::face::indices));
+    }
+
+    SECTION("Append a PLY file to a mesh")
+    {
+        REQUIRE(tml::mesh{"input.ply"}.write("output_binary.ply", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        for (auto const* const filepath : {"input.ply", "output_binary.ply"})
+        {
+            tml::mesh mesh{"input.ply"};
+            REQUIRE(mesh.read(filepath) == tml::error_code::none);
+            REQUIRE(mesh.vertices().size() == 16UL);
+            REQUIRE(mesh.faces().size() == 24UL);
+            REQUIRE(mesh.faces()[12].indices()[0] >= 8U);
+            REQUIRE(mesh.is_closed());
+            REQUIRE(mesh.analyze_topology().non_manifold_edges.empty());
+        }
+    }
+
+    SECTION("Save and load the vertex normals in a PLY file")
+    {
+        tml::mesh const mesh{"input.ply"};
+
+        for (auto const encoding : {tml::encoding::ascii, tml::encoding::binary})
+        {
+            REQUIRE(mesh.write("output_normals.ply", {.can_overwrite = true, .encoding = encoding, .store_normals = true}) ==
+                    tml::error_code::none);
+
+            std::ifstream file{"output_normals.ply", std::ios_base::binary};
+            std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+            REQUIRE(content.find("property float nx\nproperty float ny\nproperty float nz\n") != std::string::npos);
+
+            for (auto const threads : {1UL, 4UL})
+            {
+                tml::mesh const loaded{"output_normals.ply", {.threads = threads}};
+                REQUIRE(std::ranges::equal(loaded.positions(), mesh.positions()));
+                REQUIRE(std::ranges::equal(loaded.faces(), mesh.faces(), {}, &tml::face::indices, &tml::face::indices));
+            }
+        }
+
+        // Binary normals follow each position, bit for bit.
+        auto const normals = mesh.vertex_normals();
+        std::ifstream file{"output_normals.ply", std::ios_base::binary};
+        std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        std::size_t const body = content.find("end_header\n") + 11UL;
+        std::array<float, 3> stored{};
+        std::memcpy(stored.data(), content.data() + body + 3 * sizeof(float), sizeof(stored));
+        REQUIRE(std::ranges::equal(stored, normals.subspan(0UL, 3UL)));
+    }
+
+    SECTION("Successfully load a big-endian binary PLY file")
+    {
+        {
+            std::ofstream file{"big_endian_input.ply", std::ios_base::binary};
+            file << "ply\nformat binary_big_endian 1.0\nelement vertex 3\nproperty double x\nproperty double y\n"
+                    "property double z\nproperty uchar quality\nelement face 1\nproperty list uchar int vertex_indices\n"
+                    "end_header\n";
+            auto const put = [&file](auto const value) -> void {
+                auto bytes = std::bit_cast<std::array<char, sizeof(value)>>(value);
+                if constexpr (std::endian::native == std::endian::little)
+                {
+                    std::ranges::reverse(bytes);
+                }
+                file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            };
+            for (auto const& [x, y] : {std::pair{0.0, 0.0}, std::pair{1.0, 0.0}, std::pair{0.0, 1.0}})
+            {
+                put(x);
+                put(y);
+                put(0.0);
+                put(std::uint8_t{255U});
+            }
+            put(std::uint8_t{3U});
+            put(std::int32_t{0});
+            put(std::int32_t{1});
+            put(std::int32_t{2});
+        }
+
+        tml::mesh const mesh{"big_endian_input.ply"};
+        REQUIRE(std::ranges::equal(mesh.positions(), std::array{0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F}));
+        REQUIRE(mesh.faces().size() == 1UL);
+        REQUIRE(mesh.faces()[0].indices() == std::array<tml::index_type, 3UL>{0U, 1U, 2U});
+        REQUIRE(mesh.area() == 0.5F);
+    }
+
     SECTION("Successfully load a valid STL file")
     {
         tml::mesh const mesh{"output.stl"};
@@ -65,6 +330,37 @@ TEST_CASE("Meshes tests", "[library]")
         REQUIRE(mesh.vertices().size() == 8UL);
     }
 
+    SECTION("Successfully save and load a binary STL file")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("output_binary.stl", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+        REQUIRE(std::filesystem::file_size("output_binary.stl") == 84UL + 12UL * 50UL);
+
+        tml::mesh const loaded{"output_binary.stl"};
+        REQUIRE(loaded.faces().size() == 12UL);
+        REQUIRE(loaded.vertices().size() == 8UL);
+        REQUIRE(loaded.area() == mesh.area());
+        REQUIRE(loaded.is_closed());
+    }
+
+    SECTION("Write the unit face normals in STL facets")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("output_binary.stl", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        std::ifstream file{"output_binary.stl", std::ios_base::binary};
+        std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+        for (std::size_t face{0UL}; face < mesh.faces().size(); ++face)
+        {
+            std::array<float, 3> normal{};
+            std::memcpy(normal.data(), content.data() + 84UL + face * 50UL, sizeof(normal));
+            REQUIRE(std::ranges::equal(normal, mesh.face_normals().subspan(face * 3, 3UL)));
+        }
+    }
+
     SECTION("Successfully load a valid Collada file")
     {
         tml::mesh const mesh{"output.dae"};
@@ -102,18 +398,123 @@ TEST_CASE("Meshes tests", "[library]")
                                 }) == 36UL);
     }
 
+    SECTION("Query the adjacent vertices of a single vertex")
+    {
+        tml::mesh const mesh{"input.ply"};
+        auto const neighbors = mesh.neighbors(0UL);
+        REQUIRE(std::ranges::equal(neighbors, std::array<std::size_t, 5UL>{1UL, 2UL, 3UL, 4UL, 5UL}));
+    }
+
+    SECTION("Query the adjacent vertices of a shared mesh from several threads")
+    {
+        tml::mesh const mesh{"grid_input.ply"};
+        std::vector<std::size_t> counts(4UL, 0UL);
+        std::vector<std::size_t> half_edges(4UL, 0UL);
+        std::vector<tml::aabb> boxes(4UL);
+        std::vector<std::thread> readers;
+
+        for (std::size_t reader{0UL}; reader < counts.size(); ++reader)
+        {
+            readers.emplace_back([&mesh, &count = counts[reader], &half_edge_count = half_edges[reader],
+                                  &box = boxes[reader]]() -> void {
+                half_edge_count = mesh.topology().size();
+                box = mesh.bounds();
+
+                for (std::size_t vertex{0UL}; vertex < mesh.vertices().size(); ++vertex)
+                {
+                    count += mesh.neighbors(vertex).size();
+                }
+            });
+        }
+
+        // Twice the edges of a 300 x 300 grid: 299 x 300 along each axis and 299 x 299 diagonals.
+        std::ranges::for_each(readers, &std::thread::join);
+        REQUIRE(counts == std::vector<std::size_t>(4UL, 2UL * (2UL * 299UL * 300UL + 299UL * 299UL)));
+        REQUIRE(half_edges == std::vector<std::size_t>(4UL, mesh.faces().size() * 3UL));
+        REQUIRE(std::ranges::all_of(boxes, [](tml::aabb const& box) -> bool {
+            return box.min == std::array{0.0F, 0.0F, 0.0F} && box.max[0] == 29.9F && box.max[1] == 29.9F;
+        }));
+    }
+
+    SECTION("Rebuild the adjacent vertices after a subdivision")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide();
+        REQUIRE(std::ranges::all_of(mesh.faces(), [&mesh](tml::face const& face) -> bool {
+            return std::ranges::none_of(face.indices(),
+                                        [&mesh](std::size_t const index) { return mesh.neighbors(index).empty(); });
+        }));
+    }
+
+    SECTION("Access the vertex positions as a contiguous span")
+    {
+        tml::mesh const mesh{"input.ply"};
+        auto const positions = mesh.positions();
+        auto const vertices = mesh.vertices();
+        REQUIRE(positions.size() == vertices.size() * 3UL);
+        REQUIRE(std::ranges::all_of(vertices, [&positions](tml::vertex_ref const& vertex) -> bool {
+            return positions[vertex.index() * 3UL] == vertex.x() && positions[vertex.index() * 3UL + 1UL] == vertex.y() &&
+                   positions[vertex.index() * 3UL + 2UL] == vertex.z();
+        }));
+    }
+
     SECTION("Check the surface area of a mesh")
     {
         tml::mesh const mesh{"input.ply"};
         REQUIRE(mesh.area() == 24.0F);
     }
 
+    SECTION("Compute the area of each face on several threads")
+    {
+        tml::mesh const cube{"input.ply"};
+        std::vector<float> areas(cube.faces().size());
+        cube.area_per_face(areas);
+        REQUIRE(std::ranges::all_of(areas, [](float const area) -> bool { return area == 2.0F; }));
+
+        tml::mesh const grid{"grid_input.ply"};
+        std::vector<float> serial(grid.faces().size());
+        std::vector<float> parallel(grid.faces().size());
+        grid.area_per_face(serial, 1);
+        grid.area_per_face(parallel, 4);
+        REQUIRE(serial == parallel);
+        REQUIRE(grid.area(1) == grid.area(4));
+
+        double const sum = std::accumulate(serial.begin(), serial.end(), 0.0);
+        REQUIRE(std::abs(sum - static_cast<double>(grid.area())) <= sum * 1e-6);
+    }
+
     SECTION("Check if a mesh is closed")
     {
         tml::mesh const mesh{"input.ply"};
         REQUIRE(mesh.is_closed());
     }
 
+    SECTION("Report the boundary and non-manifold edges of a mesh")
+    {
+        auto const cube = tml::mesh{"input.ply"}.analyze_topology();
+        REQUIRE(cube.is_closed());
+        REQUIRE(cube.boundary_loops == 0UL);
+
+        tml::mesh const grid{"grid_input.ply"};
+        auto const serial = grid.analyze_topology(1);
+        auto const parallel = grid.analyze_topology(4);
+        REQUIRE_FALSE(grid.is_closed());
+        REQUIRE(serial.boundary_edges.size() == 4UL * 299UL);
+        REQUIRE(serial.boundary_edges == parallel.boundary_edges);
+        REQUIRE(serial.non_manifold_edges.empty());
+        REQUIRE(serial.boundary_loops == 1UL);
+
+        auto const fan = tml::mesh{"non_manifold_input.ply"}.analyze_topology();
+        REQUIRE(fan.non_manifold_edges == std::vector<tml::edge>{{0UL, 1UL}});
+        REQUIRE(fan.boundary_edges.size() == 6UL);
+        REQUIRE(fan.boundary_loops == 2UL);
+
+        auto const bowtie = tml::mesh{"bowtie_input.ply"}.analyze_topology();
+        REQUIRE(bowtie.boundary_edges.size() == 6UL);
+        REQUIRE(bowtie.non_manifold_edges.empty());
+        REQUIRE(bowtie.boundary_loops == 2UL);
+    }
+
     SECTION("Successfully center a mesh")
     {
         tml::mesh mesh{"uncentered_input.ply"};
@@ -145,6 +546,43 @@ TEST_CASE("Meshes tests", "[library]")
         REQUIRE(vertices[7].z() == 1.0F);
     }
 
+    SECTION("Compute the bounding box of a mesh")
+    {
+        auto const brute_force = [](tml::mesh const& mesh) -> tml::aabb {
+            tml::aabb box;
+
+            for (std::size_t idx{0UL}; idx < mesh.positions().size(); idx += 3UL)
+            {
+                box.extend(std::array{mesh.positions()[idx], mesh.positions()[idx + 1], mesh.positions()[idx + 2]});
+            }
+
+            return box;
+        };
+
+        tml::mesh mesh{"skewed_input.ply"};
+        REQUIRE(mesh.bounds().min == std::array{-1.0F, -2.0F, -4.0F});
+        REQUIRE(mesh.bounds().max == std::array{3.0F, 5.0F, 3.0F});
+
+        mesh.center();
+        REQUIRE(mesh.bounds().min == std::array{-2.0F, -3.5F, -3.5F});
+        REQUIRE(mesh.bounds().max == std::array{2.0F, 3.5F, 3.5F});
+        REQUIRE(mesh.positions()[0] == -2.0F);
+
+        mesh.scale(-2.0F);
+        REQUIRE(mesh.bounds().min == brute_force(mesh).min);
+        REQUIRE(mesh.bounds().max == brute_force(mesh).max);
+
+        tml::mesh large{"input.ply"};
+        large.subdivide(6UL).transform(tml::matrix4::rotation({1.0F, 1.0F, 0.0F}, 0.3F));
+        REQUIRE(large.bounds(4UL).min == brute_force(large).min);
+        REQUIRE(large.bounds().max == brute_force(large).max);
+
+        large.noise(0.5F);
+        REQUIRE(large.bounds().min == brute_force(large).min);
+        REQUIRE(large.bounds().max == brute_force(large).max);
+        REQUIRE(tml::mesh{}.bounds().empty());
+    }
+
     SECTION("Successfully scale a mesh")
     {
         tml::mesh mesh{"input.ply"};
@@ -176,23 +614,221 @@ TEST_CASE("Meshes tests", "[library]")
         REQUIRE(vertices[7].z() == 2.0F);
     }
 
+    SECTION("Add reproducible noise on several threads")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide(6UL);
+        tml::mesh serial = mesh;
+        tml::mesh parallel = mesh;
+        tml::mesh reseeded = mesh;
+        serial.noise(0.1F, 42U, 1UL);
+        parallel.noise(0.1F, 42U, 4UL);
+        reseeded.noise(0.1F, 43U);
+        REQUIRE(std::ranges::equal(serial.positions(), parallel.positions()));
+        REQUIRE_FALSE(std::ranges::equal(serial.positions(), reseeded.positions()));
+
+        double sum{0.0};
+
+        for (std::size_t idx{0UL}; idx < mesh.positions().size(); ++idx)
+        {
+            float const offset = serial.positions()[idx] - mesh.positions()[idx];
+            REQUIRE(std::abs(offset) <= 0.1F + 1e-6F);
+            sum += static_cast<double>(offset);
+        }
+
+        REQUIRE(std::abs(sum / static_cast<double>(mesh.positions().size())) < 1e-3);
+    }
+
+    SECTION("Add reproducible noise along the normals")
+    {
+        tml::mesh mesh{"input.ply"};
+        tml::mesh noised = mesh;
+        noised.noise_along_normals(0.2F, 7U, 4UL);
+
+        // Every face around a corner of a centered cube faces away from its center along one axis, so the normal of the
+        // corner has the signs of its position.
+        for (std::size_t idx{0UL}; idx < mesh.positions().size(); idx += 3UL)
+        {
+            std::array<float, 3> offset{};
+
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                offset[axis] = noised.positions()[idx + axis] - mesh.positions()[idx + axis];
+                REQUIRE(offset[axis] * mesh.positions()[idx + axis] * offset[0] * mesh.positions()[idx] > 0.0F);
+            }
+
+            REQUIRE(std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]) <= 0.2F + 1e-6F);
+        }
+
+        tml::mesh again{"input.ply"};
+        REQUIRE(std::ranges::equal(again.noise_along_normals(0.2F, 7U).positions(), noised.positions()));
+    }
+
+    SECTION("Compute the normals of the faces and of the vertices")
+    {
+        tml::mesh const mesh{"input.ply"};
+        auto const face_normals = mesh.face_normals();
+        REQUIRE(face_normals.size() == mesh.faces().size() * 3);
+
+        // The faces of an axis-aligned cube point outwards along one axis.
+        for (std::size_t face{0UL}; face < mesh.faces().size(); ++face)
+        {
+            auto const& indices = mesh.faces()[face].indices();
+            std::size_t const axis = std::abs(face_normals[face * 3]) == 1.0F       ? 0UL
+                                     : std::abs(face_normals[face * 3 + 1]) == 1.0F ? 1UL
+                                                                                    : 2UL;
+            REQUIRE(std::abs(face_normals[face * 3 + axis]) == 1.0F);
+            REQUIRE(face_normals[face * 3 + axis] == mesh.positions()[std::size_t{indices[0]} * 3 + axis]);
+        }
+
+        // Every side of the cube has a right angle at each of its corners, so angle-weighted normals are diagonals.
+        auto const angle_normals = mesh.vertex_normals(tml::normal_weighting::angle);
+
+        for (std::size_t idx{0UL}; idx < angle_normals.size(); ++idx)
+        {
+            REQUIRE(std::abs(angle_normals[idx] - mesh.positions()[idx] / std::sqrt(3.0F)) < 1e-6F);
+        }
+
+        // Area weighting depends on how the sides are split, but keeps the normals unit and on the side of the corner.
+        auto const area_normals = mesh.vertex_normals(tml::normal_weighting::area);
+
+        for (std::size_t idx{0UL}; idx < area_normals.size(); idx += 3UL)
+        {
+            auto const normal = area_normals.subspan(idx, 3UL);
+            REQUIRE(std::abs(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] - 1.0F) < 1e-6F);
+            REQUIRE(normal[0] * mesh.positions()[idx] > 0.0F);
+            REQUIRE(normal[1] * mesh.positions()[idx + 1] > 0.0F);
+            REQUIRE(normal[2] * mesh.positions()[idx + 2] > 0.0F);
+        }
+    }
+
+    SECTION("Compute the same normals on several threads")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide(5UL).noise(0.05F, 3U);
+        tml::mesh const copy = mesh;
+
+        for (auto const weighting : {tml::normal_weighting::area, tml::normal_weighting::angle})
+        {
+            auto const computed = mesh.vertex_normals(weighting, 1UL);
+            std::vector<float> const expected(computed.begin(), computed.end());
+            tml::mesh const other = copy;
+            REQUIRE(std::ranges::equal(other.vertex_normals(weighting, 4UL), expected));
+        }
+
+        // Every kernel evaluates the same expression as this one.
+        auto const face_normals = copy.face_normals(4UL);
+
+        for (std::size_t face{0UL}; face < mesh.faces().size(); ++face)
+        {
+            auto const [i1, i2, i3] = mesh.faces()[face].indices();
+            auto const p = mesh.positions();
+            float const e1x = p[i2 * 3] - p[i1 * 3];
+            float const e1y = p[i2 * 3 + 1] - p[i1 * 3 + 1];
+            float const e1z = p[i2 * 3 + 2] - p[i1 * 3 + 2];
+            float const e2x = p[i3 * 3] - p[i1 * 3];
+            float const e2y = p[i3 * 3 + 1] - p[i1 * 3 + 1];
+            float const e2z = p[i3 * 3 + 2] - p[i1 * 3 + 2];
+            std::array const cross{e1y * e2z - e1z * e2y, e1z * e2x - e1x * e2z, e1x * e2y - e1y * e2x};
+            float const length = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+            for (std::size_t axis{0UL}; axis < 3UL; ++axis)
+            {
+                REQUIRE(std::abs(face_normals[face * 3 + axis] - cross[axis] / length) < 1e-6F);
+            }
+        }
+    }
+
+    SECTION("Keep the normals until the positions change")
+    {
+        tml::mesh mesh{"input.ply"};
+        auto const computed = mesh.vertex_normals();
+        std::vector<float> const normals(computed.begin(), computed.end());
+
+        mesh.invert();
+        REQUIRE(std::ranges::equal(mesh.vertex_normals(), normals, [](float const lhs, float const rhs) -> bool {
+            return lhs == -rhs;
+        }));
+
+        mesh.invert().scale(2.0F);
+        REQUIRE(std::ranges::equal(mesh.vertex_normals(), normals));
+
+        mesh.noise(0.5F, 11U);
+        REQUIRE(!std::ranges::equal(mesh.vertex_normals(), normals));
+        REQUIRE(!std::ranges::equal(mesh.face_normals(), tml::mesh{"input.ply"}.face_normals()));
+    }
+
+    SECTION("Compute the same normals whether they were cached before an inversion or not")
+    {
+        tml::mesh cached{"grid_input.ply"};
+        cached.noise(0.05F, 3U);
+        tml::mesh fresh = cached;
+        static_cast<void>(cached.face_normals());
+        static_cast<void>(cached.vertex_normals());
+        cached.invert();
+        fresh.invert();
+        REQUIRE(std::ranges::equal(cached.face_normals(), fresh.face_normals()));
+        REQUIRE(std::ranges::equal(cached.vertex_normals(), fresh.vertex_normals()));
+
+        // Asking for another weighting leaves the normals already handed out as they are.
+        auto const area_normals = cached.vertex_normals(tml::normal_weighting::area);
+        std::vector<float> const copy(area_normals.begin(), area_normals.end());
+        static_cast<void>(cached.vertex_normals(tml::normal_weighting::angle));
+        REQUIRE(std::ranges::equal(area_normals, copy));
+    }
+
     SECTION("Successfully invert a mesh")
     {
         tml::mesh mesh{"input.ply"};
         mesh.invert();
         auto const& faces = mesh.faces();
-        REQUIRE(faces[0].indices() == std::array<std::size_t, 3UL>{0UL, 1UL, 3UL});
-        REQUIRE(faces[1].indices() == std::array<std::size_t, 3UL>{0UL, 3UL, 2UL});
-        REQUIRE(faces[2].indices() == std::array<std::size_t, 3UL>{1UL, 7UL, 3UL});
-        REQUIRE(faces[3].indices() == std::array<std::size_t, 3UL>{7UL, 1UL, 5UL});
-        REQUIRE(faces[4].indices() == std::array<std::size_t, 3UL>{7UL, 5UL, 6UL});
-        REQUIRE(faces[5].indices() == std::array<std::size_t, 3UL>{4UL, 6UL, 5UL});
-        REQUIRE(faces[6].indices() == std::array<std::size_t, 3UL>{2UL, 6UL, 4UL});
-        REQUIRE(faces[7].indices() == std::array<std::size_t, 3UL>{0UL, 2UL, 4UL});
-        REQUIRE(faces[8].indices() == std::array<std::size_t, 3UL>{3UL, 7UL, 6UL});
-        REQUIRE(faces[9].indices() == std::array<std::size_t, 3UL>{6UL, 2UL, 3UL});
-        REQUIRE(faces[10].indices() == std::array<std::size_t, 3UL>{0UL, 5UL, 1UL});
-        REQUIRE(faces[11].indices() == std::array<std::size_t, 3UL>{5UL, 0UL, 4UL});
+        REQUIRE(faces[0].indices() == std::array<tml::index_type, 3UL>{0U, 1U, 3U});
+        REQUIRE(faces[1].indices() == std::array<tml::index_type, 3UL>{0U, 3U, 2U});
+        REQUIRE(faces[2].indices() == std::array<tml::index_type, 3UL>{1U, 7U, 3U});
+        REQUIRE(faces[3].indices() == std::array<tml::index_type, 3UL>{7U, 1U, 5U});
+        REQUIRE(faces[4].indices() == std::array<tml::index_type, 3UL>{7U, 5U, 6U});
+        REQUIRE(faces[5].indices() == std::array<tml::index_type, 3UL>{4U, 6U, 5U});
+        REQUIRE(faces[6].indices() == std::array<tml::index_type, 3UL>{2U, 6U, 4U});
+        REQUIRE(faces[7].indices() == std::array<tml::index_type, 3UL>{0U, 2U, 4U});
+        REQUIRE(faces[8].indices() == std::array<tml::index_type, 3UL>{3U, 7U, 6U});
+        REQUIRE(faces[9].indices() == std::array<tml::index_type, 3UL>{6U, 2U, 3U});
+        REQUIRE(faces[10].indices() == std::array<tml::index_type, 3UL>{0U, 5U, 1U});
+        REQUIRE(faces[11].indices() == std::array<tml::index_type, 3UL>{5U, 0U, 4U});
+    }
+
+    SECTION("Apply a transformation matrix to a mesh")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide();
+        auto const rotation = tml::matrix4::rotation({1.0F, 2.0F, 3.0F}, 0.7F);
+        auto const matrix = tml::matrix4::translation({0.5F, -1.0F, 2.0F}) * rotation * tml::matrix4::scaling({2.0F, 1.0F, 3.0F});
+        REQUIRE(mesh.positions().size() % 12UL != 0UL);
+
+        for (auto projective : {matrix, tml::matrix4{.rows = {{{1.0F, 0.0F, 0.0F, 0.0F},
+                                                                 {0.0F, 1.0F, 0.0F, 0.0F},
+                                                                 {0.0F, 0.0F, 1.0F, 0.0F},
+                                                                 {0.1F, 0.2F, 0.0F, 1.0F}}}}})
+        {
+            tml::mesh transformed = mesh;
+            tml::mesh threaded = mesh;
+            transformed.transform(projective);
+            threaded.transform(projective, 4UL);
+            REQUIRE(std::ranges::equal(transformed.positions(), threaded.positions()));
+
+            for (std::size_t idx{0UL}; idx < mesh.positions().size() / 3; ++idx)
+            {
+                auto const expected =
+                    projective.apply({mesh.positions()[idx * 3], mesh.positions()[idx * 3 + 1], mesh.positions()[idx * 3 + 2]});
+                REQUIRE(std::ranges::equal(transformed.positions().subspan(idx * 3, 3UL), expected));
+            }
+        }
+
+        tml::mesh chained{"uncentered_input.ply"};
+        tml::mesh fused{"uncentered_input.ply"};
+        chained.center().scale(2.0F);
+        fused.transform(tml::matrix4::scaling(2.0F) * fused.centering());
+        REQUIRE(std::ranges::equal(chained.positions(), fused.positions()));
+        REQUIRE(tml::matrix4::rotation({0.0F, 0.0F, 1.0F}, 0.0F) == tml::matrix4::identity());
     }
 
     SECTION("Successfully subdivide a mesh")
@@ -201,7 +837,167 @@ TEST_CASE("Meshes tests", "[library]")
         auto const& vertices = mesh.vertices();
         auto const& faces = mesh.faces();
         mesh.subdivide();
-        REQUIRE(vertices.size() == 20UL);
+        REQUIRE(vertices.size() == 26UL);
         REQUIRE(faces.size() == 48UL);
+        REQUIRE(mesh.is_closed());
+    }
+
+    SECTION("Weld the duplicated vertices of a seam")
+    {
+        tml::mesh mesh{"seam_input.ply"};
+        tml::mesh const cube{"input.ply"};
+        REQUIRE_FALSE(mesh.is_closed());
+        mesh.weld(0.001F);
+        REQUIRE(mesh.vertices().size() == 8UL);
+        REQUIRE(mesh.faces().size() == 12UL);
+        REQUIRE(mesh.is_closed());
+        REQUIRE(std::ranges::equal(mesh.positions(), cube.positions()));
+        REQUIRE(mesh.area() == 24.0F);
+    }
+
+    SECTION("Weld only equal vertices without tolerance")
+    {
+        tml::mesh mesh{"seam_input.ply"};
+        mesh.weld();
+        REQUIRE(mesh.vertices().size() == 12UL);
+        REQUIRE(mesh.faces().size() == 13UL);
+    }
+
+    SECTION("Weld chains of close vertices transitively")
+    {
+        {
+            std::ofstream file{"chain_input.ply"};
+            file << "ply\nformat ascii 1.0\nelement vertex 4\nproperty float x\nproperty float y\nproperty float z\nelement "
+                    "face 2\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n2 0 0\n1 0 0\n0 5 0\n3 0 1 3\n3 2 3 "
+                    "1\n";
+        }
+
+        for (auto const threads : {1UL, 4UL})
+        {
+            tml::mesh mesh{"chain_input.ply"};
+            mesh.weld(1.5F, threads);
+            REQUIRE(std::ranges::equal(mesh.positions(), std::array{0.0F, 0.0F, 0.0F, 0.0F, 5.0F, 0.0F}));
+            REQUIRE(mesh.faces().empty());
+        }
+    }
+
+    SECTION("Weld a triangle soup on several threads")
+    {
+        static constexpr std::size_t side{100UL};
+        static constexpr std::size_t face_count{(side - 1UL) * (side - 1UL) * 2UL};
+
+        {
+            std::ofstream file{"soup_input.ply"};
+            file << fmt::format("ply\nformat ascii 1.0\nelement vertex {}\nproperty float x\nproperty float y\nproperty float "
+                                "z\nelement face {}\nproperty list uchar int vertex_indices\nend_header\n",
+                                face_count * 3UL, face_count);
+            auto const corner = [&file](std::size_t const column, std::size_t const row) -> void {
+                file << fmt::format("{} {} {}\n", static_cast<float>(column) * 0.1F, static_cast<float>(row) * 0.1F,
+                                    static_cast<float>(row * column % 7UL) * 0.01F);
+            };
+
+            for (std::size_t row{0UL}; row + 1 < side; ++row)
+            {
+                for (std::size_t column{0UL}; column + 1 < side; ++column)
+                {
+                    corner(column, row);
+                    corner(column + 1, row);
+                    corner(column, row + 1);
+                    corner(column + 1, row);
+                    corner(column + 1, row + 1);
+                    corner(column, row + 1);
+                }
+            }
+
+            for (std::size_t face{0UL}; face < face_count; ++face)
+            {
+                file << fmt::format("3 {} {} {}\n", face * 3UL, face * 3UL + 1UL, face * 3UL + 2UL);
+            }
+        }
+
+        tml::mesh serial{"soup_input.ply"};
+        tml::mesh parallel{"soup_input.ply"};
+        serial.weld(0.0001F);
+        parallel.weld(0.0001F, 4UL);
+        REQUIRE(serial.vertices().size() == side * side);
+        REQUIRE(serial.faces().size() == face_count);
+        REQUIRE(serial.analyze_topology().boundary_edges.size() == 4UL * (side - 1UL));
+        REQUIRE(std::ranges::equal(serial.positions(), parallel.positions()));
+        REQUIRE(std::ranges::equal(serial.faces(), parallel.faces(), {}, &tml::face::indices, &tml::face::indices));
+    }
+
+    SECTION("Subdivide a mesh several levels at once")
+    {
+        tml::mesh once{"input.ply"};
+        tml::mesh twice{"input.ply"};
+        once.subdivide().subdivide();
+        twice.subdivide(2UL);
+        REQUIRE(twice.vertices().size() == 98UL);
+        REQUIRE(twice.faces().size() == 192UL);
+        REQUIRE(twice.is_closed());
+        REQUIRE(std::ranges::equal(once.positions(), twice.positions()));
+        REQUIRE(std::ranges::equal(once.faces(), twice.faces(), {}, &tml::face::indices, &tml::face::indices));
+    }
+
+    SECTION("Subdivide a mesh on several threads")
+    {
+        tml::mesh serial{"grid_input.ply"};
+        tml::mesh parallel{"grid_input.ply"};
+        serial.subdivide(2UL);
+        parallel.subdivide(2UL, 4UL);
+        REQUIRE(std::ranges::equal(serial.positions(), parallel.positions()));
+        REQUIRE(std::ranges::equal(serial.faces(), parallel.faces(), {}, &tml::face::indices, &tml::face::indices));
+    }
+
+    SECTION("Keep the boundary of an open mesh on its polygon")
+    {
+        static constexpr std::size_t side{300UL};
+        tml::mesh mesh{"grid_input.ply"};
+        mesh.subdivide();
+        auto const positions = mesh.positions();
+        REQUIRE(mesh.analyze_topology().boundary_edges.size() == 8UL * (side - 1UL));
+        REQUIRE(std::ranges::count_if(std::views::iota(0UL, positions.size() / 3UL), [&positions](std::size_t const index) {
+                    return positions[index * 3UL + 1UL] == 0.0F;
+                }) == static_cast<std::ptrdiff_t>(2UL * side - 3UL));
+    }
+
+    SECTION("Decimate a closed mesh down to a face count")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide(3UL);
+        REQUIRE(mesh.faces().size() == 768UL);
+
+        tml::mesh unchanged = mesh;
+        unchanged.decimate(768UL);
+        REQUIRE(std::ranges::equal(unchanged.positions(), mesh.positions()));
+
+        mesh.decimate(100UL);
+        auto const report = mesh.analyze_topology();
+        REQUIRE(mesh.faces().size() <= 100UL);
+        REQUIRE(mesh.faces().size() >= 98UL);
+        REQUIRE(report.is_closed());
+        REQUIRE(mesh.vertices().size() == mesh.faces().size() / 2UL + 2UL);
+    }
+
+    SECTION("Decimate a mesh on several threads")
+    {
+        tml::mesh serial{"grid_input.ply"};
+        tml::mesh parallel{"grid_input.ply"};
+        serial.decimate(20'000UL);
+        tml::reset_stats();
+        parallel.decimate(20'000UL, 4UL);
+
+        // Every vertex left by the clusters seeds the decimation of the whole mesh.
+        auto const stats = tml::stats_snapshot();
+        REQUIRE(stats[tml::stat::decimation_seeded_vertices] == stats[tml::stat::decimation_live_vertices]);
+        REQUIRE((stats[tml::stat::decimation_live_vertices] != 0U) == tml::stats_enabled);
+
+        auto const report = serial.analyze_topology();
+        REQUIRE(serial.faces().size() <= 20'000UL);
+        REQUIRE(report.non_manifold_edges.empty());
+        REQUIRE(report.boundary_loops == 1UL);
+        REQUIRE(serial.faces().size() >= 19'000UL);
+        REQUIRE(std::ranges::equal(serial.positions(), parallel.positions()));
+        REQUIRE(std::ranges::equal(serial.faces(), parallel.faces(), {}, &tml::face::indices, &tml::face::indices));
     }
 }
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <tml/mesh.hpp>
+#include <tml/mesh_batch.hpp>
+#include <tml/mesh_reader.hpp>
+#include <vector>
+
+namespace
+{
+    struct streamed_mesh
+    {
+        std::vector<float> positions;
+        std::vector<tml::face> faces;
+        std::size_t batches{0UL};
+    };
+
+    // Concatenates every batch of a file, checking that they follow each other.
+    auto stream(std::string const& filepath, std::size_t const batch_size) -> streamed_mesh
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open(filepath, batch_size) == tml::error_code::none);
+
+        streamed_mesh result;
+        tml::mesh_batch batch;
+
+        while (true)
+        {
+            REQUIRE(reader.read(batch) == tml::error_code::none);
+
+            if (batch.empty())
+            {
+                break;
+            }
+
+            REQUIRE(batch.first_vertex == result.positions.size() / 3);
+            REQUIRE(batch.vertex_count() <= batch_size * 3);
+            REQUIRE(batch.faces.size() <= batch_size);
+            REQUIRE((batch.faces.empty() || batch.first_face == result.faces.size()));
+            result.positions.insert(result.positions.end(), batch.positions.begin(), batch.positions.end());
+            result.faces.insert(result.faces.end(), batch.faces.begin(), batch.faces.end());
+            ++result.batches;
+        }
+
+        REQUIRE(result.positions.size() == reader.vertex_count() * 3);
+        REQUIRE(result.faces.size() == reader.face_count());
+
+        return result;
+    }
+
+    auto same_faces(std::vector<tml::face> const& lhs, std::vector<tml::face> const& rhs) -> bool
+    {
+        return std::ranges::equal(lhs, rhs, [](tml::face const& left, tml::face const& right) -> bool {
+            return left.indices() == right.indices();
+        });
+    }
+} // namespace
+
+TEST_CASE("Mesh reader tests", "[library]")
+{
+    SECTION("Stream an ASCII PLY file by batches")
+    {
+        tml::mesh const mesh{"input.ply"};
+        auto const streamed = stream("input.ply", 5UL);
+        REQUIRE(streamed.batches == 5UL);
+        REQUIRE(std::ranges::equal(streamed.positions, mesh.positions()));
+        REQUIRE(same_faces(streamed.faces, mesh.faces()));
+    }
+
+    SECTION("Stream large PLY files past the reading buffer")
+    {
+        tml::mesh mesh{"input.ply"};
+        mesh.subdivide(7UL);
+        REQUIRE(mesh.write("stream_ascii.ply", {.can_overwrite = true}) == tml::error_code::none);
+        REQUIRE(mesh.write("stream_binary.ply", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        for (auto const* const filepath : {"stream_ascii.ply", "stream_binary.ply"})
+        {
+            tml::mesh const loaded{filepath};
+            auto const streamed = stream(filepath, tml::mesh_reader::default_batch_size);
+            REQUIRE(std::ranges::equal(streamed.positions, loaded.positions()));
+            REQUIRE(same_faces(streamed.faces, loaded.faces()));
+        }
+    }
+
+    SECTION("Stream PLY files whose elements carry other properties")
+    {
+        tml::mesh const mesh{"attributes_input.ply"};
+        REQUIRE(mesh.write("stream_attributes.ply", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        for (auto const* const filepath : {"attributes_input.ply", "stream_attributes.ply"})
+        {
+            auto const streamed = stream(filepath, 3UL);
+            REQUIRE(std::ranges::equal(streamed.positions, mesh.positions()));
+            REQUIRE(same_faces(streamed.faces, mesh.faces()));
+        }
+    }
+
+    SECTION("Stream the unwelded triangles of STL files")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("stream_ascii.stl", {.can_overwrite = true}) == tml::error_code::none);
+        REQUIRE(mesh.write("stream_binary.stl", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        for (auto const* const filepath : {"stream_ascii.stl", "stream_binary.stl"})
+        {
+            auto const streamed = stream(filepath, 5UL);
+            REQUIRE(streamed.batches == 3UL);
+            REQUIRE(streamed.faces.size() == mesh.faces().size());
+            REQUIRE(streamed.positions.size() == mesh.faces().size() * 9);
+
+            for (std::size_t face{0UL}; face < streamed.faces.size(); ++face)
+            {
+                for (std::size_t corner{0UL}; corner < 3UL; ++corner)
+                {
+                    std::size_t const streamed_index = streamed.faces[face].indices()[corner];
+                    std::size_t const index = mesh.faces()[face].indices()[corner];
+                    REQUIRE(streamed_index == face * 3 + corner);
+                    REQUIRE(std::ranges::equal(std::span{streamed.positions}.subspan(streamed_index * 3, 3UL),
+                                               mesh.positions().subspan(index * 3, 3UL)));
+                }
+            }
+        }
+    }
+
+    SECTION("Reject a truncated PLY file")
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("truncated_input.ply", 2UL) == tml::error_code::none);
+
+        tml::mesh_batch batch;
+        REQUIRE(reader.read(batch) == tml::error_code::none);
+        REQUIRE(batch.vertex_count() == 2UL);
+        REQUIRE(reader.read(batch) == tml::error_code::invalid_data);
+        REQUIRE(batch.empty());
+        REQUIRE(reader.read(batch) == tml::error_code::invalid_data);
+    }
+
+    SECTION("Reject a PLY file with corners given as floats")
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("float_indices_input.ply") == tml::error_code::invalid_data);
+    }
+
+    SECTION("Reject an ASCII STL file with a line too long to be buffered")
+    {
+        {
+            std::ofstream file{"oversized_line_input.stl", std::ios_base::binary};
+            file << "solid oversized\nfacet normal 0 0 1" << std::string(1UL << 25U, ' ');
+        }
+
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("oversized_line_input.stl") == tml::error_code::invalid_data);
+        REQUIRE(reader.vertex_count() == 0UL);
+    }
+
+    SECTION("Reject missing files and unsupported formats")
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("missing.ply") == tml::error_code::file_not_found);
+        REQUIRE(reader.open("output.dae") == tml::error_code::unsupported_format);
+        REQUIRE(reader.vertex_count() == 0UL);
+    }
+}
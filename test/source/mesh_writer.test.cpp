@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <tml/mesh.hpp>
+#include <tml/mesh_batch.hpp>
+#include <tml/mesh_reader.hpp>
+#include <tml/mesh_writer.hpp>
+#include <vector>
+
+TEST_CASE("Mesh writer tests", "[library]")
+{
+    SECTION("Scale and invert a mesh from one file to another by batches")
+    {
+        for (auto const encoding : {tml::encoding::ascii, tml::encoding::binary})
+        {
+            tml::mesh_reader reader;
+            tml::mesh_writer writer;
+            REQUIRE(reader.open("input.ply", 3UL) == tml::error_code::none);
+            REQUIRE(writer.open("streamed_output.ply", reader.vertex_count(), reader.face_count(),
+                                {.can_overwrite = true, .encoding = encoding}) == tml::error_code::none);
+
+            tml::mesh_batch batch;
+
+            while (reader.read(batch) == tml::error_code::none && !batch.empty())
+            {
+                REQUIRE(writer.write(batch.scale(2.0F).invert()) == tml::error_code::none);
+            }
+
+            REQUIRE(writer.close() == tml::error_code::none);
+
+            tml::mesh expected{"input.ply"};
+            expected.scale(2.0F).invert();
+            tml::mesh const streamed{"streamed_output.ply"};
+            REQUIRE(std::ranges::equal(streamed.positions(), expected.positions()));
+            REQUIRE(std::ranges::equal(streamed.faces(), expected.faces(),
+                                       [](tml::face const& lhs, tml::face const& rhs) -> bool {
+                                           return lhs.indices() == rhs.indices();
+                                       }));
+        }
+    }
+
+    SECTION("Noise a stream as the loaded mesh")
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("input.ply", 3UL) == tml::error_code::none);
+
+        std::vector<float> positions;
+        tml::mesh_batch batch;
+
+        while (reader.read(batch) == tml::error_code::none && !batch.empty())
+        {
+            batch.noise(0.1F, 1234U);
+            positions.insert(positions.end(), batch.positions.begin(), batch.positions.end());
+        }
+
+        tml::mesh mesh{"input.ply"};
+        mesh.noise(0.1F, 1234U);
+        REQUIRE(std::ranges::equal(positions, mesh.positions()));
+    }
+
+    SECTION("Convert an STL file to PLY, spilling the faces received before the last vertex")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("spill_input.stl", {.can_overwrite = true}) == tml::error_code::none);
+
+        tml::mesh_reader reader;
+        tml::mesh_writer writer;
+        REQUIRE(reader.open("spill_input.stl", 5UL) == tml::error_code::none);
+        REQUIRE(writer.open("spill_output.ply", reader.vertex_count(), reader.face_count(), {.can_overwrite = true}) ==
+                tml::error_code::none);
+
+        tml::mesh_batch batch;
+        tml::area_accumulator accumulator;
+
+        while (reader.read(batch) == tml::error_code::none && !batch.empty())
+        {
+            accumulator.add(batch);
+            REQUIRE(writer.write(batch) == tml::error_code::none);
+            REQUIRE(std::filesystem::exists("spill_output.ply.faces.tmp"));
+        }
+
+        REQUIRE(writer.close() == tml::error_code::none);
+        REQUIRE_FALSE(std::filesystem::exists("spill_output.ply.faces.tmp"));
+        REQUIRE(std::abs(accumulator.area() - mesh.area()) <= 1e-5F);
+
+        tml::mesh converted{"spill_output.ply"};
+        REQUIRE(converted.vertices().size() == 36UL);
+        REQUIRE(std::abs(converted.area() - mesh.area()) <= 1e-5F);
+        REQUIRE(converted.weld().vertices().size() == 8UL);
+        REQUIRE(converted.is_closed());
+    }
+
+    SECTION("Accumulate the area of the faces of a PLY stream")
+    {
+        tml::mesh const mesh{"input.ply"};
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("input.ply", 4UL) == tml::error_code::none);
+
+        tml::mesh_batch batch;
+        tml::area_accumulator accumulator;
+
+        while (reader.read(batch) == tml::error_code::none && !batch.empty())
+        {
+            accumulator.add(batch);
+        }
+
+        REQUIRE(std::abs(accumulator.area() - mesh.area()) <= 1e-5F);
+    }
+
+    SECTION("Accumulate the area of the faces of a binary PLY stream by reading their corners again")
+    {
+        tml::mesh const mesh{"grid_input.ply"};
+        REQUIRE(mesh.write("area_binary.ply", {.can_overwrite = true, .encoding = tml::encoding::binary}) ==
+                tml::error_code::none);
+
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("area_binary.ply", 1000UL) == tml::error_code::none);
+        REQUIRE(reader.can_reread_positions());
+
+        std::vector<float> positions(6UL);
+        REQUIRE(reader.read_positions(reader.vertex_count() - 2UL, 2UL, positions.data()) == tml::error_code::none);
+        REQUIRE(std::ranges::equal(positions, mesh.positions().last(6UL)));
+        REQUIRE(reader.read_positions(reader.vertex_count(), 1UL, positions.data()) == tml::error_code::index_out_of_range);
+
+        tml::mesh_batch batch;
+        tml::area_accumulator accumulator{reader};
+
+        while (reader.read(batch) == tml::error_code::none && !batch.empty())
+        {
+            accumulator.add(batch);
+        }
+
+        REQUIRE(std::abs(accumulator.area() - mesh.area()) <= 1e-3F * mesh.area());
+
+        tml::mesh_reader ascii;
+        REQUIRE(ascii.open("grid_input.ply") == tml::error_code::none);
+        REQUIRE_FALSE(ascii.can_reread_positions());
+    }
+
+    SECTION("Reject batches that do not match the announced counts")
+    {
+        tml::mesh_reader reader;
+        REQUIRE(reader.open("input.ply") == tml::error_code::none);
+
+        tml::mesh_batch vertices;
+        REQUIRE(reader.read(vertices) == tml::error_code::none);
+
+        tml::mesh_writer writer;
+        REQUIRE(writer.open("mismatch_output.ply", 8UL, 13UL, {.can_overwrite = true}) == tml::error_code::none);
+        REQUIRE(writer.write(vertices) == tml::error_code::none);
+        REQUIRE(writer.close() == tml::error_code::invalid_data);
+
+        REQUIRE(writer.open("mismatch_output.ply", 4UL, 0UL, {.can_overwrite = true}) == tml::error_code::none);
+        REQUIRE(writer.write(vertices) == tml::error_code::invalid_data);
+        REQUIRE(writer.close() == tml::error_code::invalid_data);
+
+        REQUIRE(writer.open("mismatch_output.stl", 8UL, 12UL, {.can_overwrite = true}) == tml::error_code::unsupported_format);
+    }
+}
@@ -0,0 +1,97 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <tml/mesh.hpp>
+#include <tml/stats.hpp>
+
+TEST_CASE("Stats tests", "[library]")
+{
+    tml::reset_stats();
+
+    SECTION("Count the elements and bytes of the files read and written")
+    {
+        tml::mesh const mesh{"input.ply"};
+        REQUIRE(mesh.write("stats_output.ply", true) == tml::error_code::none);
+        auto const stats = tml::stats_snapshot();
+
+        if constexpr (tml::stats_enabled)
+        {
+            REQUIRE(stats[tml::stat::files_read] == 1U);
+            REQUIRE(stats[tml::stat::bytes_read] == std::filesystem::file_size("input.ply"));
+            REQUIRE(stats[tml::stat::vertices_read] == mesh.vertices().size());
+            REQUIRE(stats[tml::stat::faces_read] == mesh.faces().size());
+            REQUIRE(stats[tml::stat::files_written] == 1U);
+            REQUIRE(stats[tml::stat::bytes_written] == std::filesystem::file_size("stats_output.ply"));
+            REQUIRE(stats[tml::stat::allocations] >= 2U);
+        }
+        else
+        {
+            REQUIRE(stats.values == decltype(stats.values){});
+        }
+    }
+
+    SECTION("Count the adjacency entries dropped as duplicates")
+    {
+        tml::mesh const mesh{"input.ply"};
+        std::size_t neighbor_count{0UL};
+
+        for (std::size_t vertex{0UL}; vertex < mesh.vertices().size(); ++vertex)
+        {
+            neighbor_count += mesh.neighbors(vertex).size();
+        }
+
+        auto const stats = tml::stats_snapshot();
+        std::uint64_t const expected_entries = tml::stats_enabled ? mesh.faces().size() * 6UL : 0UL;
+        REQUIRE(stats[tml::stat::adjacency_entries] == expected_entries);
+        REQUIRE(stats[tml::stat::adjacency_duplicates] == (tml::stats_enabled ? expected_entries - neighbor_count : 0UL));
+    }
+
+    SECTION("Count the probes of the STL vertex table and time the parts of a PLY body")
+    {
+        REQUIRE(tml::mesh{"input.ply"}.write("stats_probes.stl", {.can_overwrite = true}) == tml::error_code::none);
+        tml::reset_stats();
+
+        tml::mesh const stl{"stats_probes.stl"};
+        auto const stats = tml::stats_snapshot();
+        REQUIRE(stats[tml::stat::hash_probes] >= (tml::stats_enabled ? stl.faces().size() * 3UL : 0UL));
+
+        tml::mesh const ply{"grid_input.ply"};
+        auto const after = tml::stats_snapshot();
+        REQUIRE((after[tml::stat::vertex_body_time] != 0U) == tml::stats_enabled);
+        REQUIRE((after[tml::stat::face_body_time] != 0U) == tml::stats_enabled);
+        REQUIRE(after[tml::stat::hash_probes] == stats[tml::stat::hash_probes]);
+    }
+
+    SECTION("Forward every recorded amount to the sink")
+    {
+        REQUIRE(tml::mesh{"input.ply"}.write("stats_input.stl", {.can_overwrite = true}) == tml::error_code::none);
+        tml::reset_stats();
+
+        std::array<std::uint64_t, tml::stat_count> forwarded{};
+        std::size_t calls{0UL};
+        tml::set_stats_sink([&](tml::stat const stat, std::uint64_t const amount) -> void {
+            forwarded[static_cast<std::size_t>(stat)] += amount;
+            ++calls;
+        });
+
+        tml::mesh mesh{"input.ply"};
+        REQUIRE(mesh.read("stats_input.stl") == tml::error_code::none);
+        tml::set_stats_sink({});
+        REQUIRE(mesh.read("input.ply") == tml::error_code::none);
+
+        auto const stats = tml::stats_snapshot();
+        REQUIRE((calls != 0UL) == tml::stats_enabled);
+        REQUIRE(forwarded[static_cast<std::size_t>(tml::stat::files_read)] == (tml::stats_enabled ? 2U : 0U));
+        REQUIRE(stats[tml::stat::files_read] == (tml::stats_enabled ? 3U : 0U));
+    }
+
+    SECTION("Reset the counters")
+    {
+        tml::mesh const mesh{"input.ply"};
+        tml::reset_stats();
+        REQUIRE(tml::stats_snapshot().values == decltype(tml::stats_snapshot().values){});
+        REQUIRE(tml::stat_name(tml::stat::adjacency_duplicates) == "adjacency_duplicates");
+    }
+}
@@ -38,4 +38,11 @@ TEST_CASE("Vertices tests", "[library]")
         REQUIRE(vertex.y() == 2.0F);
         REQUIRE(vertex.z() == 4.0F);
     }
+
+    SECTION("Hash the permutations of a vertex differently")
+    {
+        std::hash<tml::vertex> const hash;
+        REQUIRE(hash(tml::vertex{1.0F, 2.0F, 3.0F}) != hash(tml::vertex{3.0F, 2.0F, 1.0F}));
+        REQUIRE(hash(tml::vertex{1.0F, 2.0F, 3.0F}) != hash(tml::vertex{2.0F, 1.0F, 3.0F}));
+    }
 }